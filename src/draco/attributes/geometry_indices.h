@@ -23,28 +23,47 @@
 
 namespace draco {
 
+// Value type of all geometry indices defined below. By default, the indices
+// are 32-bit. Builds with DRACO_WIDE_INDICES_SUPPORTED (cmake option
+// ENABLE_WIDE_INDICES) use 64-bit indices that can address meshes with more
+// than 2^32 corners at the cost of higher memory use.
+#ifdef DRACO_WIDE_INDICES_SUPPORTED
+typedef uint64_t GeometryIndexValueType;
+// Signed type used for the number of geometry elements, e.g. the number of
+// corners in a CornerTable.
+typedef int64_t GeometryIndexCountType;
+#else
+typedef uint32_t GeometryIndexValueType;
+typedef int GeometryIndexCountType;
+#endif
+
+// Maximum number of elements (points, vertices, corners, ...) that can be
+// stored in a geometry with the index types of the current build.
+static constexpr GeometryIndexCountType kMaxGeometryIndexCount =
+    std::numeric_limits<GeometryIndexCountType>::max();
+
 // Index of an attribute value entry stored in a GeometryAttribute.
-DEFINE_NEW_DRACO_INDEX_TYPE(uint32_t, AttributeValueIndex)
+DEFINE_NEW_DRACO_INDEX_TYPE(GeometryIndexValueType, AttributeValueIndex)
 // Index of a point in a PointCloud.
-DEFINE_NEW_DRACO_INDEX_TYPE(uint32_t, PointIndex)
+DEFINE_NEW_DRACO_INDEX_TYPE(GeometryIndexValueType, PointIndex)
 // Vertex index in a Mesh or CornerTable.
-DEFINE_NEW_DRACO_INDEX_TYPE(uint32_t, VertexIndex)
+DEFINE_NEW_DRACO_INDEX_TYPE(GeometryIndexValueType, VertexIndex)
 // Corner index that identifies a corner in a Mesh or CornerTable.
-DEFINE_NEW_DRACO_INDEX_TYPE(uint32_t, CornerIndex)
+DEFINE_NEW_DRACO_INDEX_TYPE(GeometryIndexValueType, CornerIndex)
 // Face index for Mesh and CornerTable.
-DEFINE_NEW_DRACO_INDEX_TYPE(uint32_t, FaceIndex)
+DEFINE_NEW_DRACO_INDEX_TYPE(GeometryIndexValueType, FaceIndex)
 
 // Constants denoting invalid indices.
 static constexpr AttributeValueIndex kInvalidAttributeValueIndex(
-    std::numeric_limits<uint32_t>::max());
+    std::numeric_limits<GeometryIndexValueType>::max());
 static constexpr PointIndex kInvalidPointIndex(
-    std::numeric_limits<uint32_t>::max());
+    std::numeric_limits<GeometryIndexValueType>::max());
 static constexpr VertexIndex kInvalidVertexIndex(
-    std::numeric_limits<uint32_t>::max());
+    std::numeric_limits<GeometryIndexValueType>::max());
 static constexpr CornerIndex kInvalidCornerIndex(
-    std::numeric_limits<uint32_t>::max());
+    std::numeric_limits<GeometryIndexValueType>::max());
 static constexpr FaceIndex kInvalidFaceIndex(
-    std::numeric_limits<uint32_t>::max());
+    std::numeric_limits<GeometryIndexValueType>::max());
 
 // TODO(ostava): Add strongly typed indices for attribute id and unique
 // attribute id.
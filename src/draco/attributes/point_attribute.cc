@@ -25,12 +25,13 @@ using conditional_t = typename std::conditional<B, T, F>::type;
 namespace draco {
 
 PointAttribute::PointAttribute()
-    : num_unique_entries_(0), identity_mapping_(false) {}
+    : num_unique_entries_(0), identity_mapping_(false), mapping_version_(0) {}
 
 PointAttribute::PointAttribute(const GeometryAttribute &att)
     : GeometryAttribute(att),
       num_unique_entries_(0),
-      identity_mapping_(false) {}
+      identity_mapping_(false),
+      mapping_version_(0) {}
 
 void PointAttribute::CopyFrom(const PointAttribute &src_att) {
   if (buffer() == nullptr) {
@@ -40,6 +41,7 @@ void PointAttribute::CopyFrom(const PointAttribute &src_att) {
   }
   if (!GeometryAttribute::CopyFrom(src_att))
     return;
+  ++mapping_version_;
   identity_mapping_ = src_att.identity_mapping_;
   num_unique_entries_ = src_att.num_unique_entries_;
   indices_map_ = src_att.indices_map_;
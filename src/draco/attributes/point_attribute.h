@@ -61,6 +61,11 @@ class PointAttribute : public GeometryAttribute {
     return indices_map_.size();
   }
 
+  // Returns a counter that changes whenever the mapping between point ids and
+  // attribute value ids is modified. It can be used to detect when data
+  // derived from the mapping becomes outdated.
+  uint64_t mapping_version() const { return mapping_version_; }
+
   const uint8_t *GetAddressOfMappedIndex(PointIndex point_index) const {
     return GetAddress(mapped_index(point_index));
   }
@@ -75,12 +80,14 @@ class PointAttribute : public GeometryAttribute {
   // This function sets the mapping to implicit, where point indices are equal
   // to attribute entry indices.
   void SetIdentityMapping() {
+    ++mapping_version_;
     identity_mapping_ = true;
     indices_map_.clear();
   }
   // This function sets the mapping to be explicitly using the indices_map_
   // array that needs to be initialized by the caller.
   void SetExplicitMapping(size_t num_points) {
+    ++mapping_version_;
     identity_mapping_ = false;
     indices_map_.resize(num_points, kInvalidAttributeValueIndex);
   }
@@ -89,6 +96,7 @@ class PointAttribute : public GeometryAttribute {
   void SetPointMapEntry(PointIndex point_index,
                         AttributeValueIndex entry_index) {
     DRACO_DCHECK(!identity_mapping_);
+    ++mapping_version_;
     indices_map_[point_index] = entry_index;
   }
 
@@ -148,6 +156,7 @@ class PointAttribute : public GeometryAttribute {
   AttributeValueIndex::ValueType num_unique_entries_;
   // Flag when the mapping between point ids and attribute values is identity.
   bool identity_mapping_;
+  uint64_t mapping_version_;
 
   // If an attribute contains transformed data (e.g. quantized), we can specify
   // the attribute transform here and use it to transform the attribute back to
@@ -63,6 +63,22 @@ class AttributesDecoder : public AttributesDecoderInterface {
     return true;
   }
 
+  bool DecodeAttributesData(DecoderBuffer *in_buffer) override {
+    if (!DecodePortableAttributes(in_buffer))
+      return false;
+    if (!DecodeDataNeededByPortableTransforms(in_buffer))
+      return false;
+    return true;
+  }
+
+  bool FinalizeAttributes() override {
+    if (!FinalizePortableAttributes())
+      return false;
+    if (!TransformAttributesToOriginalFormat())
+      return false;
+    return true;
+  }
+
  protected:
   int32_t GetLocalIdForPointAttribute(int32_t point_attribute_id) const {
     const int id_map_size =
@@ -76,6 +92,9 @@ class AttributesDecoder : public AttributesDecoderInterface {
     return true;
   }
   virtual bool TransformAttributesToOriginalFormat() { return true; }
+  // Finishes any decoding of portable attributes that was postponed when the
+  // attributes were decoded using DecodeAttributesData().
+  virtual bool FinalizePortableAttributes() { return true; }
 
  private:
   // List of attribute ids that need to be decoded with this decoder.
@@ -44,6 +44,24 @@ class AttributesDecoderInterface {
   // the derived classes.
   virtual bool DecodeAttributes(DecoderBuffer *in_buffer) = 0;
 
+  // Same as DecodeAttributes() but the decoding is split into two steps.
+  // DecodeAttributesData() decodes all data stored in the |in_buffer| while
+  // the remaining computation that does not need the buffer can be postponed
+  // to FinalizeAttributes(). FinalizeAttributes() can be executed concurrently
+  // with decoding of other attributes decoders, as long as the decoders of all
+  // attributes returned by GetParentAttributeIds() are already finalized.
+  virtual bool DecodeAttributesData(DecoderBuffer *in_buffer) {
+    return DecodeAttributes(in_buffer);
+  }
+  virtual bool FinalizeAttributes() { return true; }
+
+  // Returns ids of all attributes whose portable data are needed to finalize
+  // decoding of attributes of this decoder. Valid after DecodeAttributesData()
+  // was called.
+  virtual std::vector<int32_t> GetParentAttributeIds() const {
+    return std::vector<int32_t>();
+  }
+
   virtual int32_t GetAttributeId(int i) const = 0;
   virtual int32_t GetNumAttributes() const = 0;
   virtual PointCloudDecoder *GetDecoder() const = 0;
@@ -77,6 +77,14 @@ class AttributesEncoder {
     return false;
   }
 
+  // Returns a copy of the portable attribute with the point mapping of a parent
+  // attribute, for attributes that are not marked as parents yet. Returns
+  // nullptr when GetPortableAttribute() can be used instead.
+  virtual std::unique_ptr<PointAttribute> CreateMappedPortableAttribute(
+      int32_t /* point_attribute_id */) {
+    return nullptr;
+  }
+
   // Returns an attribute containing data processed by the attribute transform.
   // (see TransformToPortableFormat() method). This data is guaranteed to be
   // encoded losslessly and it can be safely used for predictors.
@@ -41,6 +41,8 @@
 #include <inttypes.h>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <vector>
 
 #include "draco/core/macros.h"
 
@@ -117,6 +119,48 @@ class OctahedronToolBox {
     CanonicalizeOctahedralCoords(s, t, out_s, out_t);
   }
 
+  // Converts |num_vectors| integer vectors stored consecutively in |int_vecs|
+  // to octahedral coordinates stored in |out_coords| as (s, t) pairs. Produces
+  // the same values as IntegerVectorToQuantizedOctahedralCoords(), but the
+  // hemisphere selection and the canonicalization are computed without
+  // branches, which allows the compiler to process several vectors at once.
+  // Precondition: abs sum of all vectors must equal center value.
+  void IntegerVectorsToQuantizedOctahedralCoords(const int32_t *int_vecs,
+                                                 int num_vectors,
+                                                 int32_t *out_coords) const {
+    const int32_t center_value = center_value_;
+    const int32_t max_value = max_value_;
+    for (int i = 0; i < num_vectors; ++i) {
+      const int32_t *const int_vec = int_vecs + 3 * i;
+      DRACO_DCHECK_EQ(
+          std::abs(int_vec[0]) + std::abs(int_vec[1]) + std::abs(int_vec[2]),
+          center_value);
+      const int32_t x = int_vec[0];
+      const int32_t y = int_vec[1];
+      const int32_t z = int_vec[2];
+      const int32_t abs_y = y < 0 ? -y : y;
+      const int32_t abs_z = z < 0 ? -z : z;
+      // Right hemisphere values first, replaced by the left hemisphere ones.
+      const int32_t left_s = y < 0 ? abs_z : max_value - abs_z;
+      const int32_t left_t = z < 0 ? abs_y : max_value - abs_y;
+      const int32_t s = x >= 0 ? y + center_value : left_s;
+      const int32_t t = x >= 0 ? z + center_value : left_t;
+
+      // Same as CanonicalizeOctahedralCoords(). Apart from the corner points,
+      // at most one of the edge conditions can hold for any (s, t).
+      const bool is_corner = (s == 0 && t == 0) || (s == 0 && t == max_value) ||
+                             (s == max_value && t == 0);
+      const bool mirror_t =
+          (s == 0 && t > center_value) || (s == max_value && t < center_value);
+      const bool mirror_s =
+          (t == max_value && s < center_value) || (t == 0 && s > center_value);
+      const int32_t canonical_s = mirror_s ? 2 * center_value - s : s;
+      const int32_t canonical_t = mirror_t ? 2 * center_value - t : t;
+      out_coords[2 * i] = is_corner ? max_value : canonical_s;
+      out_coords[2 * i + 1] = is_corner ? max_value : canonical_t;
+    }
+  }
+
   template <class T>
   void FloatVectorToQuantizedOctahedralCoords(const T *vector, int32_t *out_s,
                                               int32_t *out_t) const {
@@ -189,6 +233,15 @@ class OctahedronToolBox {
     }
   }
 
+  // Normalizes |num_vectors| vectors stored consecutively in |vecs|. Same as
+  // calling CanonicalizeIntegerVector() on each of them.
+  template <class T>
+  void CanonicalizeIntegerVectors(T *vecs, int num_vectors) const {
+    for (int i = 0; i < num_vectors; ++i) {
+      CanonicalizeIntegerVector(vecs + 3 * i);
+    }
+  }
+
   template <typename T>
   void OctaherdalCoordsToUnitVector(T in_s, T in_t, T *out_vector) const {
     DRACO_DCHECK_GE(in_s, 0);
@@ -247,6 +300,55 @@ class OctahedronToolBox {
     OctaherdalCoordsToUnitVector(in_s * scale, in_t * scale, out_vector);
   }
 
+  // Converts |num_values| quantized octahedral coordinates stored as (s, t)
+  // pairs in |in_coords| to unit vectors. Each vector is written as three
+  // floats to |out_data| and consecutive vectors are |out_byte_stride| bytes
+  // apart. Produces the same values as QuantizedOctaherdalCoordsToUnitVector()
+  // for floats. For low quantizations, the vectors of all possible coordinates
+  // are precomputed when there are several times more values than possible
+  // coordinates.
+  void QuantizedOctahedralCoordsToUnitVectors(const int32_t *in_coords,
+                                              int num_values,
+                                              uint8_t *out_data,
+                                              int64_t out_byte_stride) const {
+    const float scale = 1.0 / static_cast<float>(max_value_);
+    const int32_t num_coords = max_quantized_value_ + 1;
+    const int64_t num_table_entries =
+        static_cast<int64_t>(num_coords) * num_coords;
+    float vec[3];
+    if (quantization_bits_ > kMaxLookupTableQuantizationBits ||
+        kMinValuesPerLookupTableEntry * num_table_entries > num_values) {
+      for (int i = 0; i < num_values; ++i) {
+        OctaherdalCoordsToUnitVector(in_coords[2 * i] * scale,
+                                     in_coords[2 * i + 1] * scale, vec);
+        memcpy(out_data, vec, sizeof(vec));
+        out_data += out_byte_stride;
+      }
+      return;
+    }
+    std::vector<float> table(3 * num_table_entries);
+    for (int32_t s = 0; s < num_coords; ++s) {
+      for (int32_t t = 0; t < num_coords; ++t) {
+        OctaherdalCoordsToUnitVector(s * scale, t * scale,
+                                     &table[3 * (s * num_coords + t)]);
+      }
+    }
+    for (int i = 0; i < num_values; ++i) {
+      const int32_t s = in_coords[2 * i];
+      const int32_t t = in_coords[2 * i + 1];
+      if (static_cast<uint32_t>(s) < static_cast<uint32_t>(num_coords) &&
+          static_cast<uint32_t>(t) < static_cast<uint32_t>(num_coords)) {
+        memcpy(out_data, &table[3 * (s * num_coords + t)], sizeof(vec));
+      } else {
+        // Invalid coordinates are converted the same way as by the scalar
+        // conversion.
+        OctaherdalCoordsToUnitVector(s * scale, t * scale, vec);
+        memcpy(out_data, vec, sizeof(vec));
+      }
+      out_data += out_byte_stride;
+    }
+  }
+
   // |s| and |t| are expected to be signed values.
   inline bool IsInDiamond(const int32_t &s, const int32_t &t) const {
     // Expect center already at origin.
@@ -325,6 +427,13 @@ class OctahedronToolBox {
   int32_t center_value() const { return center_value_; }
 
  private:
+  // Max quantization for which QuantizedOctahedralCoordsToUnitVectors() can
+  // use a lookup table. The table has 2^(2 * bits) entries.
+  static constexpr int kMaxLookupTableQuantizationBits = 10;
+  // Building the table costs as much as converting all its entries, so it is
+  // used only when it is accessed several times per entry on average.
+  static constexpr int kMinValuesPerLookupTableEntry = 4;
+
   int32_t quantization_bits_;
   int32_t max_quantized_value_;
   int32_t max_value_;
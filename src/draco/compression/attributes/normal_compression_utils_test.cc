@@ -0,0 +1,150 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/normal_compression_utils.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+
+namespace draco {
+
+class NormalCompressionUtilsTest : public ::testing::Test {
+ protected:
+  // Verifies that the batch conversions of |vecs| produce the same values as
+  // the conversions of the individual vectors.
+  void TestBatchConversion(const OctahedronToolBox &tool_box,
+                           const std::vector<int32_t> &vecs) {
+    const int num_vectors = static_cast<int>(vecs.size() / 3);
+    std::vector<int32_t> batch_vecs = vecs;
+    tool_box.CanonicalizeIntegerVectors(batch_vecs.data(), num_vectors);
+    std::vector<int32_t> batch_coords(2 * num_vectors);
+    tool_box.IntegerVectorsToQuantizedOctahedralCoords(
+        batch_vecs.data(), num_vectors, batch_coords.data());
+    for (int i = 0; i < num_vectors; ++i) {
+      int32_t vec[3] = {vecs[3 * i], vecs[3 * i + 1], vecs[3 * i + 2]};
+      tool_box.CanonicalizeIntegerVector(vec);
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_EQ(batch_vecs[3 * i + c], vec[c]);
+      }
+      int32_t s, t;
+      tool_box.IntegerVectorToQuantizedOctahedralCoords(vec, &s, &t);
+      ASSERT_EQ(batch_coords[2 * i], s);
+      ASSERT_EQ(batch_coords[2 * i + 1], t);
+    }
+  }
+
+  // Verifies that the batch conversion of |coords| to unit vectors produces
+  // the same values as the conversions of the individual coordinates. The
+  // vectors are written with |stride| floats between them.
+  void TestBatchUnitVectors(const OctahedronToolBox &tool_box,
+                            const std::vector<int32_t> &coords, int stride) {
+    const int num_values = static_cast<int>(coords.size() / 2);
+    std::vector<float> vecs(stride * num_values);
+    tool_box.QuantizedOctahedralCoordsToUnitVectors(
+        coords.data(), num_values, reinterpret_cast<uint8_t *>(vecs.data()),
+        sizeof(float) * stride);
+    for (int i = 0; i < num_values; ++i) {
+      float vec[3];
+      tool_box.QuantizedOctaherdalCoordsToUnitVector(coords[2 * i],
+                                                     coords[2 * i + 1], vec);
+      ASSERT_EQ(std::memcmp(&vecs[stride * i], vec, sizeof(vec)), 0)
+          << coords[2 * i] << " " << coords[2 * i + 1];
+    }
+  }
+};
+
+TEST_F(NormalCompressionUtilsTest, TestBatchConversionAllVectors) {
+  // All vectors on the octahedron, including all its edges and corners, are
+  // converted for small quantizations.
+  for (int q = 2; q <= 6; ++q) {
+    OctahedronToolBox tool_box;
+    ASSERT_TRUE(tool_box.SetQuantizationBits(q));
+    const int32_t center = tool_box.center_value();
+    std::vector<int32_t> vecs;
+    for (int32_t x = -center; x <= center; ++x) {
+      for (int32_t y = -center; y <= center; ++y) {
+        const int32_t z = center - std::abs(x) - std::abs(y);
+        if (z < 0)
+          continue;
+        vecs.insert(vecs.end(), {x, y, z});
+        if (z > 0)
+          vecs.insert(vecs.end(), {x, y, -z});
+      }
+    }
+    TestBatchConversion(tool_box, vecs);
+  }
+}
+
+TEST_F(NormalCompressionUtilsTest, TestBatchConversionRandomVectors) {
+  // Random vectors of the predicted normals. Small components often result
+  // in points on the edges of the octahedron.
+  std::mt19937 generator(0);
+  for (const int32_t max_component : {1, 4, 1000, 1 << 29}) {
+    std::uniform_int_distribution<int32_t> distribution(-max_component,
+                                                        max_component);
+    for (const int q : {2, 8, 10, 16, 30}) {
+      OctahedronToolBox tool_box;
+      ASSERT_TRUE(tool_box.SetQuantizationBits(q));
+      std::vector<int32_t> vecs(3 * 10000);
+      for (int32_t &value : vecs) {
+        value = distribution(generator);
+      }
+      TestBatchConversion(tool_box, vecs);
+    }
+  }
+}
+
+TEST_F(NormalCompressionUtilsTest, TestBatchUnitVectorsAllCoords) {
+  // All coordinates are converted with and without the lookup table. The
+  // table is used only when there are several values per coordinate.
+  for (int q = 2; q <= 10; ++q) {
+    OctahedronToolBox tool_box;
+    ASSERT_TRUE(tool_box.SetQuantizationBits(q));
+    std::vector<int32_t> coords;
+    for (int32_t s = 0; s <= tool_box.max_quantized_value(); ++s) {
+      for (int32_t t = 0; t <= tool_box.max_quantized_value(); ++t) {
+        coords.insert(coords.end(), {s, t});
+      }
+    }
+    TestBatchUnitVectors(tool_box, coords, 3);
+    if (q > 8)
+      continue;  // Keeps the test fast.
+    const int num_coords = static_cast<int>(coords.size());
+    for (int i = 0; i < 15; ++i) {
+      coords.insert(coords.end(), coords.begin(), coords.begin() + num_coords);
+    }
+    TestBatchUnitVectors(tool_box, coords, 3);
+    TestBatchUnitVectors(tool_box, coords, 4);
+  }
+}
+
+TEST_F(NormalCompressionUtilsTest, TestBatchUnitVectorsRandomCoords) {
+  std::mt19937 generator(0);
+  for (const int q : {8, 12, 16, 30}) {
+    OctahedronToolBox tool_box;
+    ASSERT_TRUE(tool_box.SetQuantizationBits(q));
+    std::uniform_int_distribution<int32_t> distribution(
+        0, tool_box.max_quantized_value());
+    std::vector<int32_t> coords(2 * 10000);
+    for (int32_t &value : coords) {
+      value = distribution(generator);
+    }
+    TestBatchUnitVectors(tool_box, coords, 3);
+  }
+}
+
+}  // namespace draco
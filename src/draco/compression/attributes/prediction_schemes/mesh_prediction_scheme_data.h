@@ -15,6 +15,7 @@
 #ifndef DRACO_COMPRESSION_ATTRIBUTES_MESH_PREDICTION_SCHEMES_PREDICTION_SCHEME_DATA_H_
 #define DRACO_COMPRESSION_ATTRIBUTES_MESH_PREDICTION_SCHEMES_PREDICTION_SCHEME_DATA_H_
 
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_topology.h"
 #include "draco/mesh/corner_table.h"
 #include "draco/mesh/mesh.h"
 
@@ -30,7 +31,8 @@ class MeshPredictionSchemeData {
       : mesh_(nullptr),
         corner_table_(nullptr),
         vertex_to_data_map_(nullptr),
-        data_to_corner_map_(nullptr) {}
+        data_to_corner_map_(nullptr),
+        topology_(nullptr) {}
 
   void Set(const Mesh *mesh, const CornerTable *table,
            const std::vector<CornerIndex> *data_to_corner_map,
@@ -49,6 +51,12 @@ class MeshPredictionSchemeData {
   const std::vector<CornerIndex> *data_to_corner_map() const {
     return data_to_corner_map_;
   }
+  // Optional precomputed topology of the data entries. When set, prediction
+  // schemes can use it instead of traversing the corner table.
+  const MeshPredictionSchemeTopology *topology() const { return topology_; }
+  void set_topology(const MeshPredictionSchemeTopology *topology) {
+    topology_ = topology;
+  }
   bool IsInitialized() const {
     return mesh_ != nullptr && corner_table_ != nullptr &&
            vertex_to_data_map_ != nullptr && data_to_corner_map_ != nullptr;
@@ -65,6 +73,10 @@ class MeshPredictionSchemeData {
   // Array that stores which corner was processed when a given attribute entry
   // was encoded or decoded.
   const std::vector<CornerIndex> *data_to_corner_map_;
+
+  // Topology shared with other attributes (not owned). It is valid only while
+  // the attribute values are decoded.
+  const MeshPredictionSchemeTopology *topology_;
 };
 
 }  // namespace draco
@@ -15,6 +15,9 @@
 #ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_GEOMETRIC_NORMAL_DECODER_H_
 #define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_GEOMETRIC_NORMAL_DECODER_H_
 
+#include <algorithm>
+#include <vector>
+
 #include "draco/draco_features.h"
 
 #include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_decoder.h"
@@ -103,31 +106,46 @@ bool MeshPredictionSchemeGeometricNormalDecoder<
   // Expecting in_data in octahedral coordinates, i.e., portable attribute.
   DRACO_DCHECK_EQ(num_components, 2);
 
-  const int corner_map_size =
-      static_cast<int>(this->mesh_data().data_to_corner_map()->size());
-
-  VectorD<int32_t, 3> pred_normal_3d;
-  int32_t pred_normal_oct[2];
-
-  for (int data_id = 0; data_id < corner_map_size; ++data_id) {
-    const CornerIndex corner_id =
-        this->mesh_data().data_to_corner_map()->at(data_id);
-    predictor_.ComputePredictedValue(corner_id, pred_normal_3d.data());
+  const std::vector<CornerIndex> &data_to_corner_map =
+      *this->mesh_data().data_to_corner_map();
+  const int corner_map_size = static_cast<int>(data_to_corner_map.size());
+  predictor_.CacheDataPositions(corner_map_size);
+
+  // The values are decoded in batches. The predicted normals of all entries
+  // of a batch are computed and converted to octahedral coordinates before
+  // the corrections are applied, because the predictions depend only on the
+  // positions and not on the previously decoded normals.
+  static constexpr int kBatchSize = 256;
+  DataTypeT pred_normals_3d[kBatchSize * 3];
+  int32_t pred_normals_oct[kBatchSize * 2];
+  for (int batch_start = 0; batch_start < corner_map_size;
+       batch_start += kBatchSize) {
+    const int batch_size = std::min(kBatchSize, corner_map_size - batch_start);
+    predictor_.ComputePredictedValues(data_to_corner_map.data() + batch_start,
+                                      batch_size, pred_normals_3d);
 
     // Compute predicted octahedral coordinates.
-    octahedron_tool_box_.CanonicalizeIntegerVector(pred_normal_3d.data());
-    DRACO_DCHECK_EQ(pred_normal_3d.AbsSum(),
-                    octahedron_tool_box_.center_value());
-    if (flip_normal_bit_decoder_.DecodeNextBit()) {
-      pred_normal_3d = -pred_normal_3d;
+    octahedron_tool_box_.CanonicalizeIntegerVectors(pred_normals_3d,
+                                                    batch_size);
+    for (int i = 0; i < batch_size; ++i) {
+      if (flip_normal_bit_decoder_.DecodeNextBit()) {
+        DataTypeT *const pred_normal_3d = pred_normals_3d + 3 * i;
+        pred_normal_3d[0] = -pred_normal_3d[0];
+        pred_normal_3d[1] = -pred_normal_3d[1];
+        pred_normal_3d[2] = -pred_normal_3d[2];
+      }
+    }
+    octahedron_tool_box_.IntegerVectorsToQuantizedOctahedralCoords(
+        pred_normals_3d, batch_size, pred_normals_oct);
+
+    for (int i = 0; i < batch_size; ++i) {
+      const int data_offset = (batch_start + i) * 2;
+      this->transform().ComputeOriginalValue(
+          pred_normals_oct + 2 * i, in_corr + data_offset,
+          out_data + data_offset);
     }
-    octahedron_tool_box_.IntegerVectorToQuantizedOctahedralCoords(
-        pred_normal_3d.data(), pred_normal_oct, pred_normal_oct + 1);
-
-    const int data_offset = data_id * 2;
-    this->transform().ComputeOriginalValue(
-        pred_normal_oct, in_corr + data_offset, out_data + data_offset);
   }
+  predictor_.ClearDataPositions();
   flip_normal_bit_decoder_.EndDecoding();
   return true;
 }
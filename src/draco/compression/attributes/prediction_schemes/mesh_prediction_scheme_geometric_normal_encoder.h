@@ -104,6 +104,7 @@ bool MeshPredictionSchemeGeometricNormalEncoder<DataTypeT, TransformT,
 
   const int corner_map_size =
       static_cast<int>(this->mesh_data().data_to_corner_map()->size());
+  predictor_.CacheDataPositions(corner_map_size);
 
   VectorD<int32_t, 3> pred_normal_3d;
   VectorD<int32_t, 2> pos_pred_normal_oct;
@@ -155,6 +156,7 @@ bool MeshPredictionSchemeGeometricNormalEncoder<DataTypeT, TransformT,
           octahedron_tool_box_.MakePositive(neg_correction[1]);
     }
   }
+  predictor_.ClearDataPositions();
   return true;
 }
 
@@ -93,6 +93,18 @@ class MeshPredictionSchemeGeometricNormalPredictorArea
     prediction[1] = static_cast<int32_t>(normal[1]);
     prediction[2] = static_cast<int32_t>(normal[2]);
   }
+
+  // Computes predicted normals of |num_corners| corners stored in
+  // |corner_ids|. The three components of each normal are stored
+  // consecutively in |predictions|.
+  void ComputePredictedValues(const CornerIndex *corner_ids, int num_corners,
+                              DataTypeT *predictions) {
+    for (int i = 0; i < num_corners; ++i) {
+      MeshPredictionSchemeGeometricNormalPredictorArea::ComputePredictedValue(
+          corner_ids[i], predictions + 3 * i);
+    }
+  }
+
   bool SetNormalPredictionMode(NormalPredictionMode mode) override {
     if (mode == ONE_TRIANGLE) {
       this->normal_prediction_mode_ = mode;
@@ -17,6 +17,8 @@
 
 #include <math.h>
 
+#include <vector>
+
 #include "draco/attributes/point_attribute.h"
 #include "draco/compression/attributes/normal_compression_utils.h"
 #include "draco/compression/config/compression_shared.h"
@@ -52,6 +54,22 @@ class MeshPredictionSchemeGeometricNormalPredictorBase {
     return true;
   }
 
+  // Converts the positions of all |num_entries| data entries in advance. Each
+  // position is used by all corners of the surrounding triangles, so this
+  // avoids converting the same position several times when predicting all
+  // entries. The entry to point id map must be set before calling this.
+  void CacheDataPositions(int num_entries) {
+    DRACO_DCHECK(this->IsInitialized());
+    data_positions_.resize(num_entries);
+    for (int i = 0; i < num_entries; ++i) {
+      data_positions_[i] = GetPositionForDataId(i);
+    }
+  }
+  // Releases the positions converted by CacheDataPositions().
+  void ClearDataPositions() {
+    std::vector<VectorD<int64_t, 3>>().swap(data_positions_);
+  }
+
   virtual bool SetNormalPredictionMode(NormalPredictionMode mode) = 0;
   virtual NormalPredictionMode GetNormalPredictionMode() const {
     return normal_prediction_mode_;
@@ -71,6 +89,8 @@ class MeshPredictionSchemeGeometricNormalPredictorBase {
     const auto corner_table = mesh_data_.corner_table();
     const auto vert_id = corner_table->Vertex(ci).value();
     const auto data_id = mesh_data_.vertex_to_data_map()->at(vert_id);
+    if (!data_positions_.empty())
+      return data_positions_[data_id];
     return GetPositionForDataId(data_id);
   }
   VectorD<int32_t, 2> GetOctahedralCoordForDataId(int data_id,
@@ -87,6 +107,8 @@ class MeshPredictionSchemeGeometricNormalPredictorBase {
   const PointIndex *entry_to_point_id_map_;
   MeshDataT mesh_data_;
   NormalPredictionMode normal_prediction_mode_;
+  // Positions of all data entries (optional).
+  std::vector<VectorD<int64_t, 3>> data_positions_;
 };
 
 }  // namespace draco
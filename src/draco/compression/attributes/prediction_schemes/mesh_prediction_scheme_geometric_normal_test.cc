@@ -0,0 +1,111 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cstring>
+#include <utility>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace draco {
+
+class MeshPredictionSchemeGeometricNormalTest : public ::testing::Test {
+ protected:
+  // Reads |file_name| and adds normals to meshes that don't have any. The
+  // added normals are the directions of the positions from the origin.
+  std::unique_ptr<Mesh> ReadMeshWithNormals(const std::string &file_name) {
+    std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile(file_name));
+    if (mesh == nullptr)
+      return nullptr;
+    if (mesh->GetNamedAttribute(GeometryAttribute::NORMAL) == nullptr) {
+      std::unique_ptr<PointAttribute> normal_att(new PointAttribute());
+      normal_att->CopyFrom(
+          *mesh->GetNamedAttribute(GeometryAttribute::POSITION));
+      normal_att->set_attribute_type(GeometryAttribute::NORMAL);
+      mesh->AddAttribute(std::move(normal_att));
+    }
+    return mesh;
+  }
+
+  // Encodes |mesh| with the given normal |prediction_scheme| and decodes it.
+  std::unique_ptr<Mesh> EncodeAndDecodeMesh(const Mesh &mesh,
+                                            int encoding_method,
+                                            int prediction_scheme) {
+    Encoder encoder;
+    encoder.SetEncodingMethod(encoding_method);
+    encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 14);
+    encoder.SetAttributeQuantization(GeometryAttribute::TEX_COORD, 12);
+    encoder.SetAttributeQuantization(GeometryAttribute::NORMAL, 10);
+    if (!encoder
+             .SetAttributePredictionScheme(GeometryAttribute::NORMAL,
+                                           prediction_scheme)
+             .ok())
+      return nullptr;
+    EncoderBuffer buffer;
+    if (!encoder.EncodeMeshToBuffer(mesh, &buffer).ok())
+      return nullptr;
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    Decoder decoder;
+    auto status_or = decoder.DecodeMeshFromBuffer(&dec_buffer);
+    if (!status_or.ok())
+      return nullptr;
+    return std::move(status_or).value();
+  }
+
+  // Verifies that normals predicted from the geometry are decoded to the same
+  // values as normals encoded with the lossless difference prediction.
+  void TestPrediction(const std::string &file_name, int encoding_method) {
+    const std::unique_ptr<Mesh> mesh = ReadMeshWithNormals(file_name);
+    ASSERT_NE(mesh, nullptr);
+    const std::unique_ptr<Mesh> ref_mesh =
+        EncodeAndDecodeMesh(*mesh, encoding_method, PREDICTION_DIFFERENCE);
+    ASSERT_NE(ref_mesh, nullptr);
+    const std::unique_ptr<Mesh> decoded_mesh = EncodeAndDecodeMesh(
+        *mesh, encoding_method, MESH_PREDICTION_GEOMETRIC_NORMAL);
+    ASSERT_NE(decoded_mesh, nullptr);
+    ASSERT_EQ(decoded_mesh->num_faces(), ref_mesh->num_faces());
+    const PointAttribute *const ref_att =
+        ref_mesh->GetNamedAttribute(GeometryAttribute::NORMAL);
+    const PointAttribute *const att =
+        decoded_mesh->GetNamedAttribute(GeometryAttribute::NORMAL);
+    ASSERT_NE(att, nullptr);
+    for (FaceIndex fi(0); fi < ref_mesh->num_faces(); ++fi) {
+      for (int c = 0; c < 3; ++c) {
+        const PointIndex ref_pi = ref_mesh->face(fi)[c];
+        const PointIndex pi = decoded_mesh->face(fi)[c];
+        ASSERT_EQ(
+            std::memcmp(ref_att->GetAddress(ref_att->mapped_index(ref_pi)),
+                        att->GetAddress(att->mapped_index(pi)),
+                        ref_att->byte_stride()),
+            0)
+            << file_name;
+      }
+    }
+  }
+};
+
+TEST_F(MeshPredictionSchemeGeometricNormalTest, TestGeometricNormal) {
+  for (const int encoding_method :
+       {MESH_EDGEBREAKER_ENCODING, MESH_SEQUENTIAL_ENCODING}) {
+    TestPrediction("test_nm.obj", encoding_method);
+    TestPrediction("sphere.obj", encoding_method);
+    TestPrediction("cube_att.obj", encoding_method);
+    TestPrediction("bun_zipper.ply", encoding_method);
+  }
+}
+
+}  // namespace draco
@@ -70,15 +70,32 @@ bool MeshPredictionSchemeParallelogramDecoder<DataTypeT, TransformT,
   // Restore the first value.
   this->transform().ComputeOriginalValue(pred_vals.get(), in_corr, out_data);
 
+  // The parallelogram entries may be taken from the topology shared with
+  // other attributes. Otherwise they are computed from the corner table.
+  const MeshPredictionSchemeTopology *const topology =
+      this->mesh_data().topology();
   const int corner_map_size =
       static_cast<int>(this->mesh_data().data_to_corner_map()->size());
   for (int p = 1; p < corner_map_size; ++p) {
-    const CornerIndex corner_id = this->mesh_data().data_to_corner_map()->at(p);
     const int dst_offset = p * num_components;
-    if (!ComputeParallelogramPrediction(p, corner_id, table,
-                                        *vertex_to_data_map, out_data,
-                                        num_components, pred_vals.get())) {
-      // Parallelogram could not be computed, Possible because some of the
+    bool has_prediction;
+    if (topology != nullptr) {
+      const MeshPredictionSchemeTopology::Entry &entry = topology->entry(p);
+      has_prediction = entry.has_parallelogram;
+      if (has_prediction) {
+        ComputeParallelogramPredictionFromEntries(entry.parallelogram_entries,
+                                                  out_data, num_components,
+                                                  pred_vals.get());
+      }
+    } else {
+      const CornerIndex corner_id =
+          this->mesh_data().data_to_corner_map()->at(p);
+      has_prediction = ComputeParallelogramPrediction(
+          p, corner_id, table, *vertex_to_data_map, out_data, num_components,
+          pred_vals.get());
+    }
+    if (!has_prediction) {
+      // Parallelogram could not be computed, possibly because some of the
       // vertices are not valid (not encoded yet).
       // We use the last encoded point as a reference (delta coding).
       const int src_offset = (p - 1) * num_components;
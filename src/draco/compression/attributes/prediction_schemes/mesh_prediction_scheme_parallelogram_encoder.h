@@ -86,7 +86,7 @@ bool MeshPredictionSchemeParallelogramEncoder<DataTypeT, TransformT,
     if (!ComputeParallelogramPrediction(p, corner_id, table,
                                         *vertex_to_data_map, in_data,
                                         num_components, pred_vals.get())) {
-      // Parallelogram could not be computed, Possible because some of the
+      // Parallelogram could not be computed, possibly because some of the
       // vertices are not valid (not encoded yet).
       // We use the last encoded point as a reference (delta coding).
       const int src_offset = (p - 1) * num_components;
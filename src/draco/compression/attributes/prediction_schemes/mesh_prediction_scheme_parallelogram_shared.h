@@ -37,6 +37,40 @@ inline void GetParallelogramEntries(
   *prev_entry = vertex_to_data_map[table->Vertex(table->Previous(ci)).value()];
 }
 
+// Computes the data entries of the parallelogram that can be used to predict
+// the entry |data_entry_id| at corner |ci|. The entries of the opposite, next
+// and previous vertices are stored in |out_entries|. Function returns false
+// when the parallelogram doesn't exist or when not all of its entries precede
+// |data_entry_id|.
+template <class CornerTableT>
+inline bool GetParallelogramPredictionEntries(
+    int data_entry_id, const CornerIndex ci, const CornerTableT *table,
+    const std::vector<int32_t> &vertex_to_data_map, int *out_entries) {
+  const CornerIndex oci = table->Opposite(ci);
+  if (oci == kInvalidCornerIndex)
+    return false;
+  GetParallelogramEntries<CornerTableT>(oci, table, vertex_to_data_map,
+                                        &out_entries[0], &out_entries[1],
+                                        &out_entries[2]);
+  return out_entries[0] < data_entry_id && out_entries[1] < data_entry_id &&
+         out_entries[2] < data_entry_id;
+}
+
+// Computes parallelogram prediction from the |entries| returned by
+// GetParallelogramPredictionEntries(). The prediction is stored in
+// |out_prediction|.
+template <typename DataTypeT>
+inline void ComputeParallelogramPredictionFromEntries(
+    const int *entries, const DataTypeT *in_data, int num_components,
+    DataTypeT *out_prediction) {
+  const DataTypeT *const opp_data = in_data + entries[0] * num_components;
+  const DataTypeT *const next_data = in_data + entries[1] * num_components;
+  const DataTypeT *const prev_data = in_data + entries[2] * num_components;
+  for (int c = 0; c < num_components; ++c) {
+    out_prediction[c] = (next_data[c] + prev_data[c]) - opp_data[c];
+  }
+}
+
 // Computes parallelogram prediction for a given corner and data entry id.
 // The prediction is stored in |out_prediction|.
 // Function returns false when the prediction couldn't be computed, e.g. because
@@ -46,25 +80,13 @@ inline bool ComputeParallelogramPrediction(
     int data_entry_id, const CornerIndex ci, const CornerTableT *table,
     const std::vector<int32_t> &vertex_to_data_map, const DataTypeT *in_data,
     int num_components, DataTypeT *out_prediction) {
-  const CornerIndex oci = table->Opposite(ci);
-  if (oci == kInvalidCornerIndex)
-    return false;
-  int vert_opp, vert_next, vert_prev;
-  GetParallelogramEntries<CornerTableT>(oci, table, vertex_to_data_map,
-                                        &vert_opp, &vert_next, &vert_prev);
-  if (vert_opp < data_entry_id && vert_next < data_entry_id &&
-      vert_prev < data_entry_id) {
-    // Apply the parallelogram prediction.
-    const int v_opp_off = vert_opp * num_components;
-    const int v_next_off = vert_next * num_components;
-    const int v_prev_off = vert_prev * num_components;
-    for (int c = 0; c < num_components; ++c) {
-      out_prediction[c] = (in_data[v_next_off + c] + in_data[v_prev_off + c]) -
-                          in_data[v_opp_off + c];
-    }
-    return true;
-  }
-  return false;  // Not all data is available for prediction
+  int entries[3];
+  if (!GetParallelogramPredictionEntries(data_entry_id, ci, table,
+                                         vertex_to_data_map, entries))
+    return false;  // Not all data is available for prediction
+  ComputeParallelogramPredictionFromEntries(entries, in_data, num_components,
+                                            out_prediction);
+  return true;
 }
 
 }  // namespace draco
@@ -0,0 +1,119 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/vector_d.h"
+
+namespace draco {
+
+class MeshPredictionSchemeParallelogramTest : public ::testing::Test {
+ protected:
+  // Encodes |mesh| using the edgebreaker method with the given position
+  // |prediction_scheme|.
+  void EncodeMesh(const Mesh &mesh, int prediction_scheme,
+                  EncoderBuffer *buffer) {
+    Encoder encoder;
+    encoder.SetEncodingMethod(MESH_EDGEBREAKER_ENCODING);
+    encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 14);
+    ASSERT_TRUE(encoder
+                    .SetAttributePredictionScheme(GeometryAttribute::POSITION,
+                                                  prediction_scheme)
+                    .ok());
+    ASSERT_TRUE(encoder.EncodeMeshToBuffer(mesh, buffer).ok());
+  }
+
+  // Verifies that the positions of |file_name| are decoded within the
+  // quantization error for the given |prediction_scheme|.
+  void TestPrediction(const std::string &file_name, int prediction_scheme) {
+    const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile(file_name));
+    ASSERT_NE(mesh, nullptr);
+    EncoderBuffer buffer;
+    EncodeMesh(*mesh, prediction_scheme, &buffer);
+
+    DecoderBuffer dec_buffer;
+    dec_buffer.Init(buffer.data(), buffer.size());
+    Decoder decoder;
+    auto status_or = decoder.DecodeMeshFromBuffer(&dec_buffer);
+    ASSERT_TRUE(status_or.ok());
+    const std::unique_ptr<Mesh> decoded_mesh = std::move(status_or).value();
+    ASSERT_EQ(decoded_mesh->num_faces(), mesh->num_faces());
+
+    // The edgebreaker method reorders the faces, so the decoded positions are
+    // compared by the positions of all face corners sorted along each axis.
+    const PointAttribute *const att =
+        mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+    const PointAttribute *const decoded_att =
+        decoded_mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+    ASSERT_NE(decoded_att, nullptr);
+    float max_range = 0.f;
+    Vector3f min_pos, max_pos;
+    for (AttributeValueIndex i(0); i < att->size(); ++i) {
+      Vector3f pos;
+      att->GetValue(i, &pos[0]);
+      for (int c = 0; c < 3; ++c) {
+        if (i == 0 || pos[c] < min_pos[c])
+          min_pos[c] = pos[c];
+        if (i == 0 || pos[c] > max_pos[c])
+          max_pos[c] = pos[c];
+        max_range = std::max(max_range, max_pos[c] - min_pos[c]);
+      }
+    }
+    const float max_error = max_range / ((1 << 14) - 1);
+    std::vector<float> values[3], decoded_values[3];
+    for (FaceIndex fi(0); fi < mesh->num_faces(); ++fi) {
+      for (int i = 0; i < 3; ++i) {
+        Vector3f pos, decoded_pos;
+        att->GetMappedValue(mesh->face(fi)[i], &pos[0]);
+        decoded_att->GetMappedValue(decoded_mesh->face(fi)[i],
+                                    &decoded_pos[0]);
+        for (int c = 0; c < 3; ++c) {
+          values[c].push_back(pos[c]);
+          decoded_values[c].push_back(decoded_pos[c]);
+        }
+      }
+    }
+    for (int c = 0; c < 3; ++c) {
+      std::sort(values[c].begin(), values[c].end());
+      std::sort(decoded_values[c].begin(), decoded_values[c].end());
+      for (size_t i = 0; i < values[c].size(); ++i) {
+        ASSERT_LE(std::abs(values[c][i] - decoded_values[c][i]), max_error);
+      }
+    }
+  }
+};
+
+TEST_F(MeshPredictionSchemeParallelogramTest, TestParallelogram) {
+  TestPrediction("bun_zipper.ply", MESH_PREDICTION_PARALLELOGRAM);
+  TestPrediction("test_nm.obj", MESH_PREDICTION_PARALLELOGRAM);
+  TestPrediction("cube_att.obj", MESH_PREDICTION_PARALLELOGRAM);
+}
+
+TEST_F(MeshPredictionSchemeParallelogramTest,
+       TestConstrainedMultiParallelogram) {
+  TestPrediction("bun_zipper.ply",
+                 MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM);
+  TestPrediction("test_nm.obj",
+                 MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM);
+  TestPrediction("cube_att.obj",
+                 MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM);
+}
+
+}  // namespace draco
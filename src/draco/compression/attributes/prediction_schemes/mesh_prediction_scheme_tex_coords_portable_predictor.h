@@ -89,19 +89,28 @@ bool MeshPredictionSchemeTexCoordsPortablePredictor<
   // Compute the predicted UV coordinate from the positions on all corners
   // of the processed triangle. For the best prediction, the UV coordinates
   // on the next/previous corners need to be already encoded/decoded.
-  const CornerIndex next_corner_id = mesh_data_.corner_table()->Next(corner_id);
-  const CornerIndex prev_corner_id =
-      mesh_data_.corner_table()->Previous(corner_id);
   // Get the encoded data ids from the next and previous corners.
   // The data id is the encoding order of the UV coordinates.
   int next_data_id, prev_data_id;
 
-  int next_vert_id, prev_vert_id;
-  next_vert_id = mesh_data_.corner_table()->Vertex(next_corner_id).value();
-  prev_vert_id = mesh_data_.corner_table()->Vertex(prev_corner_id).value();
+  if (mesh_data_.topology() != nullptr) {
+    // The data ids were already computed for all corners.
+    const MeshPredictionSchemeTopology::Entry &entry =
+        mesh_data_.topology()->entry(data_id);
+    next_data_id = entry.next_entry;
+    prev_data_id = entry.prev_entry;
+  } else {
+    const CornerIndex next_corner_id =
+        mesh_data_.corner_table()->Next(corner_id);
+    const CornerIndex prev_corner_id =
+        mesh_data_.corner_table()->Previous(corner_id);
+    int next_vert_id, prev_vert_id;
+    next_vert_id = mesh_data_.corner_table()->Vertex(next_corner_id).value();
+    prev_vert_id = mesh_data_.corner_table()->Vertex(prev_corner_id).value();
 
-  next_data_id = mesh_data_.vertex_to_data_map()->at(next_vert_id);
-  prev_data_id = mesh_data_.vertex_to_data_map()->at(prev_vert_id);
+    next_data_id = mesh_data_.vertex_to_data_map()->at(next_vert_id);
+    prev_data_id = mesh_data_.vertex_to_data_map()->at(prev_vert_id);
+  }
 
   if (prev_data_id < data_id && next_data_id < data_id) {
     // Both other corners have available UV coordinates for prediction.
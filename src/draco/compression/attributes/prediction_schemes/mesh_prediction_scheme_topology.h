@@ -0,0 +1,150 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TOPOLOGY_H_
+#define DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TOPOLOGY_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/attributes/mesh_attribute_indices_encoding_data.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_parallelogram_shared.h"
+
+namespace draco {
+
+// Class storing the neighboring data entries of all attribute values that are
+// used by mesh prediction schemes. The entries depend only on the corner table
+// and on the order in which the attribute values were decoded, so they can be
+// shared by all attributes decoded with the same corner table and encoding
+// data.
+class MeshPredictionSchemeTopology {
+ public:
+  struct Entry {
+    // Data entries on the next and previous corners of the corner on which
+    // the value was decoded.
+    int next_entry;
+    int prev_entry;
+    // Data entries of the opposite, next and previous vertices of the
+    // parallelogram that can be used to predict the value. Valid only when
+    // |has_parallelogram| is true.
+    int parallelogram_entries[3];
+    bool has_parallelogram;
+  };
+
+  // Computes the entries of all values decoded on the corners stored in
+  // |data_to_corner_map|.
+  template <class CornerTableT>
+  void Compute(const CornerTableT *table,
+               const std::vector<CornerIndex> &data_to_corner_map,
+               const std::vector<int32_t> &vertex_to_data_map) {
+    const int num_entries = static_cast<int>(data_to_corner_map.size());
+    entries_.resize(num_entries);
+    for (int p = 0; p < num_entries; ++p) {
+      const CornerIndex corner_id = data_to_corner_map[p];
+      Entry &entry = entries_[p];
+      entry.next_entry = GetDataEntry(
+          table->Vertex(table->Next(corner_id)), vertex_to_data_map, p);
+      entry.prev_entry = GetDataEntry(
+          table->Vertex(table->Previous(corner_id)), vertex_to_data_map, p);
+      entry.has_parallelogram = GetParallelogramPredictionEntries(
+          p, corner_id, table, vertex_to_data_map, entry.parallelogram_entries);
+    }
+  }
+
+  int num_entries() const { return static_cast<int>(entries_.size()); }
+  const Entry &entry(int data_id) const { return entries_[data_id]; }
+
+ private:
+  // Returns the data entry of vertex |vi| or |data_id| (an entry that is not
+  // decoded before |data_id|) when the vertex is not mapped to any entry.
+  static int GetDataEntry(VertexIndex vi,
+                          const std::vector<int32_t> &vertex_to_data_map,
+                          int data_id) {
+    if (vi.value() >= vertex_to_data_map.size())
+      return data_id;
+    return vertex_to_data_map[vi.value()];
+  }
+
+  std::vector<Entry> entries_;
+};
+
+// Cache of the topology used by mesh prediction schemes of all attributes of a
+// decoded mesh. There is at most one topology for every combination of corner
+// table and attribute decoding order, so the cache never holds more topologies
+// than there are attributes. A topology is computed only when it is requested
+// by at least two prediction schemes, because computing the topology for a
+// single scheme is more expensive than walking the corner table directly. The
+// decoder releases the cache once all attributes are decoded.
+class MeshPredictionSchemeTopologyCache {
+ public:
+  // Returns the topology for attributes decoded with the given |table| and
+  // |encoding_data|. The first request for a given decoding order only
+  // registers the order and returns nullptr. The topology is computed on the
+  // second request and it is shared with all subsequent requests for attributes
+  // that were decoded in the same order.
+  template <class CornerTableT>
+  const MeshPredictionSchemeTopology *GetTopology(
+      const CornerTableT *table,
+      const MeshAttributeIndicesEncodingData *encoding_data) {
+    for (CachedTopology &cached_topology : topologies_) {
+      if (cached_topology.table != table)
+        continue;
+      // Attributes decoded by different attribute decoders have separate
+      // encoding data, but they are often traversed in the same order.
+      if (cached_topology.encoding_data != encoding_data &&
+          (cached_topology.encoding_data
+                   ->encoded_attribute_value_index_to_corner_map !=
+               encoding_data->encoded_attribute_value_index_to_corner_map ||
+           cached_topology.encoding_data
+                   ->vertex_to_encoded_attribute_value_index_map !=
+               encoding_data->vertex_to_encoded_attribute_value_index_map))
+        continue;
+      if (cached_topology.topology == nullptr) {
+        cached_topology.topology.reset(new MeshPredictionSchemeTopology());
+        cached_topology.topology->Compute(
+            table, encoding_data->encoded_attribute_value_index_to_corner_map,
+            encoding_data->vertex_to_encoded_attribute_value_index_map);
+      }
+      return cached_topology.topology.get();
+    }
+    topologies_.push_back({table, encoding_data, nullptr});
+    return nullptr;
+  }
+
+  // Releases all cached topologies.
+  void Clear() { topologies_.clear(); }
+
+  // Returns the number of computed topologies.
+  int num_topologies() const {
+    int num_topologies = 0;
+    for (const CachedTopology &cached_topology : topologies_) {
+      if (cached_topology.topology != nullptr)
+        ++num_topologies;
+    }
+    return num_topologies;
+  }
+
+ private:
+  struct CachedTopology {
+    const void *table;
+    const MeshAttributeIndicesEncodingData *encoding_data;
+    // Null until the topology is requested for the second time.
+    std::unique_ptr<MeshPredictionSchemeTopology> topology;
+  };
+  std::vector<CachedTopology> topologies_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ATTRIBUTES_PREDICTION_SCHEMES_MESH_PREDICTION_SCHEME_TOPOLOGY_H_
@@ -0,0 +1,165 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_topology.h"
+
+#include <cstring>
+#include <utility>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/mesh/corner_table.h"
+
+namespace draco {
+
+class MeshPredictionSchemeTopologyTest : public ::testing::Test {
+ protected:
+  // Initializes |encoding_data| with attribute values ordered by the vertices
+  // of |table|.
+  void InitEncodingData(const CornerTable &table,
+                        MeshAttributeIndicesEncodingData *encoding_data) {
+    encoding_data->Init(table.num_vertices());
+    for (VertexIndex v(0); v < table.num_vertices(); ++v) {
+      encoding_data->encoded_attribute_value_index_to_corner_map.push_back(
+          table.LeftMostCorner(v));
+      encoding_data->vertex_to_encoded_attribute_value_index_map[v.value()] =
+          v.value();
+    }
+    encoding_data->num_values = table.num_vertices();
+  }
+};
+
+TEST_F(MeshPredictionSchemeTopologyTest, TestTopology) {
+  const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile("cube_att.obj"));
+  ASSERT_NE(mesh, nullptr);
+  const std::shared_ptr<const CornerTable> table =
+      mesh->GetCornerTableFromPositionAttribute();
+  ASSERT_NE(table, nullptr);
+  MeshAttributeIndicesEncodingData encoding_data;
+  InitEncodingData(*table, &encoding_data);
+
+  MeshPredictionSchemeTopologyCache cache;
+  // The topology is not computed for the first prediction scheme.
+  ASSERT_EQ(cache.GetTopology(table.get(), &encoding_data), nullptr);
+  ASSERT_EQ(cache.num_topologies(), 0);
+  const MeshPredictionSchemeTopology *const topology =
+      cache.GetTopology(table.get(), &encoding_data);
+  ASSERT_NE(topology, nullptr);
+  ASSERT_EQ(cache.num_topologies(), 1);
+  ASSERT_EQ(topology->num_entries(), table->num_vertices());
+  const std::vector<int32_t> &vertex_to_data_map =
+      encoding_data.vertex_to_encoded_attribute_value_index_map;
+  int num_parallelograms = 0;
+  for (int p = 0; p < topology->num_entries(); ++p) {
+    const CornerIndex ci =
+        encoding_data.encoded_attribute_value_index_to_corner_map[p];
+    const MeshPredictionSchemeTopology::Entry &entry = topology->entry(p);
+    ASSERT_EQ(entry.next_entry,
+              vertex_to_data_map[table->Vertex(table->Next(ci)).value()]);
+    ASSERT_EQ(entry.prev_entry,
+              vertex_to_data_map[table->Vertex(table->Previous(ci)).value()]);
+    int entries[3];
+    const bool has_parallelogram = GetParallelogramPredictionEntries(
+        p, ci, table.get(), vertex_to_data_map, entries);
+    ASSERT_EQ(entry.has_parallelogram, has_parallelogram);
+    if (has_parallelogram) {
+      ++num_parallelograms;
+      for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(entry.parallelogram_entries[i], entries[i]);
+      }
+    }
+  }
+  ASSERT_GT(num_parallelograms, 0);
+
+  // The topology is shared by all requests with the same data.
+  ASSERT_EQ(cache.GetTopology(table.get(), &encoding_data), topology);
+  ASSERT_EQ(cache.num_topologies(), 1);
+
+  // Attributes with separate encoding data decoded in the same order share
+  // the topology as well.
+  MeshAttributeIndicesEncodingData same_encoding_data;
+  InitEncodingData(*table, &same_encoding_data);
+  ASSERT_EQ(cache.GetTopology(table.get(), &same_encoding_data), topology);
+  ASSERT_EQ(cache.num_topologies(), 1);
+
+  // Attributes decoded in a different order get their own topology.
+  MeshAttributeIndicesEncodingData other_encoding_data;
+  InitEncodingData(*table, &other_encoding_data);
+  std::swap(other_encoding_data.encoded_attribute_value_index_to_corner_map[0],
+            other_encoding_data.encoded_attribute_value_index_to_corner_map[1]);
+  std::swap(
+      other_encoding_data.vertex_to_encoded_attribute_value_index_map[0],
+      other_encoding_data.vertex_to_encoded_attribute_value_index_map[1]);
+  ASSERT_EQ(cache.GetTopology(table.get(), &other_encoding_data), nullptr);
+  ASSERT_EQ(cache.num_topologies(), 1);
+  const MeshPredictionSchemeTopology *const other_topology =
+      cache.GetTopology(table.get(), &other_encoding_data);
+  ASSERT_NE(other_topology, nullptr);
+  ASSERT_NE(other_topology, topology);
+  ASSERT_EQ(cache.num_topologies(), 2);
+
+  cache.Clear();
+  ASSERT_EQ(cache.num_topologies(), 0);
+}
+
+TEST_F(MeshPredictionSchemeTopologyTest, TestSharedTopology) {
+  // Positions and a generic copy of the positions are decoded using the same
+  // topology. Both attributes must be decoded to the same values.
+  const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile("bun_zipper.ply"));
+  ASSERT_NE(mesh, nullptr);
+  const PointAttribute *const pos_att =
+      mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+  std::unique_ptr<PointAttribute> generic_att(new PointAttribute());
+  generic_att->CopyFrom(*pos_att);
+  generic_att->set_attribute_type(GeometryAttribute::GENERIC);
+  mesh->AddAttribute(std::move(generic_att));
+
+  Encoder encoder;
+  encoder.SetEncodingMethod(MESH_EDGEBREAKER_ENCODING);
+  for (const GeometryAttribute::Type type :
+       {GeometryAttribute::POSITION, GeometryAttribute::GENERIC}) {
+    encoder.SetAttributeQuantization(type, 14);
+    ASSERT_TRUE(encoder
+                    .SetAttributePredictionScheme(
+                        type, MESH_PREDICTION_PARALLELOGRAM)
+                    .ok());
+  }
+  EncoderBuffer buffer;
+  ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  Decoder decoder;
+  auto status_or = decoder.DecodeMeshFromBuffer(&dec_buffer);
+  ASSERT_TRUE(status_or.ok());
+  const std::unique_ptr<Mesh> decoded_mesh = std::move(status_or).value();
+  const PointAttribute *const decoded_pos_att =
+      decoded_mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+  const PointAttribute *const decoded_generic_att =
+      decoded_mesh->GetNamedAttribute(GeometryAttribute::GENERIC);
+  ASSERT_NE(decoded_pos_att, nullptr);
+  ASSERT_NE(decoded_generic_att, nullptr);
+  for (PointIndex pi(0); pi < decoded_mesh->num_points(); ++pi) {
+    ASSERT_EQ(std::memcmp(decoded_pos_att->GetAddress(
+                              decoded_pos_att->mapped_index(pi)),
+                          decoded_generic_att->GetAddress(
+                              decoded_generic_att->mapped_index(pi)),
+                          decoded_pos_att->byte_stride()),
+              0);
+  }
+}
+
+}  // namespace draco
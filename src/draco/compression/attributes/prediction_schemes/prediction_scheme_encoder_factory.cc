@@ -14,6 +14,8 @@
 //
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_encoder_factory.h"
 
+#include <algorithm>
+
 namespace draco {
 
 PredictionSchemeMethod SelectPredictionMethod(
@@ -57,6 +59,32 @@ PredictionSchemeMethod SelectPredictionMethod(
   return PREDICTION_DIFFERENCE;
 }
 
+std::vector<PredictionSchemeMethod> GetTrialPredictionMethods(
+    int att_id, const PointCloudEncoder *encoder) {
+  std::vector<PredictionSchemeMethod> candidates;
+  const auto add_candidate = [&candidates](PredictionSchemeMethod method) {
+    if (std::find(candidates.begin(), candidates.end(), method) ==
+        candidates.end())
+      candidates.push_back(method);
+  };
+  add_candidate(SelectPredictionMethod(att_id, encoder));
+  add_candidate(PREDICTION_DIFFERENCE);
+  if (encoder->GetGeometryType() == TRIANGULAR_MESH) {
+    const PointAttribute *const att = encoder->point_cloud()->attribute(att_id);
+    if (att->attribute_type() == GeometryAttribute::NORMAL) {
+#ifdef DRACO_NORMAL_ENCODING_SUPPORTED
+      add_candidate(MESH_PREDICTION_GEOMETRIC_NORMAL);
+#endif
+      return candidates;
+    }
+    add_candidate(MESH_PREDICTION_PARALLELOGRAM);
+    add_candidate(MESH_PREDICTION_CONSTRAINED_MULTI_PARALLELOGRAM);
+    if (att->attribute_type() == GeometryAttribute::TEX_COORD)
+      add_candidate(MESH_PREDICTION_TEX_COORDS_PORTABLE);
+  }
+  return candidates;
+}
+
 // Returns the preferred prediction scheme based on the encoder options.
 PredictionSchemeMethod GetPredictionMethodFromOptions(
     int att_id, const EncoderOptions &options) {
@@ -38,6 +38,13 @@ namespace draco {
 PredictionSchemeMethod SelectPredictionMethod(int att_id,
                                               const PointCloudEncoder *encoder);
 
+// Returns all prediction methods that can be used for the given attribute. The
+// method returned by SelectPredictionMethod() is always the first one. Used
+// when the encoder selects the prediction method by trial encoding (see
+// "select_prediction_schemes_by_trial" option).
+std::vector<PredictionSchemeMethod> GetTrialPredictionMethods(
+    int att_id, const PointCloudEncoder *encoder);
+
 // Factory class for creating mesh prediction schemes.
 template <typename DataTypeT>
 struct MeshPredictionSchemeEncoderFactory {
@@ -29,6 +29,13 @@
 
 namespace draco {
 
+// Returns true when the prediction schemes for |method| use the topology
+// stored in MeshPredictionSchemeTopology.
+inline bool IsMeshPredictionSchemeTopologyUsed(PredictionSchemeMethod method) {
+  return method == MESH_PREDICTION_PARALLELOGRAM ||
+         method == MESH_PREDICTION_TEX_COORDS_PORTABLE;
+}
+
 template <class EncodingDataSourceT, class PredictionSchemeT,
           class MeshPredictionSchemeFactoryT>
 std::unique_ptr<PredictionSchemeT> CreateMeshPredictionScheme(
@@ -51,6 +58,13 @@ std::unique_ptr<PredictionSchemeT> CreateMeshPredictionScheme(
       return nullptr;
     }
     // Connectivity data exists.
+    // The topology is shared with all other attributes that use the same
+    // connectivity data. It's available only when the |source| caches it and
+    // when an earlier attribute already requested the same topology.
+    MeshPredictionSchemeTopologyCache *const topology_cache =
+        IsMeshPredictionSchemeTopologyUsed(method)
+            ? source->prediction_topology_cache()
+            : nullptr;
     const MeshAttributeCornerTable *const att_ct =
         source->GetAttributeCornerTable(att_id);
     if (att_ct != nullptr) {
@@ -59,6 +73,8 @@ std::unique_ptr<PredictionSchemeT> CreateMeshPredictionScheme(
       md.Set(source->mesh(), att_ct,
              &encoding_data->encoded_attribute_value_index_to_corner_map,
              &encoding_data->vertex_to_encoded_attribute_value_index_map);
+      if (topology_cache != nullptr)
+        md.set_topology(topology_cache->GetTopology(att_ct, encoding_data));
       MeshPredictionSchemeFactoryT factory;
       auto ret = factory(method, att, transform, md, bitstream_version);
       if (ret)
@@ -69,6 +85,8 @@ std::unique_ptr<PredictionSchemeT> CreateMeshPredictionScheme(
       md.Set(source->mesh(), ct,
              &encoding_data->encoded_attribute_value_index_to_corner_map,
              &encoding_data->vertex_to_encoded_attribute_value_index_map);
+      if (topology_cache != nullptr)
+        md.set_topology(topology_cache->GetTopology(ct, encoding_data));
       MeshPredictionSchemeFactoryT factory;
       auto ret = factory(method, att, transform, md, bitstream_version);
       if (ret)
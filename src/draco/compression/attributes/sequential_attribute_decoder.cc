@@ -17,7 +17,10 @@
 namespace draco {
 
 SequentialAttributeDecoder::SequentialAttributeDecoder()
-    : decoder_(nullptr), attribute_(nullptr), attribute_id_(-1) {}
+    : decoder_(nullptr),
+      attribute_(nullptr),
+      attribute_id_(-1),
+      postpone_portable_computation_(false) {}
 
 bool SequentialAttributeDecoder::Init(PointCloudDecoder *decoder,
                                       int attribute_id) {
@@ -76,6 +79,7 @@ bool SequentialAttributeDecoder::InitPredictionScheme(
         ps->GetParentAttributeType(i));
     if (att_id == -1)
       return false;  // Requested attribute does not exist.
+    parent_attribute_ids_.push_back(att_id);
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
     if (decoder_->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 0)) {
       if (!ps->SetParentAttribute(decoder_->point_cloud()->attribute(att_id))) {
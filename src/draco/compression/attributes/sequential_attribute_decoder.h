@@ -39,6 +39,26 @@ class SequentialAttributeDecoder {
   virtual bool DecodePortableAttribute(const std::vector<PointIndex> &point_ids,
                                        DecoderBuffer *in_buffer);
 
+  // Finishes decoding of the portable attribute data when a part of the
+  // decoding was postponed by DecodePortableAttribute() (see
+  // set_postpone_portable_computation()).
+  virtual bool FinalizePortableAttribute(
+      const std::vector<PointIndex> &point_ids) {
+    return true;
+  }
+
+  // When set, DecodePortableAttribute() decodes only the data stored in the
+  // input buffer and any computation that does not access the buffer (such as
+  // reverting of the prediction scheme) is postponed to
+  // FinalizePortableAttribute(). The finalization can then run concurrently
+  // with decoding of other attributes.
+  void set_postpone_portable_computation(bool postpone) {
+    postpone_portable_computation_ = postpone;
+  }
+  bool postpone_portable_computation() const {
+    return postpone_portable_computation_;
+  }
+
   // Decodes any data needed to revert portable transform of the decoded
   // attribute.
   virtual bool DecodeDataNeededByPortableTransform(
@@ -56,6 +76,12 @@ class SequentialAttributeDecoder {
   int attribute_id() const { return attribute_id_; }
   PointCloudDecoder *decoder() const { return decoder_; }
 
+  // Returns ids of attributes whose portable data are used by the prediction
+  // scheme of this attribute.
+  const std::vector<int32_t> &parent_attribute_ids() const {
+    return parent_attribute_ids_;
+  }
+
  protected:
   // Should be used to initialize newly created prediction scheme.
   // Returns false when the initialization failed (in which case the scheme
@@ -80,6 +106,9 @@ class SequentialAttributeDecoder {
 
   // Storage for decoded portable attribute (after lossless decoding).
   std::unique_ptr<PointAttribute> portable_attribute_;
+
+  std::vector<int32_t> parent_attribute_ids_;
+  bool postpone_portable_computation_;
 };
 
 }  // namespace draco
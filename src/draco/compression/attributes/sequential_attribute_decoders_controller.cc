@@ -13,17 +13,23 @@
 // limitations under the License.
 //
 #include "draco/compression/attributes/sequential_attribute_decoders_controller.h"
+
+#include <algorithm>
+
 #ifdef DRACO_NORMAL_ENCODING_SUPPORTED
 #include "draco/compression/attributes/sequential_normal_attribute_decoder.h"
 #endif
 #include "draco/compression/attributes/sequential_quantization_attribute_decoder.h"
 #include "draco/compression/config/compression_shared.h"
+#include "draco/core/varint_decoding.h"
 
 namespace draco {
 
 SequentialAttributeDecodersController::SequentialAttributeDecodersController(
     std::unique_ptr<PointsSequencer> sequencer)
-    : sequencer_(std::move(sequencer)) {}
+    : sequencer_(std::move(sequencer)),
+      point_block_size_(0),
+      num_encoded_points_(0) {}
 
 bool SequentialAttributeDecodersController::DecodeAttributesDecoderData(
     DecoderBuffer *buffer) {
@@ -48,6 +54,56 @@ bool SequentialAttributeDecodersController::DecodeAttributesDecoderData(
 
 bool SequentialAttributeDecodersController::DecodeAttributes(
     DecoderBuffer *buffer) {
+  if (!GeneratePointIds())
+    return false;
+  if (point_block_size_ > 0)
+    return DecodeAttributesInBlocks(buffer);
+  return AttributesDecoder::DecodeAttributes(buffer);
+}
+
+bool SequentialAttributeDecodersController::DecodeAttributesData(
+    DecoderBuffer *buffer) {
+  if (point_block_size_ > 0) {
+    // Blocks are fully decoded here. There is nothing left for
+    // FinalizeAttributes().
+    return DecodeAttributes(buffer);
+  }
+  if (!GeneratePointIds())
+    return false;
+  const int32_t num_attributes = GetNumAttributes();
+  for (int i = 0; i < num_attributes; ++i) {
+    sequential_decoders_[i]->set_postpone_portable_computation(true);
+  }
+  if (!AttributesDecoder::DecodeAttributesData(buffer))
+    return false;
+  for (int i = 0; i < num_attributes; ++i) {
+    // GetPortableAttribute() may update the point mapping of the portable
+    // attribute. Make sure it happens now and not during the finalization
+    // where the portable attribute can be accessed from multiple threads.
+    if (IsAttributeTransformSkipped(i))
+      sequential_decoders_[i]->GetPortableAttribute();
+  }
+  return true;
+}
+
+bool SequentialAttributeDecodersController::FinalizeAttributes() {
+  if (point_block_size_ > 0)
+    return true;
+  return AttributesDecoder::FinalizeAttributes();
+}
+
+std::vector<int32_t>
+SequentialAttributeDecodersController::GetParentAttributeIds() const {
+  std::vector<int32_t> parent_ids;
+  for (const auto &seq_decoder : sequential_decoders_) {
+    parent_ids.insert(parent_ids.end(),
+                      seq_decoder->parent_attribute_ids().begin(),
+                      seq_decoder->parent_attribute_ids().end());
+  }
+  return parent_ids;
+}
+
+bool SequentialAttributeDecodersController::GeneratePointIds() {
   if (!sequencer_ || !sequencer_->GenerateSequence(&point_ids_))
     return false;
   // Initialize point to attribute value mapping for all decoded attributes.
@@ -58,7 +114,81 @@ bool SequentialAttributeDecodersController::DecodeAttributes(
     if (!sequencer_->UpdatePointToAttributeIndexMapping(pa))
       return false;
   }
-  return AttributesDecoder::DecodeAttributes(buffer);
+  return true;
+}
+
+bool SequentialAttributeDecodersController::DecodeAttributesInBlocks(
+    DecoderBuffer *in_buffer) {
+  const uint64_t num_blocks =
+      (static_cast<uint64_t>(num_encoded_points_) + point_block_size_ - 1) /
+      point_block_size_;
+  // Every block takes at least one byte of the size table.
+  if (num_blocks > static_cast<uint64_t>(in_buffer->remaining_size()))
+    return false;
+  std::vector<uint64_t> block_offsets(num_blocks + 1, 0);
+  for (uint64_t b = 0; b < num_blocks; ++b) {
+    uint64_t block_size;
+    if (!DecodeVarint(&block_size, in_buffer))
+      return false;
+    block_offsets[b + 1] = block_offsets[b] + block_size;
+    if (block_offsets[b + 1] >
+        static_cast<uint64_t>(in_buffer->remaining_size()))
+      return false;
+  }
+
+  // Each block is decoded into the attributes of the point cloud that are
+  // reset to the size of the block, so the decoded values are collected in
+  // separate buffers and copied to the attributes at the end.
+  const std::vector<PointIndex> all_point_ids = std::move(point_ids_);
+  const int32_t num_attributes = GetNumAttributes();
+  std::vector<std::vector<uint8_t>> attribute_data(num_attributes);
+  size_t num_decoded_points = 0;
+  for (const uint32_t b : point_blocks_) {
+    if (b >= num_blocks)
+      return false;
+    const size_t num_block_points = static_cast<size_t>(
+        std::min<uint64_t>(point_block_size_,
+                           num_encoded_points_ -
+                               static_cast<uint64_t>(b) * point_block_size_));
+    if (num_decoded_points + num_block_points > all_point_ids.size())
+      return false;
+    point_ids_.assign(all_point_ids.begin() + num_decoded_points,
+                      all_point_ids.begin() + num_decoded_points +
+                          num_block_points);
+    DecoderBuffer block_buffer;
+    block_buffer.Init(in_buffer->data_head() + block_offsets[b],
+                      block_offsets[b + 1] - block_offsets[b],
+                      in_buffer->bitstream_version());
+    if (!AttributesDecoder::DecodeAttributes(&block_buffer))
+      return false;
+    for (int j = 0; j < num_attributes; ++j) {
+      const PointAttribute *const att =
+          GetDecoder()->point_cloud()->attribute(GetAttributeId(j));
+      const size_t num_bytes = num_block_points * att->byte_stride();
+      if (att->size() != num_block_points)
+        return false;
+      const uint8_t *const data = att->GetAddress(AttributeValueIndex(0));
+      attribute_data[j].insert(attribute_data[j].end(), data,
+                               data + num_bytes);
+    }
+    num_decoded_points += num_block_points;
+  }
+  if (num_decoded_points != all_point_ids.size())
+    return false;
+  point_ids_ = all_point_ids;
+  in_buffer->Advance(block_offsets[num_blocks]);
+
+  for (int j = 0; j < num_attributes; ++j) {
+    PointAttribute *const att =
+        GetDecoder()->point_cloud()->attribute(GetAttributeId(j));
+    if (!att->Reset(num_decoded_points))
+      return false;
+    if (num_decoded_points > 0) {
+      att->buffer()->Write(0, attribute_data[j].data(),
+                           attribute_data[j].size());
+    }
+  }
+  return true;
 }
 
 bool SequentialAttributeDecodersController::DecodePortableAttributes(
@@ -83,19 +213,26 @@ bool SequentialAttributeDecodersController::
   return true;
 }
 
+bool SequentialAttributeDecodersController::FinalizePortableAttributes() {
+  const int32_t num_attributes = GetNumAttributes();
+  for (int i = 0; i < num_attributes; ++i) {
+    if (!sequential_decoders_[i]->FinalizePortableAttribute(point_ids_))
+      return false;
+  }
+  return true;
+}
+
 bool SequentialAttributeDecodersController::
     TransformAttributesToOriginalFormat() {
   const int32_t num_attributes = GetNumAttributes();
   for (int i = 0; i < num_attributes; ++i) {
     // Check whether the attribute transform should be skipped.
-    if (GetDecoder()->options()) {
-      const PointAttribute *const attribute =
-          sequential_decoders_[i]->attribute();
+    if (IsAttributeTransformSkipped(i)) {
       const PointAttribute *const portable_attribute =
           sequential_decoders_[i]->GetPortableAttribute();
       if (portable_attribute &&
-          GetDecoder()->options()->GetAttributeBool(
-              attribute->attribute_type(), "skip_attribute_transform", false)) {
+          (portable_attribute->GetAttributeTransformData() ||
+           !IsUntransformedAttributeKept(i))) {
         // Attribute transform should not be performed. In this case, we replace
         // the output geometry attribute with the portable attribute.
         // TODO(ostava): We can potentially avoid this copy by introducing a new
@@ -112,6 +249,24 @@ bool SequentialAttributeDecodersController::
   return true;
 }
 
+bool SequentialAttributeDecodersController::IsAttributeTransformSkipped(
+    int i) const {
+  if (!GetDecoder()->options())
+    return false;
+  return GetDecoder()->options()->GetAttributeBool(
+      sequential_decoders_[i]->attribute()->attribute_type(),
+      "skip_attribute_transform", false);
+}
+
+bool SequentialAttributeDecodersController::IsUntransformedAttributeKept(
+    int i) const {
+  if (!GetDecoder()->options())
+    return false;
+  return GetDecoder()->options()->GetAttributeBool(
+      sequential_decoders_[i]->attribute()->attribute_type(),
+      "keep_untransformed_attributes", false);
+}
+
 std::unique_ptr<SequentialAttributeDecoder>
 SequentialAttributeDecodersController::CreateSequentialDecoder(
     uint8_t decoder_type) {
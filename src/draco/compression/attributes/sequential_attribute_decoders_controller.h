@@ -34,6 +34,9 @@ class SequentialAttributeDecodersController : public AttributesDecoder {
 
   bool DecodeAttributesDecoderData(DecoderBuffer *buffer) override;
   bool DecodeAttributes(DecoderBuffer *buffer) override;
+  bool DecodeAttributesData(DecoderBuffer *buffer) override;
+  bool FinalizeAttributes() override;
+  std::vector<int32_t> GetParentAttributeIds() const override;
   const PointAttribute *GetPortableAttribute(
       int32_t point_attribute_id) override {
     const int32_t loc_id = GetLocalIdForPointAttribute(point_attribute_id);
@@ -42,17 +45,52 @@ class SequentialAttributeDecodersController : public AttributesDecoder {
     return sequential_decoders_[loc_id]->GetPortableAttribute();
   }
 
+  // Sets up decoding of attribute values that were encoded in blocks of
+  // |point_block_size| points (see SequentialAttributeEncodersController::
+  // SetPointBlockSize()). |num_encoded_points| is the number of points of all
+  // blocks. Only blocks listed in |point_blocks| are decoded and their values
+  // are stored one after another in the listed order. The number of points of
+  // the decoded blocks must match the length of the point sequence of this
+  // decoder.
+  void SetPointBlocks(int point_block_size, uint32_t num_encoded_points,
+                      const std::vector<uint32_t> &point_blocks) {
+    point_block_size_ = point_block_size;
+    num_encoded_points_ = num_encoded_points;
+    point_blocks_ = point_blocks;
+  }
+
  protected:
   bool DecodePortableAttributes(DecoderBuffer *in_buffer) override;
   bool DecodeDataNeededByPortableTransforms(DecoderBuffer *in_buffer) override;
   bool TransformAttributesToOriginalFormat() override;
+  bool FinalizePortableAttributes() override;
   virtual std::unique_ptr<SequentialAttributeDecoder> CreateSequentialDecoder(
       uint8_t decoder_type);
 
  private:
+  // Generates the sequence of decoded points and initializes the point to
+  // attribute value mapping for all decoded attributes.
+  bool GeneratePointIds();
+
+  // Decodes all attributes from blocks set in SetPointBlocks().
+  bool DecodeAttributesInBlocks(DecoderBuffer *in_buffer);
+
+  // Returns true when the transform of the |i|-th attribute should not be
+  // reverted (see Decoder::SetSkipAttributeTransform()).
+  bool IsAttributeTransformSkipped(int i) const;
+
+  // Returns true when the |i|-th attribute should be decoded in its original
+  // format even if its transform is skipped, provided that the attribute has
+  // no transform data (e.g. integer attributes). Otherwise such attributes are
+  // replaced by their portable int32 version.
+  bool IsUntransformedAttributeKept(int i) const;
+
   std::vector<std::unique_ptr<SequentialAttributeDecoder>> sequential_decoders_;
   std::vector<PointIndex> point_ids_;
   std::unique_ptr<PointsSequencer> sequencer_;
+  int point_block_size_;
+  uint32_t num_encoded_points_;
+  std::vector<uint32_t> point_blocks_;
 };
 
 }  // namespace draco
@@ -14,6 +14,8 @@
 //
 #include "draco/compression/attributes/sequential_attribute_encoder.h"
 
+#include <algorithm>
+
 namespace draco {
 
 SequentialAttributeEncoder::SequentialAttributeEncoder()
@@ -88,6 +90,35 @@ bool SequentialAttributeEncoder::InitPredictionScheme(
   return true;
 }
 
+bool SequentialAttributeEncoder::InitTrialPredictionScheme(
+    PredictionSchemeInterface *ps) {
+  for (int i = 0; i < ps->GetNumParentAttributes(); ++i) {
+    const int att_id = encoder_->point_cloud()->GetNamedAttributeId(
+        ps->GetParentAttributeType(i));
+    if (att_id == -1)
+      return false;  // Requested attribute does not exist.
+    // The parent attribute is encoded before this attribute, but it is not
+    // marked as a parent until the scheme is selected.
+    if (std::find(parent_attributes_.begin(), parent_attributes_.end(),
+                  att_id) == parent_attributes_.end())
+      parent_attributes_.push_back(att_id);
+  }
+  return true;
+}
+
+bool SequentialAttributeEncoder::MarkPredictionSchemeParentAttributes(
+    PredictionSchemeInterface *ps) {
+  for (int i = 0; i < ps->GetNumParentAttributes(); ++i) {
+    const int att_id = encoder_->point_cloud()->GetNamedAttributeId(
+        ps->GetParentAttributeType(i));
+    if (att_id == -1)
+      return false;  // Requested attribute does not exist.
+    if (!encoder_->MarkParentAttribute(att_id))
+      return false;
+  }
+  return true;
+}
+
 bool SequentialAttributeEncoder::SetPredictionSchemeParentAttributes(
     PredictionSchemeInterface *ps) {
   for (int i = 0; i < ps->GetNumParentAttributes(); ++i) {
@@ -101,4 +132,64 @@ bool SequentialAttributeEncoder::SetPredictionSchemeParentAttributes(
   return true;
 }
 
+bool SequentialAttributeEncoder::SetTrialPredictionSchemeParentAttributes(
+    PredictionSchemeInterface *ps,
+    std::vector<std::unique_ptr<PointAttribute>> *mapped_attributes) {
+  for (int i = 0; i < ps->GetNumParentAttributes(); ++i) {
+    const int att_id = encoder_->point_cloud()->GetNamedAttributeId(
+        ps->GetParentAttributeType(i));
+    if (att_id == -1)
+      return false;  // Requested attribute does not exist.
+    std::unique_ptr<PointAttribute> mapped_att =
+        encoder_->CreateMappedPortableAttribute(att_id);
+    if (mapped_att == nullptr) {
+      if (!ps->SetParentAttribute(encoder_->GetPortableAttribute(att_id)))
+        return false;
+      continue;
+    }
+    if (!ps->SetParentAttribute(mapped_att.get()))
+      return false;
+    mapped_attributes->push_back(std::move(mapped_att));
+  }
+  return true;
+}
+
+std::unique_ptr<PointAttribute>
+SequentialAttributeEncoder::CreateMappedPortableAttribute(
+    const std::vector<PointIndex> &point_ids) const {
+  if (portable_attribute_ == nullptr || is_parent_encoder_)
+    return nullptr;  // GetPortableAttribute() can be used directly.
+  std::unique_ptr<PointAttribute> mapped_att(new PointAttribute());
+  mapped_att->CopyFrom(*portable_attribute_);
+  SetPortableAttributePointMapping(point_ids, mapped_att.get());
+  return mapped_att;
+}
+
+void SequentialAttributeEncoder::UpdatePortableAttributePointMapping(
+    const std::vector<PointIndex> &point_ids) {
+  if (portable_attribute_ != nullptr)
+    SetPortableAttributePointMapping(point_ids, portable_attribute_.get());
+}
+
+void SequentialAttributeEncoder::SetPortableAttributePointMapping(
+    const std::vector<PointIndex> &point_ids,
+    PointAttribute *portable_att) const {
+  // First create map between original attribute value indices and new ones
+  // (determined by the encoding order).
+  const PointAttribute *const orig_att = attribute();
+  IndexTypeVector<AttributeValueIndex, AttributeValueIndex> value_to_value_map(
+      orig_att->size());
+  for (int i = 0; i < point_ids.size(); ++i) {
+    value_to_value_map[orig_att->mapped_index(point_ids[i])] =
+        AttributeValueIndex(i);
+  }
+  // Go over all points of the original attribute and update the mapping in
+  // the portable attribute.
+  portable_att->SetExplicitMapping(encoder_->point_cloud()->num_points());
+  for (PointIndex i(0); i < encoder_->point_cloud()->num_points(); ++i) {
+    portable_att->SetPointMapEntry(
+        i, value_to_value_map[orig_att->mapped_index(i)]);
+  }
+}
+
 }  // namespace draco
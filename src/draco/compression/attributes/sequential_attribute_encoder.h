@@ -73,6 +73,19 @@ class SequentialAttributeEncoder {
   // encoder.
   void MarkParentAttribute();
 
+  // Returns a copy of the portable attribute that maps all points to the
+  // values encoded in the order of |point_ids|, i.e., the mapping of a parent
+  // attribute. It can be used for predictions before the encoder is marked as
+  // a parent. Returns nullptr when GetPortableAttribute() can be used directly.
+  std::unique_ptr<PointAttribute> CreateMappedPortableAttribute(
+      const std::vector<PointIndex> &point_ids) const;
+
+  // Adds the mapping of a parent attribute to an already generated portable
+  // attribute. Used when the encoder is marked as a parent only after its
+  // portable attribute was generated.
+  void UpdatePortableAttributePointMapping(
+      const std::vector<PointIndex> &point_ids);
+
   virtual uint8_t GetUniqueId() const {
     return SEQUENTIAL_ATTRIBUTE_ENCODER_GENERIC;
   }
@@ -87,12 +100,29 @@ class SequentialAttributeEncoder {
   // cannot be used).
   virtual bool InitPredictionScheme(PredictionSchemeInterface *ps);
 
+  // Same as InitPredictionScheme() but the parent attributes are not marked
+  // as parents. Used for candidate schemes evaluated by trial encoding. The
+  // parents of the selected scheme must be marked with
+  // MarkPredictionSchemeParentAttributes() before the scheme is used.
+  bool InitTrialPredictionScheme(PredictionSchemeInterface *ps);
+
+  // Marks all parent attributes of |ps| as parents.
+  bool MarkPredictionSchemeParentAttributes(PredictionSchemeInterface *ps);
+
   // Sets parent attributes for a given prediction scheme. Must be called
   // after all prediction schemes are initialized, but before the prediction
   // scheme is used.
   virtual bool SetPredictionSchemeParentAttributes(
       PredictionSchemeInterface *ps);
 
+  // Same as SetPredictionSchemeParentAttributes() but the parent attributes
+  // don't need to be marked as parents. Copies of the parent attributes that
+  // are created with a valid point mapping are stored in |mapped_attributes|
+  // and they must outlive the use of |ps|.
+  bool SetTrialPredictionSchemeParentAttributes(
+      PredictionSchemeInterface *ps,
+      std::vector<std::unique_ptr<PointAttribute>> *mapped_attributes);
+
   // Encodes all attribute values in the specified order. Should be overridden
   // for specialized  encoders.
   virtual bool EncodeValues(const std::vector<PointIndex> &point_ids,
@@ -109,6 +139,12 @@ class SequentialAttributeEncoder {
   // version, use the GetPortableAttribute() method.
   PointAttribute *portable_attribute() { return portable_attribute_.get(); }
 
+  // Maps all points to the values of |portable_att| that were generated in
+  // the order of |point_ids|.
+  void SetPortableAttributePointMapping(
+      const std::vector<PointIndex> &point_ids,
+      PointAttribute *portable_att) const;
+
  private:
   PointCloudEncoder *encoder_;
   const PointAttribute *attribute_;
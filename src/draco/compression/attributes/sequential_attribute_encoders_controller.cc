@@ -13,21 +13,27 @@
 // limitations under the License.
 //
 #include "draco/compression/attributes/sequential_attribute_encoders_controller.h"
+
+#include <algorithm>
+
 #ifdef DRACO_NORMAL_ENCODING_SUPPORTED
 #include "draco/compression/attributes/sequential_normal_attribute_encoder.h"
 #endif
 #include "draco/compression/attributes/sequential_quantization_attribute_encoder.h"
 #include "draco/compression/point_cloud/point_cloud_encoder.h"
+#include "draco/core/varint_encoding.h"
 
 namespace draco {
 
 SequentialAttributeEncodersController::SequentialAttributeEncodersController(
     std::unique_ptr<PointsSequencer> sequencer)
-    : sequencer_(std::move(sequencer)) {}
+    : sequencer_(std::move(sequencer)), point_block_size_(0) {}
 
 SequentialAttributeEncodersController::SequentialAttributeEncodersController(
     std::unique_ptr<PointsSequencer> sequencer, int att_id)
-    : AttributesEncoder(att_id), sequencer_(std::move(sequencer)) {}
+    : AttributesEncoder(att_id),
+      sequencer_(std::move(sequencer)),
+      point_block_size_(0) {}
 
 bool SequentialAttributeEncodersController::Init(PointCloudEncoder *encoder,
                                                  const PointCloud *pc) {
@@ -59,9 +65,39 @@ bool SequentialAttributeEncodersController::EncodeAttributes(
     EncoderBuffer *buffer) {
   if (!sequencer_ || !sequencer_->GenerateSequence(&point_ids_))
     return false;
+  if (point_block_size_ > 0)
+    return EncodeAttributesInBlocks(buffer);
   return AttributesEncoder::EncodeAttributes(buffer);
 }
 
+bool SequentialAttributeEncodersController::EncodeAttributesInBlocks(
+    EncoderBuffer *out_buffer) {
+  // Each block is encoded in the same way as the whole sequence would be,
+  // including the data needed by the portable transforms (e.g. quantization
+  // parameters) so that the blocks can be decoded independently.
+  const std::vector<PointIndex> all_point_ids = std::move(point_ids_);
+  const size_t num_blocks =
+      (all_point_ids.size() + point_block_size_ - 1) / point_block_size_;
+  std::vector<EncoderBuffer> block_buffers(num_blocks);
+  for (size_t b = 0; b < num_blocks; ++b) {
+    const size_t first_point = b * point_block_size_;
+    const size_t last_point =
+        std::min(all_point_ids.size(), first_point + point_block_size_);
+    point_ids_.assign(all_point_ids.begin() + first_point,
+                      all_point_ids.begin() + last_point);
+    if (!AttributesEncoder::EncodeAttributes(&block_buffers[b]))
+      return false;
+  }
+  point_ids_ = all_point_ids;
+  for (size_t b = 0; b < num_blocks; ++b) {
+    EncodeVarint(static_cast<uint64_t>(block_buffers[b].size()), out_buffer);
+  }
+  for (size_t b = 0; b < num_blocks; ++b) {
+    out_buffer->Encode(block_buffers[b].data(), block_buffers[b].size());
+  }
+  return true;
+}
+
 bool SequentialAttributeEncodersController::
     TransformAttributesToPortableFormat() {
   for (uint32_t i = 0; i < sequential_encoders_.size(); ++i) {
@@ -40,6 +40,16 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
   bool EncodeAttributes(EncoderBuffer *buffer) override;
   uint8_t GetUniqueId() const override { return BASIC_ATTRIBUTE_ENCODER; }
 
+  // When set to a value greater than zero, the attribute values are encoded
+  // in independent blocks of |point_block_size| points of the point sequence
+  // preceded by a table of their sizes. Any subset of the blocks can be then
+  // decoded on its own (see SequentialAttributeDecodersController::
+  // SetPointBlocks()). Prediction schemes are restarted at the beginning of
+  // each block. Must be called before the attributes are encoded.
+  void SetPointBlockSize(int point_block_size) {
+    point_block_size_ = point_block_size;
+  }
+
   int NumParentAttributes(int32_t point_attribute_id) const override {
     const int32_t loc_id = GetLocalIdForPointAttribute(point_attribute_id);
     if (loc_id < 0)
@@ -64,14 +74,29 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
     if (sequential_encoder_marked_as_parent_.size() <= loc_id) {
       sequential_encoder_marked_as_parent_.resize(loc_id + 1, false);
     }
+    const bool is_new_parent = !sequential_encoder_marked_as_parent_[loc_id];
     sequential_encoder_marked_as_parent_[loc_id] = true;
 
     if (sequential_encoders_.size() <= loc_id)
       return true;  // Sequential encoders not generated yet.
     sequential_encoders_[loc_id]->MarkParentAttribute();
+    // The attribute can be marked after its portable attribute was generated,
+    // e.g., by a prediction scheme selected by trial encoding.
+    if (is_new_parent && !point_ids_.empty())
+      sequential_encoders_[loc_id]->UpdatePortableAttributePointMapping(
+          point_ids_);
     return true;
   }
 
+  std::unique_ptr<PointAttribute> CreateMappedPortableAttribute(
+      int32_t point_attribute_id) override {
+    const int32_t loc_id = GetLocalIdForPointAttribute(point_attribute_id);
+    if (loc_id < 0)
+      return nullptr;
+    return sequential_encoders_[loc_id]->CreateMappedPortableAttribute(
+        point_ids_);
+  }
+
   const PointAttribute *GetPortableAttribute(
       int32_t point_attribute_id) override {
     const int32_t loc_id = GetLocalIdForPointAttribute(point_attribute_id);
@@ -96,6 +121,9 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
       int i);
 
  private:
+  // Encodes all attributes in blocks of |point_block_size_| points.
+  bool EncodeAttributesInBlocks(EncoderBuffer *out_buffer);
+
   std::vector<std::unique_ptr<SequentialAttributeEncoder>> sequential_encoders_;
 
   // Flag for each sequential attribute encoder indicating whether it was marked
@@ -103,6 +131,7 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
   std::vector<bool> sequential_encoder_marked_as_parent_;
   std::vector<PointIndex> point_ids_;
   std::unique_ptr<PointsSequencer> sequencer_;
+  int point_block_size_;
 };
 
 }  // namespace draco
@@ -128,8 +128,33 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
     }
   }
 
-  if (num_values > 0 && (prediction_scheme_ == nullptr ||
-                         !prediction_scheme_->AreCorrectionsPositive())) {
+  if (prediction_scheme_) {
+    if (!prediction_scheme_->DecodePredictionData(in_buffer))
+      return false;
+  }
+  if (postpone_portable_computation())
+    return true;
+  return ComputeOriginalValues(point_ids);
+}
+
+bool SequentialIntegerAttributeDecoder::FinalizePortableAttribute(
+    const std::vector<PointIndex> &point_ids) {
+  if (!postpone_portable_computation())
+    return true;  // Nothing was postponed.
+  return ComputeOriginalValues(point_ids);
+}
+
+bool SequentialIntegerAttributeDecoder::ComputeOriginalValues(
+    const std::vector<PointIndex> &point_ids) {
+  const int num_components = GetNumValueComponents();
+  const size_t num_values = point_ids.size() * num_components;
+  if (num_values == 0)
+    return true;
+  int32_t *const portable_attribute_data = GetPortableAttributeData();
+  if (portable_attribute_data == nullptr)
+    return false;
+  if (prediction_scheme_ == nullptr ||
+      !prediction_scheme_->AreCorrectionsPositive()) {
     // Convert the values back to the original signed format.
     ConvertSymbolsToSignedInts(
         reinterpret_cast<const uint32_t *>(portable_attribute_data),
@@ -138,15 +163,10 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
 
   // If the data was encoded with a prediction scheme, we must revert it.
   if (prediction_scheme_) {
-    if (!prediction_scheme_->DecodePredictionData(in_buffer))
+    if (!prediction_scheme_->ComputeOriginalValues(
+            portable_attribute_data, portable_attribute_data,
+            static_cast<int>(num_values), num_components, point_ids.data())) {
       return false;
-
-    if (num_values > 0) {
-      if (!prediction_scheme_->ComputeOriginalValues(
-              portable_attribute_data, portable_attribute_data,
-              static_cast<int>(num_values), num_components, point_ids.data())) {
-        return false;
-      }
     }
   }
   return true;
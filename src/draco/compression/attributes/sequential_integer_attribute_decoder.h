@@ -28,6 +28,9 @@ class SequentialIntegerAttributeDecoder : public SequentialAttributeDecoder {
   SequentialIntegerAttributeDecoder();
   bool Init(PointCloudDecoder *decoder, int attribute_id) override;
 
+  bool FinalizePortableAttribute(
+      const std::vector<PointIndex> &point_ids) override;
+
   bool TransformAttributeToOriginalFormat(
       const std::vector<PointIndex> &point_ids) override;
 
@@ -37,6 +40,10 @@ class SequentialIntegerAttributeDecoder : public SequentialAttributeDecoder {
   virtual bool DecodeIntegerValues(const std::vector<PointIndex> &point_ids,
                                    DecoderBuffer *in_buffer);
 
+  // Converts the decoded symbols into the portable attribute values by
+  // reverting the prediction scheme (if any).
+  bool ComputeOriginalValues(const std::vector<PointIndex> &point_ids);
+
   // Returns a prediction scheme that should be used for decoding of the
   // integer values.
   virtual std::unique_ptr<PredictionSchemeTypedDecoderInterface<int32_t>>
@@ -14,13 +14,48 @@
 //
 #include "draco/compression/attributes/sequential_integer_attribute_encoder.h"
 
+#include <algorithm>
+
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_encoder_factory.h"
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_wrap_encoding_transform.h"
+#include "draco/compression/config/encoding_features.h"
+#include "draco/compression/entropy/shannon_entropy.h"
 #include "draco/compression/entropy/symbol_encoding.h"
 #include "draco/core/bit_utils.h"
+#include "draco/core/thread_pool.h"
 
 namespace draco {
 
+namespace {
+
+// Symbols up to this value are evaluated using their Shannon entropy. The
+// entropy tracker allocates a frequency table for all symbols up to the
+// maximum one.
+constexpr uint32_t kMaxEntropyTrackedSymbol = 1 << 20;
+
+// Returns the estimated number of bits needed to encode |symbols| with the
+// built-in entropy coding.
+int64_t EstimateNumEncodedBits(const uint32_t *symbols, int num_symbols) {
+  const uint32_t max_symbol =
+      num_symbols > 0 ? *std::max_element(symbols, symbols + num_symbols) : 0;
+  if (max_symbol <= kMaxEntropyTrackedSymbol) {
+    ShannonEntropyTracker entropy_tracker;
+    const ShannonEntropyTracker::EntropyData entropy_data =
+        entropy_tracker.Push(symbols, num_symbols);
+    return ShannonEntropyTracker::GetNumberOfDataBits(entropy_data) +
+           ShannonEntropyTracker::GetNumberOfRAnsTableBits(entropy_data);
+  }
+  // Large symbols are encoded by their bit lengths (tagged coding), so the
+  // bit lengths are used as the estimate.
+  int64_t num_bits = 0;
+  for (int i = 0; i < num_symbols; ++i) {
+    num_bits += symbols[i] == 0 ? 1 : MostSignificantBit(symbols[i]) + 1;
+  }
+  return num_bits;
+}
+
+}  // namespace
+
 SequentialIntegerAttributeEncoder::SequentialIntegerAttributeEncoder() {}
 
 bool SequentialIntegerAttributeEncoder::Init(PointCloudEncoder *encoder,
@@ -45,19 +80,49 @@ bool SequentialIntegerAttributeEncoder::Init(PointCloudEncoder *encoder,
   // Init prediction scheme.
   const PredictionSchemeMethod prediction_scheme_method =
       GetPredictionMethodFromOptions(attribute_id, *encoder->options());
+  const bool select_by_trial =
+      prediction_scheme_method == PREDICTION_UNDEFINED &&
+      encoder->options()->GetGlobalBool("select_prediction_schemes_by_trial",
+                                        false);
 
   prediction_scheme_ = CreateIntPredictionScheme(prediction_scheme_method);
 
-  if (prediction_scheme_ && !InitPredictionScheme(prediction_scheme_.get())) {
+  // When the scheme is selected by trial encoding, only the parent attributes
+  // of the selected scheme are marked (see EncodeValues()).
+  if (prediction_scheme_ &&
+      !(select_by_trial ? InitTrialPredictionScheme(prediction_scheme_.get())
+                        : InitPredictionScheme(prediction_scheme_.get()))) {
     prediction_scheme_ = nullptr;
   }
 
+  trial_prediction_schemes_.clear();
+  if (select_by_trial) {
+    // All candidates are created now, because their parent attributes need to
+    // be encoded before this attribute.
+    for (const PredictionSchemeMethod method :
+         GetTrialPredictionMethods(attribute_id, encoder)) {
+      std::unique_ptr<PredictionSchemeTypedEncoderInterface<int32_t>> scheme =
+          CreateIntPredictionScheme(method);
+      if (scheme == nullptr || scheme->GetPredictionMethod() != method)
+        continue;  // The method can't be used for this attribute.
+      if (!InitTrialPredictionScheme(scheme.get()))
+        continue;
+      trial_prediction_schemes_.push_back(std::move(scheme));
+    }
+    if (trial_prediction_schemes_.size() < 2)
+      trial_prediction_schemes_.clear();  // Nothing to select from.
+  }
+
   return true;
 }
 
 bool SequentialIntegerAttributeEncoder::TransformAttributeToPortableFormat(
     const std::vector<PointIndex> &point_ids) {
-  if (encoder()) {
+  // The point to value mapping of the portable attribute is needed only by
+  // the parent attributes (see below). Skipping it for other attributes also
+  // avoids allocating a map of all points when only a subset of points is
+  // encoded.
+  if (encoder() && is_parent_encoder()) {
     if (!PrepareValues(point_ids, encoder()->point_cloud()->num_points()))
       return false;
   } else {
@@ -67,24 +132,8 @@ bool SequentialIntegerAttributeEncoder::TransformAttributeToPortableFormat(
 
   // Update point to attribute mapping with the portable attribute if the
   // attribute is a parent attribute (for now, we can skip it otherwise).
-  if (is_parent_encoder()) {
-    // First create map between original attribute value indices and new ones
-    // (determined by the encoding order).
-    const PointAttribute *const orig_att = attribute();
-    PointAttribute *const portable_att = portable_attribute();
-    IndexTypeVector<AttributeValueIndex, AttributeValueIndex>
-        value_to_value_map(orig_att->size());
-    for (int i = 0; i < point_ids.size(); ++i) {
-      value_to_value_map[orig_att->mapped_index(point_ids[i])] =
-          AttributeValueIndex(i);
-    }
-    // Go over all points of the original attribute and update the mapping in
-    // the portable attribute.
-    for (PointIndex i(0); i < encoder()->point_cloud()->num_points(); ++i) {
-      portable_att->SetPointMapEntry(
-          i, value_to_value_map[orig_att->mapped_index(i)]);
-    }
-  }
+  if (is_parent_encoder())
+    SetPortableAttributePointMapping(point_ids, portable_attribute());
   return true;
 }
 
@@ -96,6 +145,84 @@ SequentialIntegerAttributeEncoder::CreateIntPredictionScheme(
       method, attribute_id(), encoder());
 }
 
+bool SequentialIntegerAttributeEncoder::SelectPredictionSchemeByTrial(
+    const std::vector<PointIndex> &point_ids,
+    std::vector<int32_t> *out_symbols) {
+  const int num_components = portable_attribute()->num_components();
+  const int num_values =
+      static_cast<int>(num_components * portable_attribute()->size());
+  const int32_t *const portable_attribute_data = GetPortableAttributeData();
+
+  // Parent attributes are set on the calling thread, because getting the
+  // portable parent attribute may update its state. The parents are not
+  // marked yet, so the candidates use copies of the parent attributes with the
+  // point mapping they need.
+  const int num_trials = static_cast<int>(trial_prediction_schemes_.size());
+  std::vector<bool> is_trial_valid(num_trials);
+  std::vector<std::unique_ptr<PointAttribute>> mapped_parent_attributes;
+  for (int i = 0; i < num_trials; ++i) {
+    is_trial_valid[i] = SetTrialPredictionSchemeParentAttributes(
+        trial_prediction_schemes_[i].get(), &mapped_parent_attributes);
+  }
+
+  std::vector<std::vector<int32_t>> trial_symbols(num_trials);
+  std::vector<int64_t> trial_num_bits(num_trials, -1);
+  std::vector<std::unique_ptr<EncoderBuffer>> trial_prediction_data(
+      num_trials);
+  {
+    ThreadPool pool(encoder()->options()->GetGlobalInt(
+        "num_prediction_trial_threads", 0));
+    for (int i = 0; i < num_trials; ++i) {
+      if (!is_trial_valid[i])
+        continue;
+      pool.Schedule([&, i]() {
+        PredictionSchemeTypedEncoderInterface<int32_t> *const scheme =
+            trial_prediction_schemes_[i].get();
+        std::vector<int32_t> &symbols = trial_symbols[i];
+        symbols.resize(num_values);
+        if (!scheme->ComputeCorrectionValues(
+                portable_attribute_data, symbols.data(), num_values,
+                num_components, point_ids.data()))
+          return;
+        if (!scheme->AreCorrectionsPositive()) {
+          ConvertSignedIntsToSymbols(
+              symbols.data(), num_values,
+              reinterpret_cast<uint32_t *>(symbols.data()));
+        }
+        // Some schemes can encode their data only once, so the data is kept
+        // for the selected scheme.
+        std::unique_ptr<EncoderBuffer> prediction_data(new EncoderBuffer());
+        if (!scheme->EncodePredictionData(prediction_data.get()))
+          return;
+        trial_num_bits[i] =
+            EstimateNumEncodedBits(
+                reinterpret_cast<const uint32_t *>(symbols.data()),
+                num_values) +
+            8 * static_cast<int64_t>(prediction_data->size());
+        trial_prediction_data[i] = std::move(prediction_data);
+      });
+    }
+    pool.Wait();
+  }
+
+  // Ties are resolved in favor of the earlier candidates, i.e., the default
+  // method of the current encoder options.
+  int best_trial = -1;
+  for (int i = 0; i < num_trials; ++i) {
+    if (trial_num_bits[i] < 0)
+      continue;
+    if (best_trial < 0 || trial_num_bits[i] < trial_num_bits[best_trial])
+      best_trial = i;
+  }
+  if (best_trial >= 0) {
+    prediction_scheme_ = std::move(trial_prediction_schemes_[best_trial]);
+    *out_symbols = std::move(trial_symbols[best_trial]);
+    selected_prediction_data_ = std::move(trial_prediction_data[best_trial]);
+  }
+  trial_prediction_schemes_.clear();
+  return true;
+}
+
 bool SequentialIntegerAttributeEncoder::EncodeValues(
     const std::vector<PointIndex> &point_ids, EncoderBuffer *out_buffer) {
   // Initialize general quantization data.
@@ -103,9 +230,30 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
   if (attrib->size() == 0)
     return true;
 
+  const bool use_built_in_attribute_compression =
+      encoder() == nullptr || encoder()->options()->GetGlobalBool(
+                                  "use_built_in_attribute_compression", true);
+
+  // We need to keep the portable data intact, but several encoding steps can
+  // result in changes of this data, e.g., by applying prediction schemes that
+  // change the data in place. To preserve the portable data we store and
+  // process all encoded data in a separate array.
+  std::vector<int32_t> encoded_data;
+  if (!trial_prediction_schemes_.empty()) {
+    // The size estimates of the trials are valid only for the built-in
+    // entropy coding.
+    if (use_built_in_attribute_compression &&
+        !SelectPredictionSchemeByTrial(point_ids, &encoded_data))
+      return false;
+    trial_prediction_schemes_.clear();
+  }
+
   int8_t prediction_scheme_method = PREDICTION_NONE;
   if (prediction_scheme_) {
-    if (!SetPredictionSchemeParentAttributes(prediction_scheme_.get())) {
+    // The parents of a scheme selected by trial encoding are marked only now.
+    // Parents that are already marked are not affected.
+    if (!MarkPredictionSchemeParentAttributes(prediction_scheme_.get()) ||
+        !SetPredictionSchemeParentAttributes(prediction_scheme_.get())) {
       return false;
     }
     prediction_scheme_method =
@@ -122,35 +270,41 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
       static_cast<int>(num_components * portable_attribute()->size());
   const int32_t *const portable_attribute_data = GetPortableAttributeData();
 
-  // We need to keep the portable data intact, but several encoding steps can
-  // result in changes of this data, e.g., by applying prediction schemes that
-  // change the data in place. To preserve the portable data we store and
-  // process all encoded data in a separate array.
-  std::vector<int32_t> encoded_data(num_values);
+  // The symbols were already computed when the prediction scheme was selected
+  // by trial encoding.
+  if (encoded_data.empty()) {
+    encoded_data.resize(num_values);
 
-  // All integer values are initialized. Process them using the prediction
-  // scheme if we have one.
-  if (prediction_scheme_) {
-    prediction_scheme_->ComputeCorrectionValues(
-        portable_attribute_data, &encoded_data[0], num_values, num_components,
-        point_ids.data());
-  }
+    // All integer values are initialized. Process them using the prediction
+    // scheme if we have one.
+    if (prediction_scheme_) {
+      prediction_scheme_->ComputeCorrectionValues(
+          portable_attribute_data, &encoded_data[0], num_values,
+          num_components, point_ids.data());
+    }
 
-  if (prediction_scheme_ == nullptr ||
-      !prediction_scheme_->AreCorrectionsPositive()) {
-    const int32_t *const input =
-        prediction_scheme_ ? encoded_data.data() : portable_attribute_data;
-    ConvertSignedIntsToSymbols(input, num_values,
-                               reinterpret_cast<uint32_t *>(&encoded_data[0]));
+    if (prediction_scheme_ == nullptr ||
+        !prediction_scheme_->AreCorrectionsPositive()) {
+      const int32_t *const input =
+          prediction_scheme_ ? encoded_data.data() : portable_attribute_data;
+      ConvertSignedIntsToSymbols(
+          input, num_values, reinterpret_cast<uint32_t *>(&encoded_data[0]));
+    }
   }
 
-  if (encoder() == nullptr || encoder()->options()->GetGlobalBool(
-                                  "use_built_in_attribute_compression", true)) {
+  if (use_built_in_attribute_compression) {
     out_buffer->Encode(static_cast<uint8_t>(1));
     Options symbol_encoding_options;
     if (encoder() != nullptr) {
       SetSymbolEncodingCompressionLevel(&symbol_encoding_options,
                                         10 - encoder()->options()->GetSpeed());
+      // Use the faster to decode interleaved coding for high decoding speeds
+      // when the target decoder supports it.
+      if (encoder()->options()->GetDecodingSpeed() >= 8 &&
+          encoder()->options()->IsFeatureSupported(
+              features::kInterleavedSymbolCoding)) {
+        SetSymbolEncodingInterleavedRawCoding(&symbol_encoding_options, true);
+      }
     }
     if (!EncodeSymbols(reinterpret_cast<uint32_t *>(encoded_data.data()),
                        static_cast<int>(point_ids.size()) * num_components,
@@ -185,7 +339,13 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
     }
   }
   if (prediction_scheme_) {
-    prediction_scheme_->EncodePredictionData(out_buffer);
+    if (selected_prediction_data_) {
+      out_buffer->Encode(selected_prediction_data_->data(),
+                         selected_prediction_data_->size());
+      selected_prediction_data_ = nullptr;
+    } else {
+      prediction_scheme_->EncodePredictionData(out_buffer);
+    }
   }
   return true;
 }
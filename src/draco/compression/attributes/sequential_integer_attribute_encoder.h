@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_ATTRIBUTES_SEQUENTIAL_INTEGER_ATTRIBUTE_ENCODER_H_
 #define DRACO_COMPRESSION_ATTRIBUTES_SEQUENTIAL_INTEGER_ATTRIBUTE_ENCODER_H_
 
+#include <vector>
+
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_encoder.h"
 #include "draco/compression/attributes/sequential_attribute_encoder.h"
 
@@ -56,10 +58,26 @@ class SequentialIntegerAttributeEncoder : public SequentialAttributeEncoder {
   }
 
  private:
+  // Computes the corrections of all |trial_prediction_schemes_| and selects
+  // the scheme with the smallest estimated size of the encoded data. The
+  // selected scheme is stored in |prediction_scheme_|, its symbols in
+  // |out_symbols| and its prediction data in |selected_prediction_data_|.
+  // |out_symbols| is left empty when no scheme could be evaluated.
+  bool SelectPredictionSchemeByTrial(const std::vector<PointIndex> &point_ids,
+                                     std::vector<int32_t> *out_symbols);
+
   // Optional prediction scheme can be used to modify the integer values in
   // order to make them easier to compress.
   std::unique_ptr<PredictionSchemeTypedEncoderInterface<int32_t>>
       prediction_scheme_;
+
+  // Candidate prediction schemes that are evaluated by trial encoding when
+  // the "select_prediction_schemes_by_trial" option is enabled.
+  std::vector<std::unique_ptr<PredictionSchemeTypedEncoderInterface<int32_t>>>
+      trial_prediction_schemes_;
+
+  // Prediction data of the scheme selected by trial encoding.
+  std::unique_ptr<EncoderBuffer> selected_prediction_data_;
 };
 
 }  // namespace draco
@@ -68,21 +68,17 @@ bool SequentialNormalAttributeDecoder::StoreValues(uint32_t num_points) {
   // Convert all quantized values back to floats.
   const int num_components = attribute()->num_components();
   const int entry_size = sizeof(float) * num_components;
-  float att_val[3];
-  int quant_val_id = 0;
-  int out_byte_pos = 0;
   const int32_t *const portable_attribute_data = GetPortableAttributeData();
   OctahedronToolBox octahedron_tool_box;
   if (!octahedron_tool_box.SetQuantizationBits(quantization_bits_))
     return false;
-  for (uint32_t i = 0; i < num_points; ++i) {
-    const int32_t s = portable_attribute_data[quant_val_id++];
-    const int32_t t = portable_attribute_data[quant_val_id++];
-    octahedron_tool_box.QuantizedOctaherdalCoordsToUnitVector(s, t, att_val);
-    // Store the decoded floating point value into the attribute buffer.
-    attribute()->buffer()->Write(out_byte_pos, att_val, entry_size);
-    out_byte_pos += entry_size;
-  }
+  if (num_points == 0)
+    return true;
+  // Store the decoded floating point values directly into the attribute
+  // buffer.
+  octahedron_tool_box.QuantizedOctahedralCoordsToUnitVectors(
+      portable_attribute_data, num_points, attribute()->buffer()->data(),
+      entry_size);
   return true;
 }
 
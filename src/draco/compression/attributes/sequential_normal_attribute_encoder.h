@@ -47,7 +47,7 @@ class SequentialNormalAttributeEncoder
                      int num_points) override;
 
   std::unique_ptr<PredictionSchemeTypedEncoderInterface<int32_t>>
-  CreateIntPredictionScheme(PredictionSchemeMethod /* method */) override {
+  CreateIntPredictionScheme(PredictionSchemeMethod method) override {
     typedef PredictionSchemeNormalOctahedronCanonicalizedEncodingTransform<
         int32_t>
         Transform;
@@ -55,10 +55,15 @@ class SequentialNormalAttributeEncoder
         attribute_id(), "quantization_bits", -1);
     const int32_t max_value = (1 << quantization_bits) - 1;
     const Transform transform(max_value);
-    const PredictionSchemeMethod default_prediction_method =
-        SelectPredictionMethod(attribute_id(), encoder());
-    const int32_t prediction_method = encoder()->options()->GetAttributeInt(
-        attribute_id(), "prediction_scheme", default_prediction_method);
+    // An explicitly requested |method| (e.g., a candidate of the prediction
+    // scheme selection by trial) takes precedence over the options.
+    int32_t prediction_method = method;
+    if (prediction_method == PREDICTION_UNDEFINED) {
+      const PredictionSchemeMethod default_prediction_method =
+          SelectPredictionMethod(attribute_id(), encoder());
+      prediction_method = encoder()->options()->GetAttributeInt(
+          attribute_id(), "prediction_scheme", default_prediction_method);
+    }
 
     if (prediction_method == MESH_PREDICTION_GEOMETRIC_NORMAL) {
       return CreatePredictionSchemeForEncoder<int32_t, Transform>(
@@ -38,7 +38,7 @@ bool SequentialQuantizationAttributeDecoder::DecodeIntegerValues(
     const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
   if (decoder()->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 0) &&
-      !DecodeQuantizedDataInfo())
+      !DecodeQuantizedDataInfo(in_buffer))
     return false;
 #endif
   return SequentialIntegerAttributeDecoder::DecodeIntegerValues(point_ids,
@@ -50,7 +50,7 @@ bool SequentialQuantizationAttributeDecoder::
         const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
   if (decoder()->bitstream_version() >= DRACO_BITSTREAM_VERSION(2, 0)) {
     // Decode quantization data here only for files with bitstream version 2.0+
-    if (!DecodeQuantizedDataInfo())
+    if (!DecodeQuantizedDataInfo(in_buffer))
       return false;
   }
 
@@ -65,17 +65,16 @@ bool SequentialQuantizationAttributeDecoder::StoreValues(uint32_t num_values) {
   return DequantizeValues(num_values);
 }
 
-bool SequentialQuantizationAttributeDecoder::DecodeQuantizedDataInfo() {
+bool SequentialQuantizationAttributeDecoder::DecodeQuantizedDataInfo(
+    DecoderBuffer *in_buffer) {
   const int num_components = attribute()->num_components();
   min_value_ = std::unique_ptr<float[]>(new float[num_components]);
-  if (!decoder()->buffer()->Decode(min_value_.get(),
-                                   sizeof(float) * num_components))
+  if (!in_buffer->Decode(min_value_.get(), sizeof(float) * num_components))
     return false;
-  if (!decoder()->buffer()->Decode(&max_value_dif_))
+  if (!in_buffer->Decode(&max_value_dif_))
     return false;
   uint8_t quantization_bits;
-  if (!decoder()->buffer()->Decode(&quantization_bits) ||
-      quantization_bits > 31)
+  if (!in_buffer->Decode(&quantization_bits) || quantization_bits > 31)
     return false;
   quantization_bits_ = quantization_bits;
   return true;
@@ -0,0 +1,193 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/chunked_mesh_decode.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "draco/draco_features.h"
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/decode.h"
+#include "draco/compression/point_cloud/point_cloud_decoder.h"
+#include "draco/core/thread_pool.h"
+#include "draco/core/varint_decoding.h"
+
+namespace draco {
+
+namespace {
+
+// Merges all decoded |chunks| into |out_mesh|.
+Status MergeMeshChunks(const std::vector<std::unique_ptr<Mesh>> &chunks,
+                       Mesh *out_mesh) {
+  const Mesh &first_chunk = *chunks[0];
+  size_t num_points = 0;
+  size_t num_faces = 0;
+  for (const std::unique_ptr<Mesh> &chunk : chunks) {
+    if (chunk->num_attributes() != first_chunk.num_attributes())
+      return Status(Status::DRACO_ERROR, "Incompatible mesh chunks.");
+    num_points += chunk->num_points();
+    num_faces += chunk->num_faces();
+  }
+
+  // Merge faces.
+  out_mesh->SetNumFaces(num_faces);
+  FaceIndex out_fi(0);
+  uint32_t point_offset = 0;
+  for (const std::unique_ptr<Mesh> &chunk : chunks) {
+    for (FaceIndex fi(0); fi < chunk->num_faces(); ++fi, ++out_fi) {
+      Mesh::Face face = chunk->face(fi);
+      for (int c = 0; c < 3; ++c) {
+        face[c] += point_offset;
+      }
+      out_mesh->SetFace(out_fi, face);
+    }
+    point_offset += chunk->num_points();
+  }
+  out_mesh->set_num_points(static_cast<uint32_t>(num_points));
+
+  // Merge attributes.
+  for (int att_id = 0; att_id < first_chunk.num_attributes(); ++att_id) {
+    const PointAttribute *const first_att = first_chunk.attribute(att_id);
+    const int64_t entry_size =
+        DataTypeLength(first_att->data_type()) * first_att->num_components();
+    size_t num_values = 0;
+    for (const std::unique_ptr<Mesh> &chunk : chunks) {
+      const PointAttribute *const att = chunk->attribute(att_id);
+      if (att->attribute_type() != first_att->attribute_type() ||
+          att->data_type() != first_att->data_type() ||
+          att->num_components() != first_att->num_components())
+        return Status(Status::DRACO_ERROR, "Incompatible mesh chunks.");
+      num_values += att->size();
+    }
+    GeometryAttribute ga;
+    ga.Init(first_att->attribute_type(), nullptr, first_att->num_components(),
+            first_att->data_type(), first_att->normalized(), entry_size, 0);
+    std::unique_ptr<PointAttribute> out_att(new PointAttribute(ga));
+    out_att->Reset(num_values);
+    out_att->SetExplicitMapping(num_points);
+    uint32_t value_offset = 0;
+    PointIndex out_pi(0);
+    for (const std::unique_ptr<Mesh> &chunk : chunks) {
+      const PointAttribute *const att = chunk->attribute(att_id);
+      for (AttributeValueIndex avi(0); avi < static_cast<uint32_t>(att->size());
+           ++avi) {
+        out_att->buffer()->Write((value_offset + avi.value()) * entry_size,
+                                 att->GetAddress(avi), entry_size);
+      }
+      for (PointIndex pi(0); pi < chunk->num_points(); ++pi, ++out_pi) {
+        out_att->SetPointMapEntry(
+            out_pi, AttributeValueIndex(value_offset +
+                                        att->mapped_index(pi).value()));
+      }
+      value_offset += static_cast<uint32_t>(att->size());
+    }
+    out_att->set_unique_id(first_att->unique_id());
+    if (first_att->GetAttributeTransformData()) {
+      // All chunks share the same transform parameters (e.g. the quantization
+      // grid) so the transform data of the first chunk is valid for all values.
+      out_att->SetAttributeTransformData(
+          std::unique_ptr<AttributeTransformData>(new AttributeTransformData(
+              *first_att->GetAttributeTransformData())));
+    }
+    const int out_att_id = out_mesh->AddAttribute(std::move(out_att));
+    out_mesh->SetAttributeElementType(
+        out_att_id, first_chunk.GetAttributeElementType(att_id));
+  }
+  if (first_chunk.GetMetadata()) {
+    out_mesh->AddMetadata(std::unique_ptr<GeometryMetadata>(
+        new GeometryMetadata(*first_chunk.GetMetadata())));
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+Status DecodeChunkedMesh(const DecoderOptions &options,
+                         DecoderBuffer *in_buffer, Mesh *out_mesh) {
+  DracoHeader header;
+  DRACO_RETURN_IF_ERROR(PointCloudDecoder::DecodeHeader(in_buffer, &header));
+  if (header.encoder_type != TRIANGULAR_MESH ||
+      header.encoder_method != MESH_CHUNKED_ENCODING)
+    return Status(Status::DRACO_ERROR, "Input is not a chunked mesh.");
+
+  // Decode the chunk offset table.
+  uint32_t num_chunks = 0;
+  if (!DecodeVarint(&num_chunks, in_buffer) || num_chunks == 0)
+    return Status(Status::DRACO_ERROR, "Failed to decode number of chunks.");
+  // Each chunk takes at least one byte in the offset table.
+  if (num_chunks > in_buffer->remaining_size())
+    return Status(Status::DRACO_ERROR, "Invalid number of chunks.");
+  std::vector<DecoderBuffer> chunk_buffers(num_chunks);
+  std::vector<uint64_t> chunk_sizes(num_chunks);
+  for (uint32_t i = 0; i < num_chunks; ++i) {
+    if (!DecodeVarint(&chunk_sizes[i], in_buffer))
+      return Status(Status::DRACO_ERROR, "Failed to decode chunk size.");
+  }
+  for (uint32_t i = 0; i < num_chunks; ++i) {
+    if (chunk_sizes[i] > static_cast<uint64_t>(in_buffer->remaining_size()))
+      return Status(Status::DRACO_ERROR, "Invalid chunk size.");
+    chunk_buffers[i].Init(in_buffer->data_head(), chunk_sizes[i]);
+    in_buffer->Advance(chunk_sizes[i]);
+
+    // Chunks must be regular (not chunked) meshes.
+    DecoderBuffer temp_buffer(chunk_buffers[i]);
+    DracoHeader chunk_header;
+    DRACO_RETURN_IF_ERROR(
+        PointCloudDecoder::DecodeHeader(&temp_buffer, &chunk_header));
+    if (chunk_header.encoder_type != TRIANGULAR_MESH ||
+        chunk_header.encoder_method == MESH_CHUNKED_ENCODING)
+      return Status(Status::DRACO_ERROR, "Invalid mesh chunk.");
+  }
+
+  // Decode all chunks.
+  std::vector<std::unique_ptr<Mesh>> chunks(num_chunks);
+  std::vector<Status> chunk_statuses(num_chunks);
+  {
+    const int num_threads =
+        options.GetGlobalInt("num_chunk_decoding_threads", 0);
+    ThreadPool pool(std::min(num_threads, static_cast<int>(num_chunks)));
+    for (uint32_t i = 0; i < num_chunks; ++i) {
+      pool.Schedule([&, i]() {
+        Decoder decoder;
+        *decoder.options() = options;
+        chunks[i].reset(new Mesh());
+        chunk_statuses[i] =
+            decoder.DecodeBufferToGeometry(&chunk_buffers[i], chunks[i].get());
+      });
+    }
+  }
+  for (const Status &status : chunk_statuses) {
+    DRACO_RETURN_IF_ERROR(status);
+  }
+
+  DRACO_RETURN_IF_ERROR(MergeMeshChunks(chunks, out_mesh));
+  // Points can be stitched only using their attribute values.
+  if (options.GetGlobalBool("stitch_mesh_chunks", false) &&
+      !options.GetGlobalBool("decode_connectivity_only", false)) {
+#if defined(DRACO_ATTRIBUTE_VALUES_DEDUPLICATION_SUPPORTED) && \
+    defined(DRACO_ATTRIBUTE_INDICES_DEDUPLICATION_SUPPORTED)
+    if (!out_mesh->DeduplicateAttributeValues())
+      return Status(Status::DRACO_ERROR, "Failed to stitch mesh chunks.");
+    out_mesh->DeduplicatePointIds();
+#else
+    return Status(Status::DRACO_ERROR,
+                  "Stitching of mesh chunks is not supported in this build.");
+#endif
+  }
+  return OkStatus();
+}
+
+}  // namespace draco
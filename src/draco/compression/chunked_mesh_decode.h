@@ -0,0 +1,37 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_CHUNKED_MESH_DECODE_H_
+#define DRACO_COMPRESSION_CHUNKED_MESH_DECODE_H_
+
+#include "draco/compression/config/decoder_options.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Decodes a mesh encoded with MESH_CHUNKED_ENCODING (see
+// chunked_mesh_encode.h) from |in_buffer| into |out_mesh|. The chunks are
+// decoded on "num_chunk_decoding_threads" worker threads and merged into a
+// single mesh in the order in which they were encoded. Vertices on the chunk
+// boundaries are duplicated in the merged mesh unless the "stitch_mesh_chunks"
+// option is set, in which case all points with equal attribute values are
+// merged after decoding.
+Status DecodeChunkedMesh(const DecoderOptions &options,
+                         DecoderBuffer *in_buffer, Mesh *out_mesh);
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_CHUNKED_MESH_DECODE_H_
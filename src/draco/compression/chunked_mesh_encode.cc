@@ -0,0 +1,384 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/chunked_mesh_encode.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "draco/attributes/attribute_quantization_transform.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/expert_encode.h"
+#include "draco/core/thread_pool.h"
+#include "draco/core/varint_encoding.h"
+
+namespace draco {
+
+namespace {
+
+// Number of bits used for each coordinate of the Morton codes.
+constexpr int kMortonCoordinateBits = 10;
+
+// Inserts two zero bits between each of the lowest 10 bits of |v|.
+uint32_t SpreadMortonBits(uint32_t v) {
+  v &= (1u << kMortonCoordinateBits) - 1;
+  v = (v | (v << 16)) & 0x030000ff;
+  v = (v | (v << 8)) & 0x0300f00f;
+  v = (v | (v << 4)) & 0x030c30c3;
+  v = (v | (v << 2)) & 0x09249249;
+  return v;
+}
+
+// Computes Morton codes of centroids of all faces of the |mesh|.
+std::vector<uint32_t> ComputeFaceMortonCodes(const Mesh &mesh,
+                                             const PointAttribute &pos_att) {
+  const int num_components = std::min(3, int(pos_att.num_components()));
+  float min_pos[3] = {0.f, 0.f, 0.f};
+  float max_pos[3] = {0.f, 0.f, 0.f};
+  for (int c = 0; c < num_components; ++c) {
+    min_pos[c] = std::numeric_limits<float>::max();
+    max_pos[c] = std::numeric_limits<float>::lowest();
+  }
+  float pos[3] = {0.f, 0.f, 0.f};
+  for (AttributeValueIndex avi(0); avi < static_cast<uint32_t>(pos_att.size());
+       ++avi) {
+    pos_att.ConvertValue<float>(avi, num_components, pos);
+    for (int c = 0; c < num_components; ++c) {
+      min_pos[c] = std::min(min_pos[c], pos[c]);
+      max_pos[c] = std::max(max_pos[c], pos[c]);
+    }
+  }
+  // Scale factors mapping the centroids to the Morton grid. Note that the sum
+  // of the three corner positions is used instead of the actual centroid.
+  constexpr float kMaxGridValue = (1 << kMortonCoordinateBits) - 1;
+  float scale[3] = {0.f, 0.f, 0.f};
+  for (int c = 0; c < num_components; ++c) {
+    const float range = max_pos[c] - min_pos[c];
+    if (range > 0.f)
+      scale[c] = kMaxGridValue / (3.f * range);
+  }
+
+  std::vector<uint32_t> codes(mesh.num_faces());
+  for (FaceIndex fi(0); fi < mesh.num_faces(); ++fi) {
+    const Mesh::Face &face = mesh.face(fi);
+    float sum[3] = {0.f, 0.f, 0.f};
+    for (int i = 0; i < 3; ++i) {
+      pos_att.ConvertValue<float>(pos_att.mapped_index(face[i]),
+                                  num_components, pos);
+      for (int c = 0; c < num_components; ++c) {
+        sum[c] += pos[c] - min_pos[c];
+      }
+    }
+    uint32_t code = 0;
+    for (int c = 0; c < num_components; ++c) {
+      const float grid_value =
+          std::min(std::max(sum[c] * scale[c], 0.f), kMaxGridValue);
+      code |= SpreadMortonBits(static_cast<uint32_t>(grid_value)) << c;
+    }
+    codes[fi.value()] = code;
+  }
+  return codes;
+}
+
+// Creates a new mesh from faces |faces[0..num_faces-1]| of the input |mesh|.
+// Only points and attribute values used by the faces are copied.
+std::unique_ptr<Mesh> ExtractMeshChunk(const Mesh &mesh, const FaceIndex *faces,
+                                       int num_faces) {
+  std::unique_ptr<Mesh> chunk(new Mesh());
+  // Collect all points of the chunk. New point ids are given by the position
+  // of the original point ids in the sorted |points| array.
+  std::vector<PointIndex> points;
+  points.reserve(3 * num_faces);
+  for (int i = 0; i < num_faces; ++i) {
+    const Mesh::Face &face = mesh.face(faces[i]);
+    points.insert(points.end(), face.begin(), face.end());
+  }
+  std::sort(points.begin(), points.end());
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+  const auto new_point_id = [&points](PointIndex pi) {
+    return PointIndex(static_cast<uint32_t>(
+        std::lower_bound(points.begin(), points.end(), pi) - points.begin()));
+  };
+
+  chunk->SetNumFaces(num_faces);
+  for (int i = 0; i < num_faces; ++i) {
+    const Mesh::Face &face = mesh.face(faces[i]);
+    Mesh::Face new_face;
+    for (int c = 0; c < 3; ++c) {
+      new_face[c] = new_point_id(face[c]);
+    }
+    chunk->SetFace(FaceIndex(i), new_face);
+  }
+  chunk->set_num_points(static_cast<uint32_t>(points.size()));
+
+  for (int att_id = 0; att_id < mesh.num_attributes(); ++att_id) {
+    const PointAttribute *const att = mesh.attribute(att_id);
+    // Collect all attribute values used by the points of the chunk.
+    std::vector<AttributeValueIndex> values(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      values[i] = att->mapped_index(points[i]);
+    }
+    std::vector<AttributeValueIndex> unique_values = values;
+    std::sort(unique_values.begin(), unique_values.end());
+    unique_values.erase(std::unique(unique_values.begin(), unique_values.end()),
+                        unique_values.end());
+
+    GeometryAttribute ga;
+    ga.Init(att->attribute_type(), nullptr, att->num_components(),
+            att->data_type(), att->normalized(),
+            DataTypeLength(att->data_type()) * att->num_components(), 0);
+    std::unique_ptr<PointAttribute> chunk_att(new PointAttribute(ga));
+    chunk_att->Reset(unique_values.size());
+    for (size_t i = 0; i < unique_values.size(); ++i) {
+      chunk_att->SetAttributeValue(AttributeValueIndex(static_cast<uint32_t>(i)),
+                                   att->GetAddress(unique_values[i]));
+    }
+    if (att->is_mapping_identity()) {
+      // Points and values are sorted in the same order.
+      chunk_att->SetIdentityMapping();
+    } else {
+      chunk_att->SetExplicitMapping(points.size());
+      for (size_t i = 0; i < points.size(); ++i) {
+        const AttributeValueIndex avi(static_cast<uint32_t>(
+            std::lower_bound(unique_values.begin(), unique_values.end(),
+                             values[i]) -
+            unique_values.begin()));
+        chunk_att->SetPointMapEntry(PointIndex(static_cast<uint32_t>(i)), avi);
+      }
+    }
+    const int chunk_att_id = chunk->AddAttribute(std::move(chunk_att));
+    chunk->attribute(chunk_att_id)->set_unique_id(att->unique_id());
+    chunk->SetAttributeElementType(chunk_att_id,
+                                   mesh.GetAttributeElementType(att_id));
+  }
+  return chunk;
+}
+
+// Returns the root of the set containing |i| in the union-find |parents|
+// array. The paths to the root are halved along the way.
+uint32_t FindComponentRoot(std::vector<uint32_t> *parents, uint32_t i) {
+  while ((*parents)[i] != i) {
+    (*parents)[i] = (*parents)[(*parents)[i]];
+    i = (*parents)[i];
+  }
+  return i;
+}
+
+}  // namespace
+
+std::vector<std::unique_ptr<Mesh>> SplitMeshIntoChunks(const Mesh &mesh,
+                                                       int num_chunks) {
+  std::vector<std::unique_ptr<Mesh>> chunks;
+  const PointAttribute *const pos_att =
+      mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+  if (pos_att == nullptr || num_chunks <= 0 || mesh.num_faces() == 0)
+    return chunks;
+  num_chunks = std::min(num_chunks, static_cast<int>(mesh.num_faces()));
+
+  // Order faces along the Morton curve.
+  const std::vector<uint32_t> codes = ComputeFaceMortonCodes(mesh, *pos_att);
+  std::vector<FaceIndex> faces(mesh.num_faces());
+  for (FaceIndex fi(0); fi < mesh.num_faces(); ++fi) {
+    faces[fi.value()] = fi;
+  }
+  std::stable_sort(faces.begin(), faces.end(),
+                   [&codes](FaceIndex a, FaceIndex b) {
+                     return codes[a.value()] < codes[b.value()];
+                   });
+
+  chunks.resize(num_chunks);
+  const size_t num_faces = faces.size();
+  for (int i = 0; i < num_chunks; ++i) {
+    const size_t begin = num_faces * i / num_chunks;
+    const size_t end = num_faces * (i + 1) / num_chunks;
+    chunks[i] = ExtractMeshChunk(mesh, faces.data() + begin,
+                                 static_cast<int>(end - begin));
+  }
+  if (mesh.GetMetadata()) {
+    chunks[0]->AddMetadata(std::unique_ptr<GeometryMetadata>(
+        new GeometryMetadata(*mesh.GetMetadata())));
+  }
+  return chunks;
+}
+
+std::vector<std::unique_ptr<Mesh>> SplitMeshIntoComponentChunks(
+    const Mesh &mesh, int num_chunks) {
+  std::vector<std::unique_ptr<Mesh>> chunks;
+  const PointAttribute *const pos_att =
+      mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+  if (pos_att == nullptr || num_chunks <= 0 || mesh.num_faces() == 0)
+    return chunks;
+
+  // Find connected components of faces. Faces are connected when they share
+  // a position value so that points split on attribute seams always end up
+  // in the same chunk.
+  std::vector<uint32_t> parents(pos_att->size());
+  for (uint32_t i = 0; i < parents.size(); ++i) {
+    parents[i] = i;
+  }
+  for (FaceIndex fi(0); fi < mesh.num_faces(); ++fi) {
+    const Mesh::Face &face = mesh.face(fi);
+    const uint32_t root =
+        FindComponentRoot(&parents, pos_att->mapped_index(face[0]).value());
+    for (int c = 1; c < 3; ++c) {
+      parents[FindComponentRoot(&parents,
+                                pos_att->mapped_index(face[c]).value())] =
+          root;
+    }
+  }
+
+  // Number the components in the order of their first face and sort the
+  // faces by their components.
+  std::vector<int> root_to_component(parents.size(), -1);
+  std::vector<int> face_components(mesh.num_faces());
+  std::vector<uint32_t> component_sizes;
+  for (FaceIndex fi(0); fi < mesh.num_faces(); ++fi) {
+    const uint32_t root = FindComponentRoot(
+        &parents, pos_att->mapped_index(mesh.face(fi)[0]).value());
+    if (root_to_component[root] < 0) {
+      root_to_component[root] = static_cast<int>(component_sizes.size());
+      component_sizes.push_back(0);
+    }
+    face_components[fi.value()] = root_to_component[root];
+    component_sizes[root_to_component[root]]++;
+  }
+  const int num_components = static_cast<int>(component_sizes.size());
+  std::vector<uint32_t> component_offsets(num_components + 1, 0);
+  for (int i = 0; i < num_components; ++i) {
+    component_offsets[i + 1] = component_offsets[i] + component_sizes[i];
+  }
+  std::vector<FaceIndex> faces(mesh.num_faces());
+  {
+    std::vector<uint32_t> next_offsets(component_offsets.begin(),
+                                       component_offsets.end() - 1);
+    for (FaceIndex fi(0); fi < mesh.num_faces(); ++fi) {
+      faces[next_offsets[face_components[fi.value()]]++] = fi;
+    }
+  }
+
+  // Assign consecutive components to chunks so that the chunks have roughly
+  // the same number of faces. A chunk is closed once it reaches its share of
+  // faces or when the remaining components are needed for the remaining
+  // chunks.
+  num_chunks = std::min(num_chunks, num_components);
+  const size_t num_faces = faces.size();
+  uint32_t chunk_begin = 0;
+  for (int i = 0; i < num_components; ++i) {
+    const uint32_t chunk_end = component_offsets[i + 1];
+    const int num_open_chunks = num_chunks - static_cast<int>(chunks.size());
+    const size_t target_end = num_faces * (chunks.size() + 1) / num_chunks;
+    if (chunk_end < target_end && num_components - i - 1 >= num_open_chunks)
+      continue;
+    chunks.push_back(ExtractMeshChunk(mesh, faces.data() + chunk_begin,
+                                      static_cast<int>(chunk_end -
+                                                       chunk_begin)));
+    chunk_begin = chunk_end;
+  }
+  if (mesh.GetMetadata()) {
+    chunks[0]->AddMetadata(std::unique_ptr<GeometryMetadata>(
+        new GeometryMetadata(*mesh.GetMetadata())));
+  }
+  return chunks;
+}
+
+Status EncodeMeshInChunks(const Mesh &mesh, const EncoderOptions &options,
+                          EncoderBuffer *out_buffer,
+                          size_t *out_num_encoded_points,
+                          size_t *out_num_encoded_faces) {
+  const int num_chunks = options.GetGlobalInt("num_encoding_chunks", 1);
+  const std::vector<std::unique_ptr<Mesh>> chunks =
+      options.GetGlobalBool("split_mesh_chunks_on_components", false)
+          ? SplitMeshIntoComponentChunks(mesh, num_chunks)
+          : SplitMeshIntoChunks(mesh, num_chunks);
+  if (chunks.empty())
+    return Status(Status::DRACO_ERROR, "Failed to split mesh into chunks.");
+
+  // Options used to encode each chunk.
+  EncoderOptions chunk_options = options;
+  chunk_options.SetGlobalInt("num_encoding_chunks", 1);
+  // Chunks are already encoded in parallel.
+  chunk_options.SetGlobalInt("num_encoding_threads", 0);
+  // Use the same quantization grid for all chunks.
+  for (int att_id = 0; att_id < mesh.num_attributes(); ++att_id) {
+    const PointAttribute *const att = mesh.attribute(att_id);
+    const int quantization_bits =
+        options.GetAttributeInt(att_id, "quantization_bits", -1);
+    if (att->data_type() != DT_FLOAT32 || quantization_bits <= 0 ||
+        att->size() == 0)
+      continue;
+    if (options.IsAttributeOptionSet(att_id, "quantization_origin") &&
+        options.IsAttributeOptionSet(att_id, "quantization_range"))
+      continue;  // Explicit quantization was already set by the user.
+    AttributeQuantizationTransform transform;
+    if (!transform.ComputeParameters(*att, quantization_bits))
+      return Status(Status::DRACO_ERROR, "Failed to compute quantization.");
+    chunk_options.SetAttributeVector(att_id, "quantization_origin",
+                                     att->num_components(),
+                                     transform.min_values().data());
+    chunk_options.SetAttributeFloat(att_id, "quantization_range",
+                                    transform.range());
+  }
+
+  // Encode all chunks.
+  std::vector<EncoderBuffer> chunk_buffers(chunks.size());
+  std::vector<Status> chunk_statuses(chunks.size());
+  std::vector<size_t> chunk_num_points(chunks.size(), 0);
+  std::vector<size_t> chunk_num_faces(chunks.size(), 0);
+  {
+    const int num_threads = options.GetGlobalInt("num_encoding_threads", 0);
+    ThreadPool pool(std::min(num_threads, static_cast<int>(chunks.size())));
+    for (size_t i = 0; i < chunks.size(); ++i) {
+      pool.Schedule([&, i]() {
+        ExpertEncoder encoder(*chunks[i]);
+        encoder.Reset(chunk_options);
+        chunk_statuses[i] = encoder.EncodeToBuffer(&chunk_buffers[i]);
+        chunk_num_points[i] = encoder.num_encoded_points();
+        chunk_num_faces[i] = encoder.num_encoded_faces();
+      });
+    }
+  }
+  for (const Status &status : chunk_statuses) {
+    DRACO_RETURN_IF_ERROR(status);
+  }
+
+  // Encode the header.
+  out_buffer->Encode("DRACO", 5);
+  out_buffer->Encode(static_cast<uint8_t>(kDracoMeshBitstreamVersionMajor));
+  out_buffer->Encode(
+      static_cast<uint8_t>(kDracoMeshDefaultBitstreamVersionMinor));
+  out_buffer->Encode(static_cast<uint8_t>(TRIANGULAR_MESH));
+  out_buffer->Encode(static_cast<uint8_t>(MESH_CHUNKED_ENCODING));
+  // Metadata is stored in the first chunk so no flags are set.
+  out_buffer->Encode(static_cast<uint16_t>(0));
+
+  // Encode the chunk offset table followed by the chunk data.
+  EncodeVarint(static_cast<uint32_t>(chunks.size()), out_buffer);
+  for (const EncoderBuffer &chunk_buffer : chunk_buffers) {
+    EncodeVarint(static_cast<uint64_t>(chunk_buffer.size()), out_buffer);
+  }
+  size_t num_encoded_points = 0;
+  size_t num_encoded_faces = 0;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    out_buffer->Encode(chunk_buffers[i].data(), chunk_buffers[i].size());
+    num_encoded_points += chunk_num_points[i];
+    num_encoded_faces += chunk_num_faces[i];
+  }
+  if (out_num_encoded_points)
+    *out_num_encoded_points = num_encoded_points;
+  if (out_num_encoded_faces)
+    *out_num_encoded_faces = num_encoded_faces;
+  return OkStatus();
+}
+
+}  // namespace draco
@@ -0,0 +1,81 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_CHUNKED_MESH_ENCODE_H_
+#define DRACO_COMPRESSION_CHUNKED_MESH_ENCODE_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/config/encoder_options.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Chunked mesh encoding splits the input mesh into spatially coherent chunks
+// of faces that are encoded independently of each other. The chunks can be
+// encoded and decoded on multiple threads at the cost of a slightly lower
+// compression rate (connectivity and predictions do not cross the chunk
+// boundaries and vertices on the boundaries are encoded in each chunk).
+//
+// The encoded data starts with a standard Draco header with encoder method
+// set to MESH_CHUNKED_ENCODING, followed by:
+//
+//   varint         num_chunks
+//   varint[]       encoded size of each chunk (chunk offset table)
+//   chunk data     each chunk is a complete Draco mesh bitstream
+//
+// Geometry metadata is stored in the first chunk.
+
+// Splits |mesh| into |num_chunks| chunks with approximately the same number of
+// faces. Faces are grouped by the position of their centroid along a Morton
+// (Z-order) curve so that each chunk covers a compact region of the mesh.
+// Attribute ids, unique ids and attribute element types are preserved in all
+// chunks. Returns an empty vector when the mesh cannot be split.
+std::vector<std::unique_ptr<Mesh>> SplitMeshIntoChunks(const Mesh &mesh,
+                                                       int num_chunks);
+
+// Splits |mesh| into at most |num_chunks| chunks such that each connected
+// component of the mesh is stored in exactly one chunk. Faces sharing a
+// position value belong to the same component, therefore no vertex is
+// encoded in more than one chunk and the decoded chunks do not need to be
+// stitched. Consecutive components are grouped into chunks with
+// approximately the same number of faces. The number of chunks is limited by
+// the number of components. Returns an empty vector when the mesh cannot be
+// split.
+std::vector<std::unique_ptr<Mesh>> SplitMeshIntoComponentChunks(
+    const Mesh &mesh, int num_chunks);
+
+// Encodes |mesh| into |out_buffer| as a set of independent chunks using the
+// encoder |options| (expected to be specific to each attribute id of the
+// |mesh|). The number of chunks is given by the "num_encoding_chunks" global
+// option and the chunks are encoded on "num_encoding_threads" worker threads.
+// The mesh is split with SplitMeshIntoComponentChunks() when the
+// "split_mesh_chunks_on_components" global option is set and with
+// SplitMeshIntoChunks() otherwise.
+// Quantized attributes use the same quantization grid in all chunks so that
+// vertices shared by multiple chunks decode to the same values.
+// The total number of encoded points and faces is returned in
+// |out_num_encoded_points| and |out_num_encoded_faces| when the encoded
+// properties are tracked.
+Status EncodeMeshInChunks(const Mesh &mesh, const EncoderOptions &options,
+                          EncoderBuffer *out_buffer,
+                          size_t *out_num_encoded_points,
+                          size_t *out_num_encoded_faces);
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_CHUNKED_MESH_ENCODE_H_
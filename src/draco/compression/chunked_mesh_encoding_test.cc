@@ -0,0 +1,256 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cstring>
+
+#include "draco/draco_features.h"
+
+#include "draco/compression/chunked_mesh_encode.h"
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace {
+
+#if defined(DRACO_ATTRIBUTE_VALUES_DEDUPLICATION_SUPPORTED) && \
+    defined(DRACO_ATTRIBUTE_INDICES_DEDUPLICATION_SUPPORTED)
+constexpr bool kStitchingSupported = true;
+#else
+constexpr bool kStitchingSupported = false;
+#endif
+
+class ChunkedMeshEncodingTest : public ::testing::Test {
+ protected:
+  void EncodeMesh(const draco::Mesh &mesh, int num_chunks, int num_threads,
+                  draco::EncoderBuffer *buffer) {
+    draco::Encoder encoder;
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+    encoder.SetMeshChunking(num_chunks, num_threads);
+    ASSERT_TRUE(encoder.EncodeMeshToBuffer(mesh, buffer).ok());
+  }
+
+  std::unique_ptr<draco::Mesh> DecodeMesh(const draco::EncoderBuffer &buffer,
+                                          int num_threads, bool stitch) {
+    draco::DecoderBuffer in_buffer;
+    in_buffer.Init(buffer.data(), buffer.size());
+    draco::Decoder decoder;
+    decoder.SetNumChunkDecodingThreads(num_threads);
+    decoder.SetStitchMeshChunks(stitch);
+    auto status_or = decoder.DecodeMeshFromBuffer(&in_buffer);
+    if (!status_or.ok())
+      return nullptr;
+    return std::move(status_or).value();
+  }
+
+  // Creates a mesh made of |num_components| disconnected strips of quads.
+  // Strip i contains i + 1 quads. The strips are stored in every other row of
+  // the grid so that they do not touch each other.
+  std::unique_ptr<draco::Mesh> CreateStripsMesh(int num_components) {
+    return draco::CreateQuadGridMesh(
+        num_components, 2 * num_components,
+        [](int x, int y) { return y % 2 == 0 && x <= y / 2; });
+  }
+
+  // Returns true when both meshes have the same faces and attribute values.
+  bool AreMeshesEqual(const draco::Mesh &mesh_0, const draco::Mesh &mesh_1) {
+    if (mesh_0.num_faces() != mesh_1.num_faces() ||
+        mesh_0.num_points() != mesh_1.num_points() ||
+        mesh_0.num_attributes() != mesh_1.num_attributes())
+      return false;
+    for (draco::FaceIndex fi(0); fi < mesh_0.num_faces(); ++fi) {
+      if (mesh_0.face(fi) != mesh_1.face(fi))
+        return false;
+    }
+    for (int i = 0; i < mesh_0.num_attributes(); ++i) {
+      const draco::PointAttribute *const att_0 = mesh_0.attribute(i);
+      const draco::PointAttribute *const att_1 = mesh_1.attribute(i);
+      if (att_0->byte_stride() != att_1->byte_stride())
+        return false;
+      for (draco::PointIndex pi(0); pi < mesh_0.num_points(); ++pi) {
+        if (std::memcmp(att_0->GetAddress(att_0->mapped_index(pi)),
+                        att_1->GetAddress(att_1->mapped_index(pi)),
+                        att_0->byte_stride()) != 0)
+          return false;
+      }
+    }
+    return true;
+  }
+};
+
+TEST_F(ChunkedMeshEncodingTest, TestSplitMesh) {
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  const std::vector<std::unique_ptr<draco::Mesh>> chunks =
+      draco::SplitMeshIntoChunks(*mesh, 5);
+  ASSERT_EQ(chunks.size(), 5);
+  size_t num_faces = 0;
+  for (const auto &chunk : chunks) {
+    ASSERT_EQ(chunk->num_attributes(), mesh->num_attributes());
+    for (int i = 0; i < mesh->num_attributes(); ++i) {
+      ASSERT_EQ(chunk->attribute(i)->attribute_type(),
+                mesh->attribute(i)->attribute_type());
+      ASSERT_EQ(chunk->attribute(i)->unique_id(),
+                mesh->attribute(i)->unique_id());
+    }
+    // Chunks should have roughly the same number of faces.
+    ASSERT_LE(chunk->num_faces(), mesh->num_faces() / 5 + 1);
+    ASSERT_LE(chunk->num_points(), 3 * chunk->num_faces());
+    num_faces += chunk->num_faces();
+  }
+  ASSERT_EQ(num_faces, mesh->num_faces());
+
+  // The number of chunks is limited by the number of faces.
+  ASSERT_EQ(draco::SplitMeshIntoChunks(*mesh, 1 << 30).size(),
+            mesh->num_faces());
+}
+
+TEST_F(ChunkedMeshEncodingTest, TestRoundTrip) {
+  for (const std::string file_name : {"cube_att.obj", "test_nm.obj"}) {
+    const std::unique_ptr<draco::Mesh> mesh =
+        draco::ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    std::unique_ptr<draco::GeometryMetadata> metadata(
+        new draco::GeometryMetadata());
+    metadata->AddEntryString("name", file_name);
+    mesh->AddMetadata(std::move(metadata));
+
+    // Reference mesh encoded without chunking.
+    draco::EncoderBuffer ref_buffer;
+    EncodeMesh(*mesh, 1, 0, &ref_buffer);
+    std::unique_ptr<draco::Mesh> ref_mesh = DecodeMesh(ref_buffer, 0, true);
+    ASSERT_NE(ref_mesh, nullptr);
+    ASSERT_TRUE(ref_mesh->DeduplicateAttributeValues());
+    ref_mesh->DeduplicatePointIds();
+
+    draco::EncoderBuffer buffer;
+    EncodeMesh(*mesh, 4, 0, &buffer);
+    const std::unique_ptr<draco::Mesh> decoded_mesh =
+        DecodeMesh(buffer, 0, false);
+    ASSERT_NE(decoded_mesh, nullptr);
+    ASSERT_EQ(decoded_mesh->num_faces(), mesh->num_faces());
+    ASSERT_EQ(decoded_mesh->num_attributes(), mesh->num_attributes());
+    ASSERT_NE(decoded_mesh->GetMetadata(), nullptr);
+    std::string name;
+    ASSERT_TRUE(decoded_mesh->GetMetadata()->GetEntryString("name", &name));
+    ASSERT_EQ(name, file_name);
+
+    // All chunks share the same quantization grid so stitching should recover
+    // the points of the mesh encoded without chunking.
+    const std::unique_ptr<draco::Mesh> stitched_mesh =
+        DecodeMesh(buffer, 0, true);
+    if (!kStitchingSupported) {
+      // Stitching that is compiled out must not be silently skipped.
+      ASSERT_EQ(stitched_mesh, nullptr);
+      continue;
+    }
+    ASSERT_NE(stitched_mesh, nullptr);
+    ASSERT_EQ(stitched_mesh->num_faces(), mesh->num_faces());
+    ASSERT_EQ(stitched_mesh->num_points(), ref_mesh->num_points());
+    ASSERT_LE(stitched_mesh->num_points(), decoded_mesh->num_points());
+  }
+}
+
+TEST_F(ChunkedMeshEncodingTest, TestParallelEncodingAndDecoding) {
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::EncoderBuffer buffer;
+  EncodeMesh(*mesh, 3, 0, &buffer);
+  const std::unique_ptr<draco::Mesh> decoded_mesh = DecodeMesh(buffer, 0, true);
+  ASSERT_NE(decoded_mesh, nullptr);
+  for (const int num_threads : {1, 4}) {
+    // Encoding on multiple threads must produce the same output.
+    draco::EncoderBuffer buffer_2;
+    EncodeMesh(*mesh, 3, num_threads, &buffer_2);
+    ASSERT_EQ(buffer.size(), buffer_2.size());
+    ASSERT_EQ(std::memcmp(buffer.data(), buffer_2.data(), buffer.size()), 0);
+
+    const std::unique_ptr<draco::Mesh> decoded_mesh_2 =
+        DecodeMesh(buffer, num_threads, true);
+    ASSERT_NE(decoded_mesh_2, nullptr);
+    ASSERT_TRUE(AreMeshesEqual(*decoded_mesh, *decoded_mesh_2));
+  }
+}
+
+TEST_F(ChunkedMeshEncodingTest, TestSplitMeshOnComponents) {
+  const int kNumComponents = 7;
+  const std::unique_ptr<draco::Mesh> mesh = CreateStripsMesh(kNumComponents);
+  ASSERT_NE(mesh, nullptr);
+  const std::vector<std::unique_ptr<draco::Mesh>> chunks =
+      draco::SplitMeshIntoComponentChunks(*mesh, 3);
+  ASSERT_EQ(chunks.size(), 3);
+  size_t num_faces = 0;
+  size_t num_points = 0;
+  for (const auto &chunk : chunks) {
+    ASSERT_GT(chunk->num_faces(), 0);
+    num_faces += chunk->num_faces();
+    num_points += chunk->num_points();
+  }
+  ASSERT_EQ(num_faces, mesh->num_faces());
+  // Components are not split so no point is duplicated between the chunks.
+  ASSERT_EQ(num_points, mesh->num_points());
+
+  // The number of chunks is limited by the number of components.
+  ASSERT_EQ(draco::SplitMeshIntoComponentChunks(*mesh, 100).size(),
+            kNumComponents);
+
+  // Encode the components in parallel and decode them without stitching.
+  draco::EncoderBuffer buffer;
+  for (const int num_threads : {0, 4}) {
+    draco::Encoder encoder;
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+    encoder.SetMeshChunking(4, num_threads);
+    encoder.SetSplitMeshChunksOnComponents(true);
+    draco::EncoderBuffer thread_buffer;
+    ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &thread_buffer).ok());
+    if (num_threads == 0) {
+      buffer.Encode(thread_buffer.data(), thread_buffer.size());
+    } else {
+      ASSERT_EQ(buffer.size(), thread_buffer.size());
+      ASSERT_EQ(
+          std::memcmp(buffer.data(), thread_buffer.data(), buffer.size()), 0);
+    }
+  }
+  const std::unique_ptr<draco::Mesh> decoded_mesh =
+      DecodeMesh(buffer, 4, false);
+  ASSERT_NE(decoded_mesh, nullptr);
+  ASSERT_EQ(decoded_mesh->num_faces(), mesh->num_faces());
+  ASSERT_EQ(decoded_mesh->num_points(), mesh->num_points());
+  const std::unique_ptr<draco::Mesh> stitched_mesh =
+      DecodeMesh(buffer, 4, true);
+  if (!kStitchingSupported) {
+    ASSERT_EQ(stitched_mesh, nullptr);
+    return;
+  }
+  ASSERT_NE(stitched_mesh, nullptr);
+  ASSERT_TRUE(AreMeshesEqual(*decoded_mesh, *stitched_mesh));
+}
+
+TEST_F(ChunkedMeshEncodingTest, TestInvalidData) {
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::EncoderBuffer buffer;
+  EncodeMesh(*mesh, 3, 0, &buffer);
+  // Truncated chunk data must be rejected.
+  draco::EncoderBuffer truncated_buffer;
+  truncated_buffer.Encode(buffer.data(), buffer.size() - 1);
+  ASSERT_EQ(DecodeMesh(truncated_buffer, 0, false), nullptr);
+}
+
+}  // namespace
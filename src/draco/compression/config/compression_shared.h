@@ -27,7 +27,12 @@ namespace draco {
 static constexpr uint8_t kDracoPointCloudBitstreamVersionMajor = 2;
 static constexpr uint8_t kDracoPointCloudBitstreamVersionMinor = 3;
 static constexpr uint8_t kDracoMeshBitstreamVersionMajor = 2;
-static constexpr uint8_t kDracoMeshBitstreamVersionMinor = 2;
+static constexpr uint8_t kDracoMeshBitstreamVersionMinor = 3;
+
+// Minor bit-stream version written by mesh encoders unless the mesh is encoded
+// with features introduced in a later version (such as the block compressed
+// sequential connectivity), so that the mesh can be read by older decoders.
+static constexpr uint8_t kDracoMeshDefaultBitstreamVersionMinor = 2;
 
 // Concatenated latest bit-stream version.
 static constexpr uint16_t kDracoPointCloudBitstreamVersion =
@@ -55,6 +60,10 @@ enum PointCloudEncodingMethod {
 enum MeshEncoderMethod {
   MESH_SEQUENTIAL_ENCODING = 0,
   MESH_EDGEBREAKER_ENCODING,
+  // Container of independently encoded mesh chunks. This method is never
+  // selected as the "encoding_method" option. It is enabled by setting the
+  // "num_encoding_chunks" option instead (see chunked_mesh_encode.h).
+  MESH_CHUNKED_ENCODING,
 };
 
 // List of various attribute encoders supported by our framework. The entries
@@ -142,6 +151,9 @@ enum NormalPredictionMode {
 enum SymbolCodingMethod {
   SYMBOL_CODING_TAGGED = 0,
   SYMBOL_CODING_RAW = 1,
+  // Same as SYMBOL_CODING_RAW but the symbols are encoded using multiple
+  // interleaved rANS states that can be decoded faster.
+  SYMBOL_CODING_RAW_INTERLEAVED = 2,
   NUM_SYMBOL_CODING_METHODS,
 };
 
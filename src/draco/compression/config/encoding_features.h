@@ -23,6 +23,11 @@
 // kPredictiveEdgebreaker
 //     - advanced version of the edgebreaker method (slower but better
 //       compression).
+// kInterleavedSymbolCoding
+//     - entropy coding of symbols using interleaved rANS states (faster
+//       decoding, slightly worse compression). Used only at high decoding
+//       speeds. Not enabled by default because older decoders do not
+//       support it.
 //
 #ifndef DRACO_COMPRESSION_CONFIG_ENCODING_FEATURES_H_
 #define DRACO_COMPRESSION_CONFIG_ENCODING_FEATURES_H_
@@ -32,6 +37,7 @@ namespace features {
 
 constexpr const char *kEdgebreaker = "standard_edgebreaker";
 constexpr const char *kPredictiveEdgebreaker = "predictive_edgebreaker";
+constexpr const char *kInterleavedSymbolCoding = "interleaved_symbol_coding";
 
 }  // namespace features
 }  // namespace draco
@@ -15,8 +15,10 @@
 #include "draco/compression/decode.h"
 
 #include "draco/compression/config/compression_shared.h"
+#include "draco/compression/decoder_context.h"
 
 #ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+#include "draco/compression/chunked_mesh_decode.h"
 #include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
 #include "draco/compression/mesh/mesh_sequential_decoder.h"
 #endif
@@ -52,6 +54,8 @@ StatusOr<std::unique_ptr<MeshDecoder>> CreateMeshDecoder(uint8_t method) {
 }
 #endif
 
+Decoder::Decoder() : context_(nullptr) {}
+
 StatusOr<EncodedGeometryType> Decoder::GetEncodedGeometryType(
     DecoderBuffer *in_buffer) {
   DecoderBuffer temp_buffer(*in_buffer);
@@ -96,6 +100,12 @@ Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
   if (header.encoder_type != POINT_CLOUD) {
     return Status(Status::DRACO_ERROR, "Input is not a point cloud.");
   }
+  if (context_ != nullptr) {
+    DRACO_ASSIGN_OR_RETURN(
+        PointCloudDecoder *const decoder,
+        context_->GetPointCloudDecoder(header.encoder_method))
+    return decoder->Decode(options_, in_buffer, out_geometry);
+  }
   DRACO_ASSIGN_OR_RETURN(std::unique_ptr<PointCloudDecoder> decoder,
                          CreatePointCloudDecoder(header.encoder_method))
 
@@ -115,6 +125,13 @@ Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
   if (header.encoder_type != TRIANGULAR_MESH) {
     return Status(Status::DRACO_ERROR, "Input is not a mesh.");
   }
+  if (header.encoder_method == MESH_CHUNKED_ENCODING)
+    return DecodeChunkedMesh(options_, in_buffer, out_geometry);
+  if (context_ != nullptr) {
+    DRACO_ASSIGN_OR_RETURN(MeshDecoder *const decoder,
+                           context_->GetMeshDecoder(header.encoder_method))
+    return decoder->Decode(options_, in_buffer, out_geometry);
+  }
   DRACO_ASSIGN_OR_RETURN(std::unique_ptr<MeshDecoder> decoder,
                          CreateMeshDecoder(header.encoder_method))
 
@@ -125,8 +142,51 @@ Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
 #endif
 }
 
+StatusOr<std::unique_ptr<Mesh>> Decoder::DecodeFaceRange(
+    DecoderBuffer *in_buffer, uint32_t first_face, uint32_t num_faces) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+  DecoderBuffer temp_buffer(*in_buffer);
+  DracoHeader header;
+  DRACO_RETURN_IF_ERROR(PointCloudDecoder::DecodeHeader(&temp_buffer, &header))
+  if (header.encoder_type != TRIANGULAR_MESH) {
+    return Status(Status::DRACO_ERROR, "Input is not a mesh.");
+  }
+  if (header.encoder_method != MESH_SEQUENTIAL_ENCODING) {
+    return Status(Status::DRACO_ERROR,
+                  "Face range decoding requires sequential encoding.");
+  }
+  MeshSequentialDecoder decoder;
+  decoder.SetFaceRange(first_face, num_faces);
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  DRACO_RETURN_IF_ERROR(decoder.Decode(options_, in_buffer, mesh.get()))
+  return std::move(mesh);
+#else
+  return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+}
+
 void Decoder::SetSkipAttributeTransform(GeometryAttribute::Type att_type) {
   options_.SetAttributeBool(att_type, "skip_attribute_transform", true);
 }
 
+void Decoder::SetNumAttributeDecodingThreads(int num_threads) {
+  options_.SetGlobalInt("num_attribute_decoding_threads", num_threads);
+}
+
+void Decoder::SetNumChunkDecodingThreads(int num_threads) {
+  options_.SetGlobalInt("num_chunk_decoding_threads", num_threads);
+}
+
+void Decoder::SetNumConnectivityDecodingThreads(int num_threads) {
+  options_.SetGlobalInt("num_connectivity_decoding_threads", num_threads);
+}
+
+void Decoder::SetStitchMeshChunks(bool stitch) {
+  options_.SetGlobalBool("stitch_mesh_chunks", stitch);
+}
+
+void Decoder::SetDecodeConnectivityOnly(bool connectivity_only) {
+  options_.SetGlobalBool("decode_connectivity_only", connectivity_only);
+}
+
 }  // namespace draco
@@ -25,10 +25,23 @@
 
 namespace draco {
 
+class DecoderContext;
+class MeshDecoder;
+class PointCloudDecoder;
+
+// Creates a decoder for point clouds and meshes encoded with a given encoding
+// |method|. Note that decoders of meshes encoded with MESH_CHUNKED_ENCODING
+// can not be created this way (see DecodeChunkedMesh()).
+StatusOr<std::unique_ptr<PointCloudDecoder>> CreatePointCloudDecoder(
+    int8_t method);
+StatusOr<std::unique_ptr<MeshDecoder>> CreateMeshDecoder(uint8_t method);
+
 // Class responsible for decoding of meshes and point clouds that were
 // compressed by a Draco encoder.
 class Decoder {
  public:
+  Decoder();
+
   // Returns the geometry type encoded in the input |in_buffer|.
   // The return value is one of POINT_CLOUD, MESH or INVALID_GEOMETRY in case
   // the input data is invalid.
@@ -59,6 +72,16 @@ class Decoder {
                                 PointCloud *out_geometry);
   Status DecodeBufferToGeometry(DecoderBuffer *in_buffer, Mesh *out_geometry);
 
+  // Decodes |num_faces| faces starting at |first_face| from a mesh that was
+  // encoded with MESH_SEQUENTIAL_ENCODING and a random access block size
+  // (see Encoder::SetRandomAccessBlockSize()). Only the blocks of the encoded
+  // data that contain the requested faces and the points referenced by them
+  // are decoded. The returned mesh contains the requested faces and all
+  // points of the decoded point blocks.
+  StatusOr<std::unique_ptr<Mesh>> DecodeFaceRange(DecoderBuffer *in_buffer,
+                                                  uint32_t first_face,
+                                                  uint32_t num_faces);
+
   // When set, the decoder is going to skip attribute transform for a given
   // attribute type. For example for quantized attributes, the decoder would
   // skip the dequantization step and the returned geometry would contain an
@@ -68,12 +91,57 @@ class Decoder {
   // transform manually.
   void SetSkipAttributeTransform(GeometryAttribute::Type att_type);
 
+  // Sets the number of worker threads that can be used to decode attributes
+  // of the input geometry in parallel. Decoding of the input buffer itself is
+  // always sequential, but the remaining work for independent attributes
+  // (such as reverting of prediction schemes and dequantization) runs on the
+  // worker threads. Default is 0 (all attributes are decoded on the calling
+  // thread).
+  void SetNumAttributeDecodingThreads(int num_threads);
+
+  // Sets the number of worker threads used to decode meshes that were encoded
+  // in multiple chunks (see Encoder::SetMeshChunking()). Default is 0 (all
+  // chunks are decoded on the calling thread).
+  void SetNumChunkDecodingThreads(int num_threads);
+
+  // Sets the number of worker threads used to decode connectivity of meshes
+  // that were encoded with the sequential encoding in independent blocks of
+  // faces (see "compressed_connectivity_block_size" option of
+  // MeshSequentialEncoder). Default is 0 (all blocks are decoded on the
+  // calling thread).
+  void SetNumConnectivityDecodingThreads(int num_threads);
+
+  // When set, points on the boundaries of decoded mesh chunks are merged
+  // together (together with any other points that share the same attribute
+  // values). Otherwise the boundary points are duplicated in each chunk.
+  // Stitching requires the attribute deduplication features
+  // (DRACO_ATTRIBUTE_VALUES_DEDUPLICATION_SUPPORTED and
+  // DRACO_ATTRIBUTE_INDICES_DEDUPLICATION_SUPPORTED). When they are compiled
+  // out, decoding of chunked meshes with stitching enabled fails.
+  // Default is false.
+  void SetStitchMeshChunks(bool stitch);
+
+  // When set, only the faces of decoded meshes are reconstructed and all
+  // attribute data is skipped. The decoded mesh has the same faces and number
+  // of points as when the attributes are decoded, but it does not contain any
+  // attributes. This is faster and uses less memory, especially for
+  // edgebreaker meshes without attribute seams. Point clouds are not affected.
+  // Default is false.
+  void SetDecodeConnectivityOnly(bool connectivity_only);
+
+  // Sets a context that keeps decoder instances and their internal buffers
+  // alive between multiple decoded geometries (see DecoderContext). The
+  // context must outlive all decoding calls and it can be set to nullptr to
+  // disable the reuse. Default is nullptr.
+  void SetDecoderContext(DecoderContext *context) { context_ = context; }
+
   // Returns the options instance used by the decoder that can be used by users
   // to control the decoding process.
   DecoderOptions *options() { return &options_; }
 
  private:
   DecoderOptions options_;
+  DecoderContext *context_;
 };
 
 }  // namespace draco
@@ -16,8 +16,11 @@
 
 #include <cinttypes>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
+#include "draco/compression/decoder_context.h"
+#include "draco/compression/encode.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
 
@@ -193,4 +196,186 @@ TEST_F(DecodeTest, TestSkipAttributeTransformWithNoQuantization) {
   ASSERT_EQ(pos_att->GetAttributeTransformData(), nullptr);
 }
 
+TEST_F(DecodeTest, TestSkipAttributeTransformOnIntegerAttribute) {
+  // Tests that an integer attribute with a skipped transform is replaced by its
+  // portable version unless the original format is explicitly requested.
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("test_pos_color.ply");
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+  encoder.SetEncodingMethod(draco::MESH_SEQUENTIAL_ENCODING);
+  draco::EncoderBuffer encoder_buffer;
+  ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer).ok());
+
+  for (const bool keep_untransformed : {false, true}) {
+    draco::DecoderBuffer buffer;
+    buffer.Init(encoder_buffer.data(), encoder_buffer.size());
+    draco::Decoder decoder;
+    decoder.SetSkipAttributeTransform(draco::GeometryAttribute::COLOR);
+    if (keep_untransformed) {
+      decoder.options()->SetAttributeBool(draco::GeometryAttribute::COLOR,
+                                          "keep_untransformed_attributes",
+                                          true);
+    }
+    const std::unique_ptr<draco::Mesh> decoded_mesh =
+        decoder.DecodeMeshFromBuffer(&buffer).value();
+    ASSERT_NE(decoded_mesh, nullptr);
+    const draco::PointAttribute *const clr_att =
+        decoded_mesh->GetNamedAttribute(draco::GeometryAttribute::COLOR);
+    ASSERT_NE(clr_att, nullptr);
+    ASSERT_EQ(clr_att->GetAttributeTransformData(), nullptr);
+    if (keep_untransformed) {
+      ASSERT_EQ(clr_att->data_type(), draco::DT_UINT8);
+      ASSERT_TRUE(clr_att->normalized());
+    } else {
+      ASSERT_EQ(clr_att->data_type(), draco::DT_INT32);
+    }
+  }
+}
+
+// Decodes |data| with the given number of attribute decoding threads.
+std::unique_ptr<draco::PointCloud> DecodeWithThreads(
+    const std::vector<char> &data, int num_threads, bool skip_transform) {
+  draco::DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  draco::Decoder decoder;
+  decoder.SetNumAttributeDecodingThreads(num_threads);
+  if (skip_transform)
+    decoder.SetSkipAttributeTransform(draco::GeometryAttribute::POSITION);
+  auto maybe_pc = decoder.DecodePointCloudFromBuffer(&buffer);
+  if (!maybe_pc.ok())
+    return nullptr;
+  return std::move(maybe_pc).value();
+}
+
+// Verifies that decoding of attributes on multiple threads produces the same
+// output as the single threaded decoding.
+void TestParallelAttributeDecoding(const std::vector<char> &data) {
+  for (const bool skip_transform : {false, true}) {
+    const std::unique_ptr<draco::PointCloud> pc =
+        DecodeWithThreads(data, 0, skip_transform);
+    ASSERT_NE(pc, nullptr);
+    for (const int num_threads : {1, 4}) {
+      const std::unique_ptr<draco::PointCloud> pc_2 =
+          DecodeWithThreads(data, num_threads, skip_transform);
+      ASSERT_NE(pc_2, nullptr);
+      ASSERT_EQ(pc->num_points(), pc_2->num_points());
+      ASSERT_EQ(pc->num_attributes(), pc_2->num_attributes());
+      for (int i = 0; i < pc->num_attributes(); ++i) {
+        const draco::PointAttribute *const att = pc->attribute(i);
+        const draco::PointAttribute *const att_2 = pc_2->attribute(i);
+        ASSERT_EQ(att->data_type(), att_2->data_type());
+        ASSERT_EQ(att->byte_stride(), att_2->byte_stride());
+        for (draco::PointIndex pi(0); pi < pc->num_points(); ++pi) {
+          ASSERT_EQ(std::memcmp(att->GetAddress(att->mapped_index(pi)),
+                                att_2->GetAddress(att_2->mapped_index(pi)),
+                                att->byte_stride()),
+                    0);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestParallelAttributeDecoding) {
+  for (const std::string file_name : {"cube_att.obj", "test_nm.obj"}) {
+    const std::unique_ptr<draco::Mesh> mesh =
+        draco::ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    for (const draco::MeshEncoderMethod method :
+         {draco::MESH_SEQUENTIAL_ENCODING, draco::MESH_EDGEBREAKER_ENCODING}) {
+      draco::Encoder encoder;
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD,
+                                       12);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+      encoder.SetEncodingMethod(method);
+      draco::EncoderBuffer buffer;
+      ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+      TestParallelAttributeDecoding(
+          std::vector<char>(buffer.data(), buffer.data() + buffer.size()));
+    }
+  }
+  // Test also older bit-streams and point clouds.
+  for (const std::string file_name :
+       {"test_nm.obj.edgebreaker.1.2.0.drc", "pc_color.drc",
+        "pc_kd_color.drc"}) {
+    std::ifstream input_file(draco::GetTestFileFullPath(file_name),
+                             std::ios::binary);
+    ASSERT_TRUE(input_file);
+    const std::vector<char> data((std::istreambuf_iterator<char>(input_file)),
+                                 std::istreambuf_iterator<char>());
+    ASSERT_FALSE(data.empty());
+    TestParallelAttributeDecoding(data);
+  }
+}
+
+// Decodes |data| and verifies that the connectivity-only decoding produces
+// the same faces and points as the full decoding.
+void TestDecodeConnectivityOnly(const std::vector<char> &data) {
+  draco::DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  draco::Decoder decoder;
+  auto maybe_mesh = decoder.DecodeMeshFromBuffer(&buffer);
+  ASSERT_TRUE(maybe_mesh.ok());
+  const std::unique_ptr<draco::Mesh> mesh = std::move(maybe_mesh).value();
+
+  // Decode the data multiple times with the same decoder context to ensure
+  // that the connectivity-only decoding can be interleaved with the full one.
+  draco::DecoderContext context;
+  draco::Decoder connectivity_decoder;
+  connectivity_decoder.SetDecoderContext(&context);
+  for (int i = 0; i < 2; ++i) {
+    buffer.Init(data.data(), data.size());
+    connectivity_decoder.SetDecodeConnectivityOnly(true);
+    auto maybe_mesh_2 = connectivity_decoder.DecodeMeshFromBuffer(&buffer);
+    ASSERT_TRUE(maybe_mesh_2.ok());
+    const std::unique_ptr<draco::Mesh> mesh_2 =
+        std::move(maybe_mesh_2).value();
+    ASSERT_EQ(mesh_2->num_attributes(), 0);
+    ASSERT_EQ(mesh->num_points(), mesh_2->num_points());
+    ASSERT_EQ(mesh->num_faces(), mesh_2->num_faces());
+    for (draco::FaceIndex fi(0); fi < mesh->num_faces(); ++fi) {
+      ASSERT_EQ(mesh->face(fi), mesh_2->face(fi));
+    }
+
+    buffer.Init(data.data(), data.size());
+    connectivity_decoder.SetDecodeConnectivityOnly(false);
+    auto maybe_mesh_3 = connectivity_decoder.DecodeMeshFromBuffer(&buffer);
+    ASSERT_TRUE(maybe_mesh_3.ok());
+    ASSERT_EQ(maybe_mesh_3.value()->num_attributes(), mesh->num_attributes());
+  }
+}
+
+TEST_F(DecodeTest, TestDecodeConnectivityOnly) {
+  for (const std::string file_name :
+       {"cube_att.obj", "test_nm.obj", "bun_zipper.ply"}) {
+    const std::unique_ptr<draco::Mesh> mesh =
+        draco::ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    for (const draco::MeshEncoderMethod method :
+         {draco::MESH_SEQUENTIAL_ENCODING, draco::MESH_EDGEBREAKER_ENCODING}) {
+      draco::Encoder encoder;
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD,
+                                       12);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+      encoder.SetEncodingMethod(method);
+      draco::EncoderBuffer buffer;
+      ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+      TestDecodeConnectivityOnly(
+          std::vector<char>(buffer.data(), buffer.data() + buffer.size()));
+    }
+  }
+  // Test also an older bit-stream.
+  std::ifstream input_file(
+      draco::GetTestFileFullPath("test_nm.obj.edgebreaker.1.2.0.drc"),
+      std::ios::binary);
+  ASSERT_TRUE(input_file);
+  const std::vector<char> data((std::istreambuf_iterator<char>(input_file)),
+                               std::istreambuf_iterator<char>());
+  TestDecodeConnectivityOnly(data);
+}
+
 }  // namespace
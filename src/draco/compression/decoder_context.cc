@@ -0,0 +1,57 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/decoder_context.h"
+
+#include "draco/compression/decode.h"
+#include "draco/compression/mesh/mesh_decoder.h"
+#include "draco/compression/point_cloud/point_cloud_decoder.h"
+
+namespace draco {
+
+DecoderContext::DecoderContext() {}
+
+DecoderContext::~DecoderContext() {}
+
+StatusOr<PointCloudDecoder *> DecoderContext::GetPointCloudDecoder(
+    int8_t method) {
+  std::unique_ptr<PointCloudDecoder> &decoder = point_cloud_decoders_[method];
+  if (decoder == nullptr) {
+#ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
+    DRACO_ASSIGN_OR_RETURN(decoder, CreatePointCloudDecoder(method))
+#else
+    return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+  }
+  return decoder.get();
+}
+
+StatusOr<MeshDecoder *> DecoderContext::GetMeshDecoder(uint8_t method) {
+  std::unique_ptr<MeshDecoder> &decoder = mesh_decoders_[method];
+  if (decoder == nullptr) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+    DRACO_ASSIGN_OR_RETURN(decoder, CreateMeshDecoder(method))
+#else
+    return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+  }
+  return decoder.get();
+}
+
+void DecoderContext::Clear() {
+  point_cloud_decoders_.clear();
+  mesh_decoders_.clear();
+}
+
+}  // namespace draco
@@ -0,0 +1,66 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_DECODER_CONTEXT_H_
+#define DRACO_COMPRESSION_DECODER_CONTEXT_H_
+
+#include <map>
+#include <memory>
+
+#include "draco/draco_features.h"
+
+#include "draco/core/status_or.h"
+
+namespace draco {
+
+class MeshDecoder;
+class PointCloudDecoder;
+
+// Class that keeps decoder instances alive between multiple decoded
+// geometries. The decoders keep their internal data structures (such as the
+// corner table and traversal buffers used by the Edgebreaker decoder) and
+// reuse the allocated memory for subsequently decoded geometries. This can
+// significantly reduce the number of memory allocations when many small
+// geometries are decoded in a row.
+//
+// Usage:
+//   DecoderContext context;
+//   Decoder decoder;
+//   decoder.SetDecoderContext(&context);
+//   for (...) {
+//     decoder.DecodeMeshFromBuffer(&buffer);
+//   }
+//
+// The context must not be used by multiple decoders at the same time.
+class DecoderContext {
+ public:
+  DecoderContext();
+  ~DecoderContext();
+
+  // Returns a decoder for a given encoding |method|. The decoder is created on
+  // the first request and reused afterwards.
+  StatusOr<PointCloudDecoder *> GetPointCloudDecoder(int8_t method);
+  StatusOr<MeshDecoder *> GetMeshDecoder(uint8_t method);
+
+  // Releases all decoders together with their allocated memory.
+  void Clear();
+
+ private:
+  std::map<int, std::unique_ptr<PointCloudDecoder>> point_cloud_decoders_;
+  std::map<int, std::unique_ptr<MeshDecoder>> mesh_decoders_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_DECODER_CONTEXT_H_
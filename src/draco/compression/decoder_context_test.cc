@@ -0,0 +1,138 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/decoder_context.h"
+
+#include <cstring>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/compression/mesh/mesh_decoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace draco {
+
+class DecoderContextTest : public ::testing::Test {
+ protected:
+  void EncodeMesh(const std::string &file_name, int encoding_method,
+                  EncoderBuffer *buffer) {
+    const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    Encoder encoder;
+    encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 14);
+    encoder.SetAttributeQuantization(GeometryAttribute::TEX_COORD, 12);
+    encoder.SetAttributeQuantization(GeometryAttribute::NORMAL, 10);
+    encoder.SetEncodingMethod(encoding_method);
+    ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, buffer).ok());
+  }
+
+  void DecodeMesh(Decoder *decoder, const EncoderBuffer &buffer,
+                  Mesh *out_mesh) {
+    DecoderBuffer in_buffer;
+    in_buffer.Init(buffer.data(), buffer.size());
+    ASSERT_TRUE(decoder->DecodeBufferToGeometry(&in_buffer, out_mesh).ok());
+  }
+
+  // Returns true when both meshes have the same faces and attribute values.
+  bool AreMeshesEqual(const Mesh &mesh_0, const Mesh &mesh_1) {
+    if (mesh_0.num_faces() != mesh_1.num_faces() ||
+        mesh_0.num_points() != mesh_1.num_points() ||
+        mesh_0.num_attributes() != mesh_1.num_attributes())
+      return false;
+    for (FaceIndex fi(0); fi < mesh_0.num_faces(); ++fi) {
+      if (mesh_0.face(fi) != mesh_1.face(fi))
+        return false;
+    }
+    for (int i = 0; i < mesh_0.num_attributes(); ++i) {
+      const PointAttribute *const att_0 = mesh_0.attribute(i);
+      const PointAttribute *const att_1 = mesh_1.attribute(i);
+      if (att_0->byte_stride() != att_1->byte_stride())
+        return false;
+      for (PointIndex pi(0); pi < mesh_0.num_points(); ++pi) {
+        if (std::memcmp(att_0->GetAddress(att_0->mapped_index(pi)),
+                        att_1->GetAddress(att_1->mapped_index(pi)),
+                        att_0->byte_stride()) != 0)
+          return false;
+      }
+    }
+    return true;
+  }
+};
+
+TEST_F(DecoderContextTest, TestDecodingWithContext) {
+  // Decode different meshes with the same context and ensure the results are
+  // the same as when the meshes are decoded without the context.
+  std::vector<EncoderBuffer> buffers(4);
+  EncodeMesh("test_nm.obj", MESH_EDGEBREAKER_ENCODING, &buffers[0]);
+  EncodeMesh("cube_att.obj", MESH_EDGEBREAKER_ENCODING, &buffers[1]);
+  EncodeMesh("cube_att.obj", MESH_SEQUENTIAL_ENCODING, &buffers[2]);
+  EncodeMesh("test_nm.obj", MESH_SEQUENTIAL_ENCODING, &buffers[3]);
+
+  DecoderContext context;
+  Decoder context_decoder;
+  context_decoder.SetDecoderContext(&context);
+  for (int i = 0; i < 3; ++i) {
+    for (const EncoderBuffer &buffer : buffers) {
+      Decoder decoder;
+      Mesh ref_mesh;
+      DecodeMesh(&decoder, buffer, &ref_mesh);
+      Mesh mesh;
+      DecodeMesh(&context_decoder, buffer, &mesh);
+      ASSERT_TRUE(AreMeshesEqual(ref_mesh, mesh));
+    }
+  }
+}
+
+TEST_F(DecoderContextTest, TestDecoderReuse) {
+  EncoderBuffer large_buffer;
+  EncodeMesh("test_nm.obj", MESH_EDGEBREAKER_ENCODING, &large_buffer);
+  EncoderBuffer small_buffer;
+  EncodeMesh("cube_att.obj", MESH_EDGEBREAKER_ENCODING, &small_buffer);
+
+  DecoderContext context;
+  Decoder decoder;
+  decoder.SetDecoderContext(&context);
+  Mesh large_mesh;
+  DecodeMesh(&decoder, large_buffer, &large_mesh);
+
+  // The decoder used for the decoding is owned by the context.
+  MeshDecoder *const mesh_decoder =
+      context.GetMeshDecoder(MESH_EDGEBREAKER_ENCODING).value();
+  ASSERT_NE(mesh_decoder, nullptr);
+  const CornerTable *const corner_table = mesh_decoder->GetCornerTable();
+  ASSERT_NE(corner_table, nullptr);
+  ASSERT_EQ(corner_table->num_faces(), large_mesh.num_faces());
+
+  // Subsequent decodings use the same decoder and its corner table.
+  Mesh small_mesh;
+  DecodeMesh(&decoder, small_buffer, &small_mesh);
+  ASSERT_EQ(context.GetMeshDecoder(MESH_EDGEBREAKER_ENCODING).value(),
+            mesh_decoder);
+  ASSERT_EQ(mesh_decoder->GetCornerTable(), corner_table);
+  ASSERT_EQ(corner_table->num_faces(), small_mesh.num_faces());
+
+  Mesh large_mesh_1;
+  DecodeMesh(&decoder, large_buffer, &large_mesh_1);
+  ASSERT_EQ(mesh_decoder->GetCornerTable(), corner_table);
+  ASSERT_TRUE(AreMeshesEqual(large_mesh, large_mesh_1));
+
+  // Clearing the context releases the decoder.
+  context.Clear();
+  Mesh large_mesh_2;
+  DecodeMesh(&decoder, large_buffer, &large_mesh_2);
+  ASSERT_TRUE(AreMeshesEqual(large_mesh, large_mesh_2));
+}
+
+}  // namespace draco
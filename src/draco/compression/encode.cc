@@ -36,6 +36,18 @@ Status Encoder::EncodeMeshToBuffer(const Mesh &m, EncoderBuffer *out_buffer) {
   return OkStatus();
 }
 
+size_t Encoder::EstimateEncodedPointCloudSize(const PointCloud &pc) const {
+  ExpertEncoder encoder(pc);
+  encoder.Reset(CreateExpertEncoderOptions(pc));
+  return encoder.EstimateEncodedSize();
+}
+
+size_t Encoder::EstimateEncodedMeshSize(const Mesh &m) const {
+  ExpertEncoder encoder(m);
+  encoder.Reset(CreateExpertEncoderOptions(m));
+  return encoder.EstimateEncodedSize();
+}
+
 EncoderOptions Encoder::CreateExpertEncoderOptions(const PointCloud &pc) const {
   EncoderOptions ret_options = EncoderOptions::CreateEmptyOptions();
   ret_options.SetGlobalOptions(options().GetGlobalOptions());
@@ -82,6 +94,23 @@ void Encoder::SetEncodingMethod(int encoding_method) {
   Base::SetEncodingMethod(encoding_method);
 }
 
+void Encoder::SetMeshChunking(int num_chunks, int num_threads) {
+  Base::SetMeshChunking(num_chunks, num_threads);
+}
+
+void Encoder::SetSplitMeshChunksOnComponents(bool split_on_components) {
+  Base::SetSplitMeshChunksOnComponents(split_on_components);
+}
+
+void Encoder::SetRandomAccessBlockSize(int block_size) {
+  Base::SetRandomAccessBlockSize(block_size);
+}
+
+void Encoder::SetPredictionSchemeSelectionByTrial(bool enabled,
+                                                  int num_threads) {
+  Base::SetPredictionSchemeSelectionByTrial(enabled, num_threads);
+}
+
 Status Encoder::SetAttributePredictionScheme(GeometryAttribute::Type type,
                                              int prediction_scheme_method) {
   Status status = CheckPredictionScheme(type, prediction_scheme_method);
@@ -65,6 +65,25 @@ class EncoderBase {
     options_.SetGlobalInt("encoding_submethod", encoding_submethod);
   }
 
+  void SetMeshChunking(int num_chunks, int num_threads) {
+    options_.SetGlobalInt("num_encoding_chunks", num_chunks);
+    options_.SetGlobalInt("num_encoding_threads", num_threads);
+  }
+
+  void SetSplitMeshChunksOnComponents(bool split_on_components) {
+    options_.SetGlobalBool("split_mesh_chunks_on_components",
+                           split_on_components);
+  }
+
+  void SetRandomAccessBlockSize(int block_size) {
+    options_.SetGlobalInt("random_access_block_size", block_size);
+  }
+
+  void SetPredictionSchemeSelectionByTrial(bool enabled, int num_threads) {
+    options_.SetGlobalBool("select_prediction_schemes_by_trial", enabled);
+    options_.SetGlobalInt("num_prediction_trial_threads", num_threads);
+  }
+
   Status CheckPredictionScheme(GeometryAttribute::Type att_type,
                                int prediction_scheme) const {
     // Out of bound checks:
@@ -14,6 +14,7 @@
 //
 
 #include <cinttypes>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
@@ -290,4 +291,161 @@ TEST_F(EncodeTest, TestTrackingOfNumberOfEncodedEntriesNotSet) {
   ASSERT_EQ(encoder.num_encoded_faces(), 0);
 }
 
+TEST_F(EncodeTest, TestEncodedSizeEstimate) {
+  // The estimated size should be larger than the actual encoded size and the
+  // encoding into a large enough arena should not use any other memory.
+  for (const std::string file_name :
+       {"cube_att.obj", "test_nm.obj", "sphere.obj", "cube_subd.obj"}) {
+    std::unique_ptr<draco::Mesh> mesh(draco::ReadMeshFromTestFile(file_name));
+    ASSERT_NE(mesh, nullptr);
+    for (const int quantization_bits : {-1, 8, 14, 20}) {
+      draco::Encoder encoder;
+      if (quantization_bits > 0) {
+        for (int i = 0; i < draco::GeometryAttribute::NAMED_ATTRIBUTES_COUNT;
+             ++i) {
+          encoder.SetAttributeQuantization(draco::GeometryAttribute::Type(i),
+                                           quantization_bits);
+        }
+      }
+      const size_t estimate = encoder.EstimateEncodedMeshSize(*mesh);
+      std::vector<char> arena(estimate);
+      draco::EncoderBuffer buffer;
+      buffer.SetArena(arena.data(), arena.size());
+      ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+      ASSERT_LE(buffer.size(), estimate) << file_name;
+      ASSERT_TRUE(buffer.uses_arena());
+
+      draco::EncoderBuffer ref_buffer;
+      ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &ref_buffer).ok());
+      ASSERT_EQ(buffer.size(), ref_buffer.size());
+      ASSERT_EQ(std::memcmp(buffer.data(), ref_buffer.data(), buffer.size()),
+                0);
+    }
+  }
+}
+
+TEST_F(EncodeTest, TestEncodedSizeEstimateIsUpperBound) {
+  // The estimated size must not be smaller than the encoded size for any of
+  // the test models and encoder settings.
+  for (const std::string file_name :
+       {"bun_zipper.ply", "cube_att.obj", "cube_att.ply",
+        "cube_att_partial.obj", "cube_att_sub_o.obj", "cube_quads.obj",
+        "cube_subd.obj", "deg_faces.obj", "degenerate_mesh.obj",
+        "extra_vertex.obj", "int_point_cloud.ply", "mat_test.obj",
+        "multiple_isolated_triangles.obj", "multiple_tetrahedrons.obj",
+        "one_face_123.obj", "point_cloud_test_pos.ply",
+        "point_cloud_test_pos_norm.ply", "sphere.obj",
+        "test_more_datatypes.ply", "test_nm.obj", "test_nm_trans.obj",
+        "test_pos_color.ply", "test_sphere.obj", "three_faces_123.obj",
+        "triangle.obj", "triangle_with_degenerate_tex_coords.obj"}) {
+    const std::unique_ptr<draco::PointCloud> pc =
+        draco::ReadPointCloudFromTestFile(file_name);
+    ASSERT_NE(pc, nullptr) << file_name;
+    const std::unique_ptr<draco::Mesh> mesh =
+        draco::ReadMeshFromTestFile(file_name);
+    const bool is_mesh = mesh != nullptr && mesh->num_faces() > 0;
+    std::vector<int> encoding_methods;
+    if (is_mesh) {
+      encoding_methods = {draco::MESH_SEQUENTIAL_ENCODING,
+                          draco::MESH_EDGEBREAKER_ENCODING};
+    } else {
+      encoding_methods = {draco::POINT_CLOUD_SEQUENTIAL_ENCODING,
+                          draco::POINT_CLOUD_KD_TREE_ENCODING};
+    }
+    for (const int encoding_method : encoding_methods) {
+      for (const int speed : {0, 5, 10}) {
+        for (const int quantization_bits : {-1, 4, 8, 14, 20}) {
+          if (encoding_method == draco::POINT_CLOUD_KD_TREE_ENCODING &&
+              quantization_bits < 0)
+            continue;  // kD-tree encoding needs quantized positions.
+          std::unique_ptr<draco::ExpertEncoder> encoder;
+          if (is_mesh) {
+            encoder.reset(new draco::ExpertEncoder(*mesh));
+          } else {
+            encoder.reset(new draco::ExpertEncoder(*pc));
+          }
+          encoder->SetEncodingMethod(encoding_method);
+          encoder->SetSpeedOptions(speed, speed);
+          const draco::PointCloud &geometry =
+              is_mesh ? static_cast<const draco::PointCloud &>(*mesh) : *pc;
+          for (int i = 0; quantization_bits > 0 && i < geometry.num_attributes();
+               ++i) {
+            if (geometry.attribute(i)->data_type() == draco::DT_FLOAT32)
+              encoder->SetAttributeQuantization(i, quantization_bits);
+          }
+          draco::EncoderBuffer buffer;
+          if (!encoder->EncodeToBuffer(&buffer).ok())
+            continue;  // Unsupported combination of settings.
+          EXPECT_GE(encoder->EstimateEncodedSize(), buffer.size())
+              << file_name << " method " << encoding_method << " speed "
+              << speed << " quantization " << quantization_bits;
+        }
+      }
+    }
+  }
+}
+
+TEST_F(EncodeTest, TestPredictionSchemeSelectionByTrial) {
+  // Meshes encoded with prediction schemes selected by trial encoding must be
+  // decoded to the same values as meshes encoded with the default schemes.
+  for (const std::string file_name :
+       {"cube_att.obj", "test_nm.obj", "sphere.obj", "bun_zipper.ply"}) {
+    std::unique_ptr<draco::Mesh> mesh(draco::ReadMeshFromTestFile(file_name));
+    ASSERT_NE(mesh, nullptr);
+    for (const int encoding_method :
+         {draco::MESH_EDGEBREAKER_ENCODING, draco::MESH_SEQUENTIAL_ENCODING}) {
+      draco::Encoder encoder;
+      encoder.SetEncodingMethod(encoding_method);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+      draco::EncoderBuffer ref_buffer;
+      ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &ref_buffer).ok());
+
+      // The selected schemes do not depend on the number of threads.
+      draco::EncoderBuffer buffer;
+      encoder.SetPredictionSchemeSelectionByTrial(true, 0);
+      ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+      draco::EncoderBuffer mt_buffer;
+      encoder.SetPredictionSchemeSelectionByTrial(true, 2);
+      ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &mt_buffer).ok());
+      ASSERT_EQ(mt_buffer.size(), buffer.size());
+      ASSERT_EQ(std::memcmp(mt_buffer.data(), buffer.data(), buffer.size()), 0);
+      ASSERT_LE(buffer.size(), ref_buffer.size()) << file_name;
+
+      draco::Decoder decoder;
+      draco::DecoderBuffer ref_dec_buffer;
+      ref_dec_buffer.Init(ref_buffer.data(), ref_buffer.size());
+      auto ref_status_or = decoder.DecodeMeshFromBuffer(&ref_dec_buffer);
+      ASSERT_TRUE(ref_status_or.ok());
+      const std::unique_ptr<draco::Mesh> ref_mesh =
+          std::move(ref_status_or).value();
+      draco::DecoderBuffer dec_buffer;
+      dec_buffer.Init(buffer.data(), buffer.size());
+      auto status_or = decoder.DecodeMeshFromBuffer(&dec_buffer);
+      ASSERT_TRUE(status_or.ok());
+      const std::unique_ptr<draco::Mesh> decoded_mesh =
+          std::move(status_or).value();
+      ASSERT_EQ(decoded_mesh->num_faces(), ref_mesh->num_faces());
+      ASSERT_EQ(decoded_mesh->num_attributes(), ref_mesh->num_attributes());
+      for (int i = 0; i < ref_mesh->num_attributes(); ++i) {
+        const draco::PointAttribute *const ref_att = ref_mesh->attribute(i);
+        const draco::PointAttribute *const att = decoded_mesh->attribute(i);
+        for (draco::FaceIndex fi(0); fi < ref_mesh->num_faces(); ++fi) {
+          for (int c = 0; c < 3; ++c) {
+            const draco::PointIndex ref_pi = ref_mesh->face(fi)[c];
+            const draco::PointIndex pi = decoded_mesh->face(fi)[c];
+            ASSERT_EQ(
+                std::memcmp(ref_att->GetAddress(ref_att->mapped_index(ref_pi)),
+                            att->GetAddress(att->mapped_index(pi)),
+                            ref_att->byte_stride()),
+                0)
+                << file_name;
+          }
+        }
+      }
+    }
+  }
+}
+
 }  // namespace
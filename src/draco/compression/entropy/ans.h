@@ -18,6 +18,7 @@
 // See http://arxiv.org/abs/1311.2540v2 for more information on rANS.
 // This file is based off libvpx's ans.h.
 
+#include <type_traits>
 #include <vector>
 
 #define DRACO_ANS_DIVIDE_BY_MULTIPLY 1
@@ -331,6 +332,57 @@ static inline int ans_reader_has_error(const struct AnsDecoder *const ans) {
   return ans->state < DRACO_ANS_L_BASE && ans->buf_offset == 0;
 }
 
+// Stores the final |state| of a rANS coder into |buf| at |offset|. The |state|
+// must be already offset by the lower bound of the coder's state interval.
+// Returns the offset right after the stored state.
+static inline int rans_write_state(uint8_t *const buf, int offset,
+                                   uint32_t state) {
+  if (state < (1 << 6)) {
+    buf[offset] = (0x00 << 6) + state;
+    return offset + 1;
+  } else if (state < (1 << 14)) {
+    mem_put_le16(buf + offset, (0x01 << 14) + state);
+    return offset + 2;
+  } else if (state < (1 << 22)) {
+    mem_put_le24(buf + offset, (0x02 << 22) + state);
+    return offset + 3;
+  } else if (state < (1 << 30)) {
+    mem_put_le32(buf + offset, (0x03u << 30u) + state);
+    return offset + 4;
+  } else {
+    DRACO_DCHECK(0 && "State is too large to be serialized");
+    return offset;
+  }
+}
+
+// Reads a rANS coder state stored by rans_write_state() that ends right before
+// |offset| in |buf|. Returns the offset of the first byte of the stored state
+// or -1 on error.
+static inline int rans_read_state(const uint8_t *const buf, int offset,
+                                  uint32_t *out_state) {
+  if (offset < 1)
+    return -1;
+  const unsigned x = buf[offset - 1] >> 6;
+  if (x == 0) {
+    *out_state = buf[offset - 1] & 0x3F;
+    return offset - 1;
+  } else if (x == 1) {
+    if (offset < 2)
+      return -1;
+    *out_state = mem_get_le16(buf + offset - 2) & 0x3FFF;
+    return offset - 2;
+  } else if (x == 2) {
+    if (offset < 3)
+      return -1;
+    *out_state = mem_get_le24(buf + offset - 3) & 0x3FFFFF;
+    return offset - 3;
+  }
+  if (offset < 4)
+    return -1;
+  *out_state = mem_get_le32(buf + offset - 4) & 0x3FFFFFFF;
+  return offset - 4;
+}
+
 struct rans_sym {
   uint32_t prob;
   uint32_t cum_prob;  // not-inclusive.
@@ -354,26 +406,10 @@ class RAnsEncoder {
 
   // Needs to be called after all symbols are encoded.
   inline int write_end() {
-    uint32_t state;
     DRACO_DCHECK_GE(ans_.state, l_rans_base);
     DRACO_DCHECK_LT(ans_.state, l_rans_base * DRACO_ANS_IO_BASE);
-    state = ans_.state - l_rans_base;
-    if (state < (1 << 6)) {
-      ans_.buf[ans_.buf_offset] = (0x00 << 6) + state;
-      return ans_.buf_offset + 1;
-    } else if (state < (1 << 14)) {
-      mem_put_le16(ans_.buf + ans_.buf_offset, (0x01 << 14) + state);
-      return ans_.buf_offset + 2;
-    } else if (state < (1 << 22)) {
-      mem_put_le24(ans_.buf + ans_.buf_offset, (0x02 << 22) + state);
-      return ans_.buf_offset + 3;
-    } else if (state < (1 << 30)) {
-      mem_put_le32(ans_.buf + ans_.buf_offset, (0x03u << 30u) + state);
-      return ans_.buf_offset + 4;
-    } else {
-      DRACO_DCHECK(0 && "State is too large to be serialized");
-      return ans_.buf_offset;
-    }
+    return rans_write_state(ans_.buf, ans_.buf_offset,
+                            ans_.state - l_rans_base);
   }
 
   // rANS with normalization.
@@ -396,16 +432,270 @@ class RAnsEncoder {
   AnsCoder ans_;
 };
 
+// Class for performing interleaved rANS encoding with |num_states_t|
+// independent rANS states that share a single output buffer. The encoded
+// symbols are assigned to the states in a round robin fashion. This allows the
+// decoder to process several symbols at the same time, because each decoded
+// symbol depends only on the previous symbol decoded from the same state (see
+// RAnsInterleavedDecoder).
+template <int rans_precision_bits_t, int num_states_t>
+class RAnsInterleavedEncoder {
+ public:
+  RAnsInterleavedEncoder() : buf_(nullptr), buf_offset_(0), state_id_(0) {}
+
+  // Provides the input buffer where the data is going to be stored.
+  inline void write_init(uint8_t *const buf) {
+    buf_ = buf;
+    buf_offset_ = 0;
+    state_id_ = 0;
+    for (int i = 0; i < num_states_t; ++i) {
+      states_[i] = l_rans_base;
+    }
+  }
+
+  // Needs to be called after all symbols are encoded. Stores the final values
+  // of all states followed by the id of the state that was used to encode the
+  // last symbol (which is the first symbol that is going to be decoded).
+  inline int write_end() {
+    for (int i = 0; i < num_states_t; ++i) {
+      DRACO_DCHECK_GE(states_[i], l_rans_base);
+      DRACO_DCHECK_LT(states_[i], l_rans_base * DRACO_ANS_IO_BASE);
+      buf_offset_ =
+          rans_write_state(buf_, buf_offset_, states_[i] - l_rans_base);
+    }
+    const int last_state_id =
+        state_id_ == 0 ? num_states_t - 1 : state_id_ - 1;
+    buf_[buf_offset_] = static_cast<uint8_t>(last_state_id);
+    return buf_offset_ + 1;
+  }
+
+  // rANS with normalization (see RAnsEncoder::rans_write()) using the next
+  // state in the round robin order.
+  inline void rans_write(const struct rans_sym *const sym) {
+    const uint32_t p = sym->prob;
+    uint32_t state = states_[state_id_];
+    while (state >= l_rans_base / rans_precision * DRACO_ANS_IO_BASE * p) {
+      buf_[buf_offset_++] = state % DRACO_ANS_IO_BASE;
+      state /= DRACO_ANS_IO_BASE;
+    }
+    states_[state_id_] =
+        (state / p) * rans_precision + state % p + sym->cum_prob;
+    if (++state_id_ == num_states_t)
+      state_id_ = 0;
+  }
+
+ private:
+  static constexpr int rans_precision = 1 << rans_precision_bits_t;
+  static constexpr int l_rans_base = rans_precision * 4;
+  uint8_t *buf_;
+  int buf_offset_;
+  uint32_t states_[num_states_t];
+  // Id of the state that is going to be used for the next encoded symbol.
+  int state_id_;
+};
+
 struct rans_dec_sym {
   uint32_t val;
   uint32_t prob;
   uint32_t cum_prob;  // not-inclusive.
 };
 
+// Lookup tables used by the rANS decoders to find the decoded symbol and its
+// probability for a given decoder state. All tables provide the same
+// interface but they differ in their memory layout. The table used by the
+// decoders is selected at compile time based on the number of precision bits
+// (see RAnsLookUpTable below).
+
+// Table storing the decoded symbol id for each of the |rans_precision| states
+// and a separate table of symbol probabilities. Fetching a symbol requires two
+// dependent memory accesses.
+template <int rans_precision_bits_t>
+class RAnsDirectLookUpTable {
+ public:
+  RAnsDirectLookUpTable() {}
+
+  // Construct a lookup table with |rans_precision| number of entries.
+  // Returns false if the table couldn't be built (because of wrong input data).
+  inline bool build(const uint32_t token_probs[], uint32_t num_symbols) {
+    lut_table_.resize(rans_precision);
+    probability_table_.resize(num_symbols);
+    uint32_t cum_prob = 0;
+    uint32_t act_prob = 0;
+    for (uint32_t i = 0; i < num_symbols; ++i) {
+      probability_table_[i].prob = token_probs[i];
+      probability_table_[i].cum_prob = cum_prob;
+      cum_prob += token_probs[i];
+      if (cum_prob > rans_precision) {
+        return false;
+      }
+      for (uint32_t j = act_prob; j < cum_prob; ++j) {
+        lut_table_[j] = i;
+      }
+      act_prob = cum_prob;
+    }
+    if (cum_prob != rans_precision) {
+      return false;
+    }
+    return true;
+  }
+
+  inline void fetch_sym(struct rans_dec_sym *out, uint32_t rem) const {
+    uint32_t symbol = lut_table_[rem];
+    out->val = symbol;
+    out->prob = probability_table_[symbol].prob;
+    out->cum_prob = probability_table_[symbol].cum_prob;
+  }
+
+ private:
+  static constexpr int rans_precision = 1 << rans_precision_bits_t;
+  std::vector<uint32_t> lut_table_;
+  std::vector<rans_sym> probability_table_;
+};
+
+// Table storing the decoded symbol together with its probability and
+// cumulative probability packed into a single 64-bit entry for each of the
+// |rans_precision| states. Fetching a symbol requires only one memory access,
+// but the table is twice as large as the symbol table of
+// RAnsDirectLookUpTable.
+template <int rans_precision_bits_t>
+class RAnsFusedLookUpTable {
+ public:
+  RAnsFusedLookUpTable() {}
+
+  inline bool build(const uint32_t token_probs[], uint32_t num_symbols) {
+    // Make sure all symbol ids fit into the entries.
+    if (num_symbols > (static_cast<uint64_t>(1) << symbol_bits))
+      return false;
+    lut_table_.resize(rans_precision);
+    uint32_t cum_prob = 0;
+    for (uint32_t i = 0; i < num_symbols; ++i) {
+      const uint32_t prob = token_probs[i];
+      if (prob > rans_precision - cum_prob) {
+        return false;
+      }
+      const uint64_t entry = (static_cast<uint64_t>(cum_prob) << cum_shift) |
+                             (static_cast<uint64_t>(prob) << symbol_bits) | i;
+      for (uint32_t j = cum_prob; j < cum_prob + prob; ++j) {
+        lut_table_[j] = entry;
+      }
+      cum_prob += prob;
+    }
+    if (cum_prob != rans_precision) {
+      return false;
+    }
+    return true;
+  }
+
+  inline void fetch_sym(struct rans_dec_sym *out, uint32_t rem) const {
+    const uint64_t entry = lut_table_[rem];
+    out->val = static_cast<uint32_t>(entry & symbol_mask);
+    out->prob = static_cast<uint32_t>((entry >> symbol_bits) & prob_mask);
+    out->cum_prob = static_cast<uint32_t>(entry >> cum_shift);
+  }
+
+ private:
+  static constexpr int rans_precision = 1 << rans_precision_bits_t;
+  // Probabilities can be equal to |rans_precision| so they need one extra bit.
+  static constexpr int prob_bits = rans_precision_bits_t + 1;
+  static constexpr int symbol_bits = 64 - prob_bits - rans_precision_bits_t;
+  static constexpr int cum_shift = symbol_bits + prob_bits;
+  static constexpr uint64_t symbol_mask =
+      (static_cast<uint64_t>(1) << symbol_bits) - 1;
+  static constexpr uint64_t prob_mask =
+      (static_cast<uint64_t>(1) << prob_bits) - 1;
+  std::vector<uint64_t> lut_table_;
+};
+
+// Compact table that does not store an entry for each of the |rans_precision|
+// states. Instead, the states are split into buckets (at least as many as
+// there are symbols with non-zero probability) and for each bucket we store
+// the first symbol that covers the bucket. The decoded symbol is then found
+// with a short linear search over the symbols sorted by their cumulative
+// probabilities. The table stays small even for the largest precisions, which
+// makes it much more cache friendly than the tables above when the number of
+// precision bits is high.
+template <int rans_precision_bits_t>
+class RAnsBucketedLookUpTable {
+ public:
+  RAnsBucketedLookUpTable() : bucket_shift_(0) {}
+
+  inline bool build(const uint32_t token_probs[], uint32_t num_symbols) {
+    symbols_.clear();
+    uint32_t cum_prob = 0;
+    for (uint32_t i = 0; i < num_symbols; ++i) {
+      const uint32_t prob = token_probs[i];
+      if (prob == 0)
+        continue;
+      if (prob > rans_precision - cum_prob) {
+        return false;
+      }
+      rans_dec_sym sym;
+      sym.val = i;
+      sym.prob = prob;
+      sym.cum_prob = cum_prob;
+      symbols_.push_back(sym);
+      cum_prob += prob;
+    }
+    if (cum_prob != rans_precision) {
+      return false;
+    }
+    // Use the smallest number of buckets that is greater than or equal to the
+    // number of used symbols.
+    int bucket_bits = 0;
+    while (bucket_bits < rans_precision_bits_t &&
+           (1u << bucket_bits) < symbols_.size()) {
+      ++bucket_bits;
+    }
+    bucket_shift_ = rans_precision_bits_t - bucket_bits;
+    buckets_.resize(1 << bucket_bits);
+    uint32_t symbol_id = 0;
+    for (uint32_t b = 0; b < buckets_.size(); ++b) {
+      const uint32_t bucket_start = b << bucket_shift_;
+      while (symbols_[symbol_id].cum_prob + symbols_[symbol_id].prob <=
+             bucket_start) {
+        ++symbol_id;
+      }
+      buckets_[b] = symbol_id;
+    }
+    return true;
+  }
+
+  inline void fetch_sym(struct rans_dec_sym *out, uint32_t rem) const {
+    const rans_dec_sym *sym = &symbols_[buckets_[rem >> bucket_shift_]];
+    while (sym->cum_prob + sym->prob <= rem) {
+      ++sym;
+    }
+    *out = *sym;
+  }
+
+ private:
+  static constexpr int rans_precision = 1 << rans_precision_bits_t;
+  // Symbols with non-zero probability sorted by their cumulative probability.
+  std::vector<rans_dec_sym> symbols_;
+  // Index of the first symbol in |symbols_| for each bucket.
+  std::vector<uint32_t> buckets_;
+  int bucket_shift_;
+};
+
+// Lookup table used by default for the given number of precision bits. The
+// fused table is the fastest for small precisions where the whole table fits
+// into the cache. For precisions above 16 bits, the per-state tables exceed
+// the cache size and the bucketed table becomes faster.
+template <int rans_precision_bits_t>
+using RAnsLookUpTable = typename std::conditional<
+    (rans_precision_bits_t <= 15),
+    RAnsFusedLookUpTable<rans_precision_bits_t>,
+    typename std::conditional<
+        (rans_precision_bits_t <= 16),
+        RAnsDirectLookUpTable<rans_precision_bits_t>,
+        RAnsBucketedLookUpTable<rans_precision_bits_t>>::type>::type;
+
 // Class for performing rANS decoding using a desired number of precision bits.
 // The number of precision bits needs to be the same as with the RAnsEncoder
-// that was used to encode the input data.
-template <int rans_precision_bits_t>
+// that was used to encode the input data. |LookUpTableT| can be used to
+// override the default lookup table layout.
+template <int rans_precision_bits_t,
+          class LookUpTableT = RAnsLookUpTable<rans_precision_bits_t>>
 class RAnsDecoder {
  public:
   RAnsDecoder() {}
@@ -414,30 +704,13 @@ class RAnsDecoder {
   // number of bytes encoded by the encoder. A non zero return value is an
   // error.
   inline int read_init(const uint8_t *const buf, int offset) {
-    unsigned x;
     if (offset < 1)
       return 1;
     ans_.buf = buf;
-    x = buf[offset - 1] >> 6;
-    if (x == 0) {
-      ans_.buf_offset = offset - 1;
-      ans_.state = buf[offset - 1] & 0x3F;
-    } else if (x == 1) {
-      if (offset < 2)
-        return 1;
-      ans_.buf_offset = offset - 2;
-      ans_.state = mem_get_le16(buf + offset - 2) & 0x3FFF;
-    } else if (x == 2) {
-      if (offset < 3)
-        return 1;
-      ans_.buf_offset = offset - 3;
-      ans_.state = mem_get_le24(buf + offset - 3) & 0x3FFFFF;
-    } else if (x == 3) {
-      ans_.buf_offset = offset - 4;
-      ans_.state = mem_get_le32(buf + offset - 4) & 0x3FFFFFFF;
-    } else {
+    const int state_offset = rans_read_state(buf, offset, &ans_.state);
+    if (state_offset < 0)
       return 1;
-    }
+    ans_.buf_offset = state_offset;
     ans_.state += l_rans_base;
     if (ans_.state >= l_rans_base * DRACO_ANS_IO_BASE)
       return 1;
@@ -461,50 +734,129 @@ class RAnsDecoder {
     // division and modulo are going to be optimized by the compiler.
     quo = ans_.state / rans_precision;
     rem = ans_.state % rans_precision;
-    fetch_sym(&sym, rem);
+    lut_.fetch_sym(&sym, rem);
     ans_.state = quo * sym.prob + rem - sym.cum_prob;
     return sym.val;
   }
 
+  // Decodes |num_values| symbols into |out_values|.
+  inline void rans_read_symbols(uint32_t *out_values, int num_values) {
+    for (int i = 0; i < num_values; ++i) {
+      out_values[i] = rans_read();
+    }
+  }
+
   // Construct a lookup table with |rans_precision| number of entries.
   // Returns false if the table couldn't be built (because of wrong input data).
   inline bool rans_build_look_up_table(const uint32_t token_probs[],
                                        uint32_t num_symbols) {
-    lut_table_.resize(rans_precision);
-    probability_table_.resize(num_symbols);
-    uint32_t cum_prob = 0;
-    uint32_t act_prob = 0;
-    for (uint32_t i = 0; i < num_symbols; ++i) {
-      probability_table_[i].prob = token_probs[i];
-      probability_table_[i].cum_prob = cum_prob;
-      cum_prob += token_probs[i];
-      if (cum_prob > rans_precision) {
-        return false;
-      }
-      for (uint32_t j = act_prob; j < cum_prob; ++j) {
-        lut_table_[j] = i;
+    return lut_.build(token_probs, num_symbols);
+  }
+
+ private:
+  static constexpr int rans_precision = 1 << rans_precision_bits_t;
+  static constexpr int l_rans_base = rans_precision * 4;
+  LookUpTableT lut_;
+  AnsDecoder ans_;
+};
+
+// Class for decoding data encoded by RAnsInterleavedEncoder. The number of
+// precision bits and the number of states need to be the same as the ones used
+// by the encoder.
+template <int rans_precision_bits_t, int num_states_t,
+          class LookUpTableT = RAnsLookUpTable<rans_precision_bits_t>>
+class RAnsInterleavedDecoder {
+ public:
+  RAnsInterleavedDecoder() : buf_(nullptr), buf_offset_(0), state_id_(0) {}
+
+  // Initializes the decoder from the input buffer. The |offset| specifies the
+  // number of bytes encoded by the encoder. A non zero return value is an
+  // error.
+  inline int read_init(const uint8_t *const buf, int offset) {
+    if (offset < 1)
+      return 1;
+    buf_ = buf;
+    // The encoder stores the id of the first decoded state after the final
+    // values of all states.
+    state_id_ = buf[--offset];
+    if (state_id_ >= num_states_t)
+      return 1;
+    for (int i = num_states_t - 1; i >= 0; --i) {
+      offset = rans_read_state(buf, offset, &states_[i]);
+      if (offset < 0)
+        return 1;
+      states_[i] += l_rans_base;
+      if (states_[i] >= l_rans_base * DRACO_ANS_IO_BASE)
+        return 1;
+    }
+    buf_offset_ = offset;
+    return 0;
+  }
+
+  inline int read_end() {
+    for (int i = 0; i < num_states_t; ++i) {
+      if (states_[i] != l_rans_base)
+        return 0;
+    }
+    return 1;
+  }
+
+  inline int rans_read() {
+    const int state_id = state_id_;
+    state_id_ = (state_id == 0 ? num_states_t : state_id) - 1;
+    return rans_read_state_symbol(&states_[state_id]);
+  }
+
+  // Decodes |num_values| symbols into |out_values|. The symbols are decoded
+  // in rounds over all states. Symbols decoded within one round do not depend
+  // on each other, which lets the processor overlap their decoding.
+  inline void rans_read_symbols(uint32_t *out_values, int num_values) {
+    int i = 0;
+    // Decode symbols until the next round starts with the last state.
+    while (i < num_values && state_id_ != num_states_t - 1) {
+      out_values[i++] = rans_read();
+    }
+    for (; i + num_states_t <= num_values; i += num_states_t) {
+      for (int s = 0; s < num_states_t; ++s) {
+        out_values[i + s] =
+            rans_read_state_symbol(&states_[num_states_t - 1 - s]);
       }
-      act_prob = cum_prob;
     }
-    if (cum_prob != rans_precision) {
-      return false;
+    while (i < num_values) {
+      out_values[i++] = rans_read();
     }
-    return true;
+  }
+
+  // Construct a lookup table with |rans_precision| number of entries.
+  // Returns false if the table couldn't be built (because of wrong input data).
+  inline bool rans_build_look_up_table(const uint32_t token_probs[],
+                                       uint32_t num_symbols) {
+    return lut_.build(token_probs, num_symbols);
   }
 
  private:
-  inline void fetch_sym(struct rans_dec_sym *out, uint32_t rem) {
-    uint32_t symbol = lut_table_[rem];
-    out->val = symbol;
-    out->prob = probability_table_[symbol].prob;
-    out->cum_prob = probability_table_[symbol].cum_prob;
+  // Decodes one symbol from the given |state|.
+  inline int rans_read_state_symbol(uint32_t *state) {
+    struct rans_dec_sym sym;
+    uint32_t x = *state;
+    while (x < l_rans_base && buf_offset_ > 0) {
+      x = x * DRACO_ANS_IO_BASE + buf_[--buf_offset_];
+    }
+    const uint32_t quo = x / rans_precision;
+    const uint32_t rem = x % rans_precision;
+    lut_.fetch_sym(&sym, rem);
+    *state = quo * sym.prob + rem - sym.cum_prob;
+    return sym.val;
   }
 
   static constexpr int rans_precision = 1 << rans_precision_bits_t;
   static constexpr int l_rans_base = rans_precision * 4;
-  std::vector<uint32_t> lut_table_;
-  std::vector<rans_sym> probability_table_;
-  AnsDecoder ans_;
+  LookUpTableT lut_;
+  const uint8_t *buf_;
+  int buf_offset_;
+  uint32_t states_[num_states_t];
+  // Id of the state that is going to be used for the next decoded symbol.
+  int state_id_;
 };
 
 #undef DRACO_ANS_DIVREM
@@ -0,0 +1,138 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/entropy/ans.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "draco/compression/entropy/rans_symbol_coding.h"
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+// Encodes symbols from an alphabet of 2^|unique_symbols_bit_length_t| symbols
+// using rANS and checks that all lookup table layouts decode the same data.
+// Symbols are distributed similarly to prediction residuals, i.e., the
+// probability of a symbol decreases exponentially with its value.
+template <int unique_symbols_bit_length_t>
+class RAnsLookUpTableTester {
+ public:
+  static constexpr int rans_precision_bits =
+      draco::ComputeRAnsPrecisionFromUniqueSymbolsBitLength(
+          unique_symbols_bit_length_t);
+  static constexpr uint32_t rans_precision = 1u << rans_precision_bits;
+
+  explicit RAnsLookUpTableTester(int num_values) {
+    const uint32_t num_symbols = 1u << unique_symbols_bit_length_t;
+    // Compute the symbol probabilities. Every symbol gets at least probability
+    // of one.
+    std::vector<double> weights(num_symbols);
+    double total_weight = 0;
+    const double scale = std::max(1.0, num_symbols / 6.0);
+    for (uint32_t i = 0; i < num_symbols; ++i) {
+      weights[i] = std::exp(-static_cast<double>(i) / scale);
+      total_weight += weights[i];
+    }
+    probs_.resize(num_symbols);
+    uint32_t total_prob = 0;
+    for (uint32_t i = 0; i < num_symbols; ++i) {
+      probs_[i] = 1 + static_cast<uint32_t>(weights[i] / total_weight *
+                                            (rans_precision - num_symbols));
+      total_prob += probs_[i];
+    }
+    probs_[0] += rans_precision - total_prob;
+
+    std::vector<draco::rans_sym> syms(num_symbols);
+    std::vector<uint32_t> cum_probs(num_symbols);
+    uint32_t cum_prob = 0;
+    for (uint32_t i = 0; i < num_symbols; ++i) {
+      syms[i].prob = probs_[i];
+      syms[i].cum_prob = cum_prob;
+      cum_prob += probs_[i];
+      cum_probs[i] = cum_prob;
+    }
+
+    // Generate the symbols by sampling the states uniformly so the data
+    // follows the probabilities.
+    symbols_.resize(num_values);
+    uint32_t seed = 12345;
+    for (int i = 0; i < num_values; ++i) {
+      seed = seed * 1103515245u + 12345u;
+      const uint32_t state = (seed >> 8) & (rans_precision - 1);
+      symbols_[i] = static_cast<uint32_t>(
+          std::upper_bound(cum_probs.begin(), cum_probs.end(), state) -
+          cum_probs.begin());
+    }
+
+    // Encode the symbols.
+    data_.resize(4 * static_cast<size_t>(num_values) + 16);
+    draco::RAnsEncoder<rans_precision_bits> encoder;
+    encoder.write_init(data_.data());
+    for (int i = num_values - 1; i >= 0; --i) {
+      encoder.rans_write(&syms[symbols_[i]]);
+    }
+    data_size_ = encoder.write_end();
+  }
+
+  // Decodes the data using the given lookup table and checks that the decoded
+  // symbols match the encoded ones.
+  template <class LookUpTableT>
+  void DecodeUsingTable() {
+    draco::RAnsDecoder<rans_precision_bits, LookUpTableT> decoder;
+    EXPECT_TRUE(decoder.rans_build_look_up_table(
+        probs_.data(), static_cast<uint32_t>(probs_.size())));
+    EXPECT_EQ(decoder.read_init(data_.data(), data_size_), 0);
+    std::vector<uint32_t> decoded(symbols_.size());
+    decoder.rans_read_symbols(decoded.data(),
+                              static_cast<int>(decoded.size()));
+    EXPECT_EQ(symbols_, decoded);
+  }
+
+  void Run() {
+    DecodeUsingTable<draco::RAnsDirectLookUpTable<rans_precision_bits>>();
+    DecodeUsingTable<draco::RAnsFusedLookUpTable<rans_precision_bits>>();
+    DecodeUsingTable<draco::RAnsBucketedLookUpTable<rans_precision_bits>>();
+    DecodeUsingTable<draco::RAnsLookUpTable<rans_precision_bits>>();
+  }
+
+ private:
+  std::vector<uint32_t> probs_;
+  std::vector<uint32_t> symbols_;
+  std::vector<uint8_t> data_;
+  int data_size_;
+};
+
+// Runs the RAnsLookUpTableTester for all bit lengths up to |bit_length_t|.
+template <int bit_length_t>
+struct RunForAllBitLengths {
+  static void Run(int num_values) {
+    RunForAllBitLengths<bit_length_t - 1>::Run(num_values);
+    RAnsLookUpTableTester<bit_length_t>(num_values).Run();
+  }
+};
+
+template <>
+struct RunForAllBitLengths<0> {
+  static void Run(int) {}
+};
+
+// Maximum bit length used by the raw symbol decoder (see DecodeRawSymbols()).
+constexpr int kMaxRawSymbolBitLength = 18;
+
+TEST(RAnsLookUpTableTest, TestAllLayoutsDecodeSameSymbols) {
+  RunForAllBitLengths<kMaxRawSymbolBitLength>::Run(10000);
+}
+
+}  // namespace
@@ -21,6 +21,10 @@
 
 namespace draco {
 
+// Number of rANS states used by the interleaved rANS symbol coding (see
+// RAnsInterleavedSymbolEncoder and RAnsInterleavedSymbolDecoder).
+constexpr int kRAnsNumInterleavedStates = 4;
+
 // Computes the desired precision of the rANS method for the specified number of
 // unique symbols the input data (defined by their bit_length).
 constexpr int ComputeRAnsUnclampedPrecision(int symbols_bit_length) {
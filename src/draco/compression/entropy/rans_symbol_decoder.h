@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_ENTROPY_RANS_SYMBOL_DECODER_H_
 #define DRACO_COMPRESSION_ENTROPY_RANS_SYMBOL_DECODER_H_
 
+#include <type_traits>
+
 #include "draco/draco_features.h"
 
 #include "draco/compression/config/compression_shared.h"
@@ -26,12 +28,13 @@ namespace draco {
 
 // A helper class for decoding symbols using the rANS algorithm (see ans.h).
 // The class can be used to decode the probability table and the data encoded
-// by the RAnsSymbolEncoder. |unique_symbols_bit_length_t| must be the same as
-// the one used for the corresponding RAnsSymbolEncoder.
-template <int unique_symbols_bit_length_t>
-class RAnsSymbolDecoder {
+// by the RAnsSymbolEncoderBase. |unique_symbols_bit_length_t| and
+// |num_states_t| must be the same as the ones used for the corresponding
+// encoder. See RAnsSymbolDecoder and RAnsInterleavedSymbolDecoder below.
+template <int unique_symbols_bit_length_t, int num_states_t>
+class RAnsSymbolDecoderBase {
  public:
-  RAnsSymbolDecoder() : num_symbols_(0) {}
+  RAnsSymbolDecoderBase() : num_symbols_(0) {}
 
   // Initialize the decoder and decode the probability table.
   bool Create(DecoderBuffer *buffer);
@@ -42,6 +45,10 @@ class RAnsSymbolDecoder {
   // encoded data after this call.
   bool StartDecoding(DecoderBuffer *buffer);
   uint32_t DecodeSymbol() { return ans_.rans_read(); }
+  // Decodes |num_values| symbols at once into |out_values|.
+  void DecodeSymbols(int num_values, uint32_t *out_values) {
+    ans_.rans_read_symbols(out_values, num_values);
+  }
   void EndDecoding();
 
  private:
@@ -50,14 +57,30 @@ class RAnsSymbolDecoder {
           unique_symbols_bit_length_t);
   static constexpr int rans_precision_ = 1 << rans_precision_bits_;
 
+  typedef typename std::conditional<
+      num_states_t == 1, RAnsDecoder<rans_precision_bits_>,
+      RAnsInterleavedDecoder<rans_precision_bits_, num_states_t>>::type
+      AnsDecoderT;
+
   std::vector<uint32_t> probability_table_;
   uint32_t num_symbols_;
-  RAnsDecoder<rans_precision_bits_> ans_;
+  AnsDecoderT ans_;
 };
 
+// Decoder for symbols encoded by RAnsSymbolEncoder.
 template <int unique_symbols_bit_length_t>
-bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::Create(
-    DecoderBuffer *buffer) {
+class RAnsSymbolDecoder
+    : public RAnsSymbolDecoderBase<unique_symbols_bit_length_t, 1> {};
+
+// Decoder for symbols encoded by RAnsInterleavedSymbolEncoder.
+template <int unique_symbols_bit_length_t>
+class RAnsInterleavedSymbolDecoder
+    : public RAnsSymbolDecoderBase<unique_symbols_bit_length_t,
+                                   kRAnsNumInterleavedStates> {};
+
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolDecoderBase<unique_symbols_bit_length_t,
+                           num_states_t>::Create(DecoderBuffer *buffer) {
   // Check that the DecoderBuffer version is set.
   if (buffer->bitstream_version() == 0)
     return false;
@@ -116,9 +139,9 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::Create(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::StartDecoding(
-    DecoderBuffer *buffer) {
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolDecoderBase<unique_symbols_bit_length_t,
+                           num_states_t>::StartDecoding(DecoderBuffer *buffer) {
   uint64_t bytes_encoded;
   // Decode the number of bytes encoded by the encoder.
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
@@ -143,8 +166,9 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::StartDecoding(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-void RAnsSymbolDecoder<unique_symbols_bit_length_t>::EndDecoding() {
+template <int unique_symbols_bit_length_t, int num_states_t>
+void RAnsSymbolDecoderBase<unique_symbols_bit_length_t,
+                           num_states_t>::EndDecoding() {
   ans_.read_end();
 }
 
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <type_traits>
 
 #include "draco/compression/entropy/ans.h"
 #include "draco/compression/entropy/rans_symbol_coding.h"
@@ -29,10 +30,12 @@ namespace draco {
 // A helper class for encoding symbols using the rANS algorithm (see ans.h).
 // The class can be used to initialize and encode probability table needed by
 // rANS, and to perform encoding of symbols into the provided EncoderBuffer.
-template <int unique_symbols_bit_length_t>
-class RAnsSymbolEncoder {
+// |num_states_t| is the number of interleaved rANS states used to encode the
+// symbols. See RAnsSymbolEncoder and RAnsInterleavedSymbolEncoder below.
+template <int unique_symbols_bit_length_t, int num_states_t>
+class RAnsSymbolEncoderBase {
  public:
-  RAnsSymbolEncoder()
+  RAnsSymbolEncoderBase()
       : num_symbols_(0), num_expected_bits_(0), buffer_offset_(0) {}
 
   // Creates a probability table needed by the rANS library and encode it into
@@ -78,14 +81,35 @@ class RAnsSymbolEncoder {
   // Expected number of bits that is needed to encode the input.
   uint64_t num_expected_bits_;
 
-  RAnsEncoder<rans_precision_bits_> ans_;
+  typedef typename std::conditional<
+      num_states_t == 1, RAnsEncoder<rans_precision_bits_>,
+      RAnsInterleavedEncoder<rans_precision_bits_, num_states_t>>::type
+      AnsEncoderT;
+
+  AnsEncoderT ans_;
   // Initial offset of the encoder buffer before any ans data was encoded.
   uint64_t buffer_offset_;
 };
 
+// Encoder using a single rANS state.
+template <int unique_symbols_bit_length_t>
+class RAnsSymbolEncoder
+    : public RAnsSymbolEncoderBase<unique_symbols_bit_length_t, 1> {};
+
+// Encoder using kRAnsNumInterleavedStates interleaved rANS states. The encoded
+// data can be decoded faster than the data produced by RAnsSymbolEncoder, at
+// the cost of a few extra bytes needed to store the final state of each rANS
+// state.
 template <int unique_symbols_bit_length_t>
-bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::Create(
-    const uint64_t *frequencies, int num_symbols, EncoderBuffer *buffer) {
+class RAnsInterleavedSymbolEncoder
+    : public RAnsSymbolEncoderBase<unique_symbols_bit_length_t,
+                                   kRAnsNumInterleavedStates> {};
+
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolEncoderBase<unique_symbols_bit_length_t,
+                           num_states_t>::Create(const uint64_t *frequencies,
+                                                 int num_symbols,
+                                                 EncoderBuffer *buffer) {
   // Compute the total of the input frequencies.
   uint64_t total_freq = 0;
   int max_valid_symbol = 0;
@@ -192,9 +216,9 @@ bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::Create(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::EncodeTable(
-    EncoderBuffer *buffer) {
+template <int unique_symbols_bit_length_t, int num_states_t>
+bool RAnsSymbolEncoderBase<unique_symbols_bit_length_t,
+                           num_states_t>::EncodeTable(EncoderBuffer *buffer) {
   EncodeVarint(num_symbols_, buffer);
   // Use varint encoding for the probabilities (first two bits represent the
   // number of bytes used - 1).
@@ -240,11 +264,12 @@ bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::EncodeTable(
   return true;
 }
 
-template <int unique_symbols_bit_length_t>
-void RAnsSymbolEncoder<unique_symbols_bit_length_t>::StartEncoding(
-    EncoderBuffer *buffer) {
-  // Allocate extra storage just in case.
-  const uint64_t required_bits = 2 * num_expected_bits_ + 32;
+template <int unique_symbols_bit_length_t, int num_states_t>
+void RAnsSymbolEncoderBase<unique_symbols_bit_length_t,
+                           num_states_t>::StartEncoding(EncoderBuffer *buffer) {
+  // Allocate extra storage just in case (including the space for storing the
+  // final values of all rANS states).
+  const uint64_t required_bits = 2 * num_expected_bits_ + 40 * num_states_t;
 
   buffer_offset_ = buffer->size();
   const int64_t required_bytes = (required_bits + 7) / 8;
@@ -254,9 +279,9 @@ void RAnsSymbolEncoder<unique_symbols_bit_length_t>::StartEncoding(
   ans_.write_init(data + buffer_offset_);
 }
 
-template <int unique_symbols_bit_length_t>
-void RAnsSymbolEncoder<unique_symbols_bit_length_t>::EndEncoding(
-    EncoderBuffer *buffer) {
+template <int unique_symbols_bit_length_t, int num_states_t>
+void RAnsSymbolEncoderBase<unique_symbols_bit_length_t,
+                           num_states_t>::EndEncoding(EncoderBuffer *buffer) {
   char *const src = const_cast<char *>(buffer->data()) + buffer_offset_;
 
   // TODO(fgalligan): Look into changing this to uint32_t as write_end()
@@ -158,6 +158,40 @@ TEST_F(SymbolCodingTest, TestLargeNumberCondition) {
   }
 }
 
+TEST_F(SymbolCodingTest, TestInterleavedRawCoding) {
+  // This test verifies that the interleaved raw coding can decode inputs of
+  // any length, including inputs that do not use all of the interleaved rANS
+  // states equally.
+  std::vector<uint32_t> in;
+  for (int i = 0; i < 5000; ++i) {
+    in.push_back(100 + (i * 7919) % 13);
+  }
+  for (int num_values = 1; num_values < 5000; num_values += 333) {
+    Options options;
+    SetSymbolEncodingMethod(&options, SYMBOL_CODING_RAW_INTERLEAVED);
+    EncoderBuffer eb;
+    ASSERT_TRUE(EncodeSymbols(in.data(), num_values, 1, &options, &eb));
+
+    std::vector<uint32_t> out(num_values);
+    DecoderBuffer db;
+    db.Init(eb.data(), eb.size());
+    db.set_bitstream_version(bitstream_version_);
+    ASSERT_TRUE(DecodeSymbols(num_values, 1, &db, &out[0]));
+    ASSERT_EQ(eb.size(), static_cast<size_t>(db.decoded_size()));
+    for (int i = 0; i < num_values; ++i) {
+      ASSERT_EQ(in[i], out[i]);
+    }
+  }
+
+  // Check that the interleaved coding is used instead of the raw coding when
+  // it is allowed.
+  Options options;
+  SetSymbolEncodingInterleavedRawCoding(&options, true);
+  EncoderBuffer eb;
+  ASSERT_TRUE(EncodeSymbols(in.data(), in.size(), 1, &options, &eb));
+  ASSERT_EQ(SYMBOL_CODING_RAW_INTERLEAVED, eb.data()[0]);
+}
+
 TEST_F(SymbolCodingTest, TestConversionFullRange) {
   TestConvertToSymbolAndBack(static_cast<int8_t>(-128));
   TestConvertToSymbolAndBack(static_cast<int8_t>(-127));
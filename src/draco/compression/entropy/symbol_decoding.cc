@@ -43,6 +43,9 @@ bool DecodeSymbols(uint32_t num_values, int num_components,
   } else if (scheme == SYMBOL_CODING_RAW) {
     return DecodeRawSymbols<RAnsSymbolDecoder>(num_values, src_buffer,
                                                out_values);
+  } else if (scheme == SYMBOL_CODING_RAW_INTERLEAVED) {
+    return DecodeRawSymbols<RAnsInterleavedSymbolDecoder>(
+        num_values, src_buffer, out_values);
   }
   return false;
 }
@@ -93,11 +96,7 @@ bool DecodeRawSymbolsInternal(uint32_t num_values, DecoderBuffer *src_buffer,
 
   if (!decoder.StartDecoding(src_buffer))
     return false;
-  for (uint32_t i = 0; i < num_values; ++i) {
-    // Decode a symbol into the value.
-    const uint32_t value = decoder.DecodeSymbol();
-    out_values[i] = value;
-  }
+  decoder.DecodeSymbols(num_values, out_values);
   decoder.EndDecoding();
   return true;
 }
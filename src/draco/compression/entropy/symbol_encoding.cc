@@ -34,6 +34,10 @@ void SetSymbolEncodingMethod(Options *options, SymbolCodingMethod method) {
   options->SetInt("symbol_encoding_method", method);
 }
 
+void SetSymbolEncodingInterleavedRawCoding(Options *options, bool interleaved) {
+  options->SetBool("symbol_encoding_interleaved_raw_coding", interleaved);
+}
+
 bool SetSymbolEncodingCompressionLevel(Options *options,
                                        int compression_level) {
   if (compression_level < 0 || compression_level > 10)
@@ -147,6 +151,9 @@ bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
     if (tagged_scheme_total_bits < raw_scheme_total_bits ||
         max_value_bit_length > kMaxRawEncodingBitLength) {
       method = SYMBOL_CODING_TAGGED;
+    } else if (options != nullptr &&
+               options->GetBool("symbol_encoding_interleaved_raw_coding")) {
+      method = SYMBOL_CODING_RAW_INTERLEAVED;
     } else {
       method = SYMBOL_CODING_RAW;
     }
@@ -162,6 +169,11 @@ bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
                                                num_unique_symbols, options,
                                                target_buffer);
   }
+  if (method == SYMBOL_CODING_RAW_INTERLEAVED) {
+    return EncodeRawSymbols<RAnsInterleavedSymbolEncoder>(
+        symbols, num_values, max_value, num_unique_symbols, options,
+        target_buffer);
+  }
   // Unknown method selected.
   return false;
 }
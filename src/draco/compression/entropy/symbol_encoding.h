@@ -36,6 +36,13 @@ bool EncodeSymbols(const uint32_t *symbols, int num_values, int num_components,
 // method.
 void SetSymbolEncodingMethod(Options *options, SymbolCodingMethod method);
 
+// Sets an option that allows the symbol encoder to use the interleaved rANS
+// coding (SYMBOL_CODING_RAW_INTERLEAVED) whenever it would otherwise select
+// the SYMBOL_CODING_RAW method. The interleaved coding is faster to decode but
+// it produces slightly larger output and it cannot be decoded by older
+// versions of the Draco decoder.
+void SetSymbolEncodingInterleavedRawCoding(Options *options, bool interleaved);
+
 // Sets the desired compression level for symbol encoding in range <0, 10> where
 // 0 is the worst but fastest compression and 10 is the best but slowest
 // compression. If the option is not set, default value of 7 is used.
@@ -14,8 +14,10 @@
 //
 #include "draco/compression/expert_encode.h"
 
+#include "draco/compression/chunked_mesh_encode.h"
 #include "draco/compression/mesh/mesh_edgebreaker_encoder.h"
 #include "draco/compression/mesh/mesh_sequential_encoder.h"
+#include "draco/metadata/metadata_encoder.h"
 #ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
 #include "draco/compression/point_cloud/point_cloud_kd_tree_encoder.h"
 #include "draco/compression/point_cloud/point_cloud_sequential_encoder.h"
@@ -38,6 +40,73 @@ Status ExpertEncoder::EncodeToBuffer(EncoderBuffer *out_buffer) {
   return EncodeMeshToBuffer(*mesh_, out_buffer);
 }
 
+size_t ExpertEncoder::EstimateEncodedSize() const {
+  if (point_cloud_ == nullptr)
+    return 0;
+  const PointCloud &pc = *point_cloud_;
+  const size_t num_points = pc.num_points();
+  // Draco header, encoder specific header and the attribute encoder headers.
+  constexpr size_t kHeaderSize = 64;
+  size_t size = kHeaderSize;
+  if (pc.GetMetadata()) {
+    // The metadata is stored as is, so its size is computed exactly.
+    EncoderBuffer metadata_buffer;
+    MetadataEncoder metadata_encoder;
+    if (metadata_encoder.EncodeGeometryMetadata(&metadata_buffer,
+                                                pc.GetMetadata()))
+      size += metadata_buffer.size();
+  }
+  if (mesh_ == nullptr) {
+    // Point clouds may be encoded with the kD-tree encoder that stores the
+    // state of up to 32 rANS bit coders and 3 direct bit coders (about 6 and 8
+    // bytes each) regardless of the number of points.
+    constexpr size_t kKdTreeCodersSize = 256;
+    size += kKdTreeCodersSize;
+  } else {
+    const size_t num_faces = mesh_->num_faces();
+    const int num_chunks = options().GetGlobalInt("num_encoding_chunks", 1);
+    if (num_chunks > 1) {
+      // Headers of the individual chunks.
+      size += kHeaderSize * num_chunks * (1 + pc.num_attributes());
+    }
+    // Connectivity. The sequential encoder stores at most four bytes for
+    // each vertex index (the Edgebreaker connectivity is always smaller).
+    int index_size = 4;
+    if (num_points < (1 << 8)) {
+      index_size = 1;
+    } else if (num_points < (1 << 16)) {
+      index_size = 2;
+    }
+    size += 3 * num_faces * index_size;
+  }
+  for (int i = 0; i < pc.num_attributes(); ++i) {
+    const PointAttribute *const att = pc.attribute(i);
+    // Some encoders (e.g. Edgebreaker) can split attribute values on
+    // non-manifold vertices and attribute seams. Account for that.
+    const size_t num_entries = num_points + num_points / 8;
+    int num_components = att->num_components();
+    int64_t bits_per_component = DataTypeLength(att->data_type()) * 8;
+    const int quantization_bits =
+        options().GetAttributeInt(i, "quantization_bits", -1);
+    if (att->data_type() == DT_FLOAT32 && quantization_bits > 0) {
+      bits_per_component = quantization_bits + 1;  // Including the sign.
+      if (att->attribute_type() == GeometryAttribute::NORMAL)
+        num_components = 2;  // Octahedral coordinates.
+      // Quantization parameters.
+      size += sizeof(float) * (att->num_components() + 1) + 1;
+    }
+    // Encoded values, prediction scheme data (e.g. orientation bits) and the
+    // attribute header. The header holds the attribute description (at most
+    // 9 bytes), the sequential encoder and prediction scheme ids, the bounds
+    // of the prediction transform (8 bytes) and the header of the entropy
+    // coder, whose probability table is assumed to fit into the remaining
+    // space together with the values.
+    size += (num_entries * num_components * bits_per_component + 7) / 8;
+    size += num_entries / 8 + kHeaderSize;
+  }
+  return size;
+}
+
 Status ExpertEncoder::EncodePointCloudToBuffer(const PointCloud &pc,
                                                EncoderBuffer *out_buffer) {
 #ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
@@ -97,6 +166,16 @@ Status ExpertEncoder::EncodePointCloudToBuffer(const PointCloud &pc,
 
 Status ExpertEncoder::EncodeMeshToBuffer(const Mesh &m,
                                          EncoderBuffer *out_buffer) {
+  if (options().GetGlobalInt("num_encoding_chunks", 1) > 1) {
+    size_t num_encoded_points = 0;
+    size_t num_encoded_faces = 0;
+    DRACO_RETURN_IF_ERROR(EncodeMeshInChunks(m, options(), out_buffer,
+                                             &num_encoded_points,
+                                             &num_encoded_faces));
+    set_num_encoded_points(num_encoded_points);
+    set_num_encoded_faces(num_encoded_faces);
+    return OkStatus();
+  }
   std::unique_ptr<MeshEncoder> encoder;
   // Select the encoding method only based on the provided options.
   int encoding_method = options().GetGlobalInt("encoding_method", -1);
@@ -157,6 +236,23 @@ void ExpertEncoder::SetEncodingMethod(int encoding_method) {
   Base::SetEncodingMethod(encoding_method);
 }
 
+void ExpertEncoder::SetMeshChunking(int num_chunks, int num_threads) {
+  Base::SetMeshChunking(num_chunks, num_threads);
+}
+
+void ExpertEncoder::SetSplitMeshChunksOnComponents(bool split_on_components) {
+  Base::SetSplitMeshChunksOnComponents(split_on_components);
+}
+
+void ExpertEncoder::SetRandomAccessBlockSize(int block_size) {
+  Base::SetRandomAccessBlockSize(block_size);
+}
+
+void ExpertEncoder::SetPredictionSchemeSelectionByTrial(bool enabled,
+                                                        int num_threads) {
+  Base::SetPredictionSchemeSelectionByTrial(enabled, num_threads);
+}
+
 void ExpertEncoder::SetEncodingSubmethod(int encoding_submethod) {
   Base::SetEncodingSubmethod(encoding_submethod);
 }
@@ -40,6 +40,17 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
   // Encodes the geometry provided in the constructor to the target buffer.
   Status EncodeToBuffer(EncoderBuffer *out_buffer);
 
+  // Returns a conservative estimate of the size of the encoded geometry in
+  // bytes, computed from the number of points, faces and attribute values,
+  // from the size of the metadata and from the current options (such as the
+  // quantization bits). The estimate is meant to be used for pre-allocation
+  // of the output buffer (see EncoderBuffer::Reserve() and
+  // EncoderBuffer::SetArena()). It assumes that the entropy coded attribute
+  // values are not larger than the quantized values, which holds for all
+  // real-world inputs but can't be guaranteed for adversarial ones, so the
+  // encoded data may still outgrow the arena in rare cases.
+  size_t EstimateEncodedSize() const;
+
   // Set encoder options used during the geometry encoding. Note that this call
   // overwrites any modifications to the options done with the functions below.
   void Reset(const EncoderOptions &options);
@@ -100,6 +111,39 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
   // call of EncodePointCloudToBuffer or EncodeMeshToBuffer is going to fail.
   void SetEncodingMethod(int encoding_method);
 
+  // Splits input meshes into |num_chunks| spatially coherent chunks that are
+  // encoded independently of each other on |num_threads| worker threads
+  // (zero threads encodes all chunks on the calling thread). Chunked meshes
+  // can be decoded in parallel at the cost of a slightly lower compression
+  // rate. Values of |num_chunks| <= 1 disable the chunking (default).
+  // See compression/chunked_mesh_encode.h for more details.
+  void SetMeshChunking(int num_chunks, int num_threads);
+
+  // When set, the chunks of SetMeshChunking() are formed by whole connected
+  // components of the input mesh instead of spatial regions. No vertex is
+  // then shared between chunks, which avoids the duplicated boundary vertices
+  // and the stitching during decoding. Useful for meshes made of many
+  // disconnected parts. The number of chunks is limited by the number of
+  // components.
+  void SetSplitMeshChunksOnComponents(bool split_on_components);
+
+  // Sets the number of faces and points in blocks of meshes encoded with
+  // MESH_SEQUENTIAL_ENCODING. Each block of faces and each block of attribute
+  // values is compressed independently, which allows decoding of any range of
+  // faces without decoding the rest of the mesh (see
+  // Decoder::DecodeFaceRange()). Smaller blocks make the partial decoding
+  // cheaper at the cost of worse compression. Default is 0 (no blocks).
+  void SetRandomAccessBlockSize(int block_size);
+
+  // When enabled, the encoder selects the prediction scheme of every attribute
+  // that has no explicitly set scheme (see SetAttributePredictionScheme()) by
+  // computing the corrections of all applicable schemes and estimating their
+  // entropy. The scheme with the smallest estimated size is used. The
+  // candidate schemes are evaluated on |num_threads| worker threads (zero
+  // threads evaluates them on the calling thread). Improves the compression
+  // rate at the cost of slower encoding. Default is disabled.
+  void SetPredictionSchemeSelectionByTrial(bool enabled, int num_threads);
+
   // Sets the desired encoding submethod, only for MESH_EDGEBREAKER_ENCODING.
   // Valid values for |encoding_submethod| are:
   //   MESH_EDGEBREAKER_STANDARD_ENCODING
@@ -24,12 +24,26 @@ Status MeshDecoder::Decode(const DecoderOptions &options,
   return PointCloudDecoder::Decode(options, in_buffer, out_mesh);
 }
 
+Status MeshDecoder::StartDecoding(const DecoderOptions &options,
+                                  DecoderBuffer *in_buffer, Mesh *out_mesh) {
+  mesh_ = out_mesh;
+  return PointCloudDecoder::StartDecoding(options, in_buffer, out_mesh);
+}
+
 bool MeshDecoder::DecodeGeometryData() {
   if (mesh_ == nullptr)
     return false;
+  prediction_topology_cache_.Clear();
   if (!DecodeConnectivity())
     return false;
   return PointCloudDecoder::DecodeGeometryData();
 }
 
+bool MeshDecoder::DecodeAllAttributes() {
+  const bool decoded = PointCloudDecoder::DecodeAllAttributes();
+  // The topology is not needed after the prediction schemes are reverted.
+  prediction_topology_cache_.Clear();
+  return decoded;
+}
+
 }  // namespace draco
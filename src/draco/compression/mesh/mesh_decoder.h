@@ -16,6 +16,7 @@
 #define DRACO_COMPRESSION_MESH_MESH_DECODER_H_
 
 #include "draco/compression/attributes/mesh_attribute_indices_encoding_data.h"
+#include "draco/compression/attributes/prediction_schemes/mesh_prediction_scheme_topology.h"
 #include "draco/compression/point_cloud/point_cloud_decoder.h"
 #include "draco/mesh/mesh.h"
 #include "draco/mesh/mesh_attribute_corner_table.h"
@@ -36,6 +37,11 @@ class MeshDecoder : public PointCloudDecoder {
   Status Decode(const DecoderOptions &options, DecoderBuffer *in_buffer,
                 Mesh *out_mesh);
 
+  // The first stage of the staged decoding of meshes. See
+  // PointCloudDecoder::StartDecoding().
+  Status StartDecoding(const DecoderOptions &options, DecoderBuffer *in_buffer,
+                       Mesh *out_mesh);
+
   // Returns the base connectivity of the decoded mesh (or nullptr if it is not
   // initialized).
   virtual const CornerTable *GetCornerTable() const { return nullptr; }
@@ -55,12 +61,23 @@ class MeshDecoder : public PointCloudDecoder {
 
   Mesh *mesh() const { return mesh_; }
 
+  // Returns the cache of the topology shared by the mesh prediction schemes of
+  // all attributes. The cache is cleared once all attributes are decoded.
+  MeshPredictionSchemeTopologyCache *prediction_topology_cache() const {
+    return &prediction_topology_cache_;
+  }
+
  protected:
   bool DecodeGeometryData() override;
+  bool DecodeAllAttributes() override;
   virtual bool DecodeConnectivity() = 0;
 
  private:
   Mesh *mesh_;
+  // The topology is computed when the prediction schemes are created, which
+  // happens on the decoding thread even when the attributes are finalized in
+  // parallel.
+  mutable MeshPredictionSchemeTopologyCache prediction_topology_cache_;
 };
 
 }  // namespace draco
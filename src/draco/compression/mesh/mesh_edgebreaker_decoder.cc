@@ -19,7 +19,7 @@
 
 namespace draco {
 
-MeshEdgebreakerDecoder::MeshEdgebreakerDecoder() {}
+MeshEdgebreakerDecoder::MeshEdgebreakerDecoder() : impl_type_(-1) {}
 
 bool MeshEdgebreakerDecoder::CreateAttributesDecoder(int32_t att_decoder_id) {
   return impl_->CreateAttributesDecoder(att_decoder_id);
@@ -29,7 +29,13 @@ bool MeshEdgebreakerDecoder::InitializeDecoder() {
   uint8_t traversal_decoder_type;
   if (!buffer()->Decode(&traversal_decoder_type))
     return false;
+  if (impl_ && impl_type_ == traversal_decoder_type) {
+    // Reuse the existing implementation together with all its allocated
+    // memory.
+    return impl_->Init(this);
+  }
   impl_ = nullptr;
+  impl_type_ = -1;
   if (traversal_decoder_type == MESH_EDGEBREAKER_STANDARD_ENCODING) {
 #ifdef DRACO_STANDARD_EDGEBREAKER_SUPPORTED
     impl_ = std::unique_ptr<MeshEdgebreakerDecoderImplInterface>(
@@ -51,6 +57,7 @@ bool MeshEdgebreakerDecoder::InitializeDecoder() {
   if (!impl_) {
     return false;
   }
+  impl_type_ = traversal_decoder_type;
   if (!impl_->Init(this))
     return false;
   return true;
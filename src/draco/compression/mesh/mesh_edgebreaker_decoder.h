@@ -48,6 +48,8 @@ class MeshEdgebreakerDecoder : public MeshDecoder {
   bool OnAttributesDecoded() override;
 
   std::unique_ptr<MeshEdgebreakerDecoderImplInterface> impl_;
+  // Traversal decoder type of |impl_| or -1 when |impl_| is not set.
+  int impl_type_;
 };
 
 }  // namespace draco
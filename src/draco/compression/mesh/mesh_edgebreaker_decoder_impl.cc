@@ -229,7 +229,6 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::CreateAttributesDecoder(
 template <class TraversalDecoder>
 bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
   num_new_vertices_ = 0;
-  new_to_parent_vertex_map_.clear();
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
   if (decoder_->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 2)) {
     uint32_t num_new_verts;
@@ -270,10 +269,13 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
     if (!DecodeVarint(&num_faces, decoder_->buffer()))
       return false;
   }
-  if (num_faces > std::numeric_limits<CornerIndex::ValueType>::max() / 3)
+  // All corners must be addressable with the geometry indices of this build
+  // (see geometry_indices.h).
+  if (num_faces > kMaxGeometryIndexCount / 3)
     return false;  // Draco cannot handle this many faces.
 
-  if (static_cast<uint32_t>(num_encoded_vertices_) > num_faces * 3) {
+  if (static_cast<uint64_t>(num_encoded_vertices) >
+      static_cast<uint64_t>(num_faces) * 3) {
     return false;  // There cannot be more vertices than 3 * num_faces.
   }
   uint8_t num_attribute_data;
@@ -324,12 +326,17 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
   if (num_encoded_split_symbols > num_encoded_symbols) {
     return false;  // Split symbols are a sub-set of all symbols.
   }
+  // Each split symbol can create one extra vertex during the decoding.
+  if (static_cast<uint64_t>(num_encoded_vertices) + num_encoded_split_symbols >
+      static_cast<uint64_t>(kMaxGeometryIndexCount))
+    return false;
 
   // Decode topology (connectivity).
   vertex_traversal_length_.clear();
-  corner_table_ = std::unique_ptr<CornerTable>(new CornerTable());
+  // The corner table and the other data structures are reused when the
+  // decoder is used for multiple meshes (see DecoderContext).
   if (corner_table_ == nullptr)
-    return false;
+    corner_table_ = std::unique_ptr<CornerTable>(new CornerTable());
   processed_corner_ids_.clear();
   processed_corner_ids_.reserve(num_faces);
   processed_connectivity_corners_.clear();
@@ -343,9 +350,14 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
   last_face_id_ = -1;
   last_vert_id_ = -1;
 
-  attribute_data_.clear();
   // Add one attribute data for each attribute decoder.
   attribute_data_.resize(num_attribute_data);
+  for (AttributeData &data : attribute_data_) {
+    data.decoder_id = -1;
+    data.is_connectivity_used = true;
+    data.attribute_seam_corners.clear();
+  }
+  pos_data_decoder_id_ = -1;
 
   if (!corner_table_->Reset(num_faces,
                             num_encoded_vertices_ + num_encoded_split_symbols))
@@ -400,7 +412,8 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
   if (!traversal_decoder_.Start(&traversal_end_buffer))
     return false;
 
-  const int num_connectivity_verts = DecodeConnectivity(num_encoded_symbols);
+  const GeometryIndexCountType num_connectivity_verts =
+      DecodeConnectivity(num_encoded_symbols);
   if (num_connectivity_verts == -1)
     return false;
 
@@ -436,17 +449,22 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
   }
   traversal_decoder_.Done();
 
+  if (decoder_->options()->GetGlobalBool("decode_connectivity_only", false)) {
+    // Attributes are not going to be decoded so we only need to create the
+    // faces. The attribute connectivity is needed only when the points must
+    // be split on attribute seams.
+    if (HasAttributeSeams())
+      CreateAttributeConnectivity();
+    if (!AssignPointsToCorners(num_connectivity_verts))
+      return false;
+    // Release the connectivity data that is not needed anymore.
+    corner_table_.reset();
+    return true;
+  }
+
   // Decode attribute connectivity.
   // Prepare data structure for decoding non-position attribute connectivity.
-  for (uint32_t i = 0; i < attribute_data_.size(); ++i) {
-    attribute_data_[i].connectivity_data.InitEmpty(corner_table_.get());
-    // Add all seams.
-    for (int32_t c : attribute_data_[i].attribute_seam_corners) {
-      attribute_data_[i].connectivity_data.AddSeamEdge(CornerIndex(c));
-    }
-    // Recompute vertices from the newly added seam edges.
-    attribute_data_[i].connectivity_data.RecomputeVertices(nullptr, nullptr);
-  }
+  CreateAttributeConnectivity();
 
   pos_encoding_data_.Init(corner_table_->num_vertices());
   for (uint32_t i = 0; i < attribute_data_.size(); ++i) {
@@ -471,8 +489,9 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::OnAttributesDecoded() {
 }
 
 template <class TraversalDecoder>
-int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
-    int num_symbols) {
+GeometryIndexCountType
+MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
+    GeometryIndexCountType num_symbols) {
   // Algorithm does the reverse decoding of the symbols encoded with the
   // edgebreaker method. The reverse decoding always keeps track of the active
   // edge identified by its opposite corner (active corner). New faces are
@@ -483,22 +502,30 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
   // decoder always processes only the latest active edge. TOPOLOGY_S then
   // removes the top edge from the stack and TOPOLOGY_E adds a new edge to the
   // stack.
-  std::vector<CornerIndex> active_corner_stack;
+  // All containers are stored as member variables so that their memory is
+  // reused when the decoder is used for multiple meshes.
+  std::vector<CornerIndex> &active_corner_stack = corner_traversal_stack_;
+  active_corner_stack.clear();
 
   // Additional active edges may be added as a result of topology split events.
   // They can be added in arbitrary order, but we always know the split symbol
   // id they belong to, so we can address them using this symbol id.
-  std::unordered_map<int, CornerIndex> topology_split_active_corners;
+  std::vector<CornerIndex> &topology_split_active_corners =
+      topology_split_active_corners_;
+  topology_split_active_corners.assign(num_symbols, kInvalidCornerIndex);
 
   // Vector used for storing vertices that were marked as isolated during the
   // decoding process. Currently used only when the mesh doesn't contain any
   // non-position connectivity data.
-  std::vector<VertexIndex> invalid_vertices;
+  std::vector<VertexIndex> &invalid_vertices = invalid_vertices_;
+  invalid_vertices.clear();
   const bool remove_invalid_vertices = attribute_data_.empty();
 
-  int max_num_vertices = static_cast<int>(is_vert_hole_.size());
-  int num_faces = 0;
-  for (int symbol_id = 0; symbol_id < num_symbols; ++symbol_id) {
+  const GeometryIndexCountType max_num_vertices =
+      static_cast<GeometryIndexCountType>(is_vert_hole_.size());
+  GeometryIndexCountType num_faces = 0;
+  for (GeometryIndexCountType symbol_id = 0; symbol_id < num_symbols;
+       ++symbol_id) {
     const FaceIndex face(num_faces++);
     // Used to flag cases where we need to look for topology split events.
     bool check_topology_split = false;
@@ -621,10 +648,10 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
 
       // Corner "a" can correspond either to a normal active edge, or to an edge
       // created from the topology split event.
-      const auto it = topology_split_active_corners.find(symbol_id);
-      if (it != topology_split_active_corners.end()) {
+      const CornerIndex split_corner = topology_split_active_corners[symbol_id];
+      if (split_corner != kInvalidCornerIndex) {
         // Topology split event. Move the retrieved edge to the stack.
-        active_corner_stack.push_back(it->second);
+        active_corner_stack.push_back(split_corner);
       }
       if (active_corner_stack.empty())
         return -1;
@@ -708,12 +735,14 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
       // corresponding TOPOLOGY_S event is decoded.
 
       // Symbol id used by the encoder (reverse).
-      const int encoder_symbol_id = num_symbols - symbol_id - 1;
+      const GeometryIndexCountType encoder_symbol_id =
+          num_symbols - symbol_id - 1;
       EdgeFaceName split_edge;
-      int encoder_split_symbol_id;
+      GeometryIndexCountType encoder_split_symbol_id;
       while (IsTopologySplit(encoder_symbol_id, &split_edge,
                              &encoder_split_symbol_id)) {
-        if (encoder_split_symbol_id < 0)
+        if (encoder_split_symbol_id < 0 ||
+            encoder_split_symbol_id >= num_symbols)
           return -1;  // Wrong split symbol id.
         // Symbol was part of a topology split. Now we need to determine which
         // edge should be added to the active edges stack.
@@ -735,7 +764,7 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
         }
         // Add the new active edge.
         // Convert the encoder split symbol id to decoder symbol id.
-        const int decoder_split_symbol_id =
+        const GeometryIndexCountType decoder_split_symbol_id =
             num_symbols - encoder_split_symbol_id - 1;
         topology_split_active_corners[decoder_split_symbol_id] =
             new_active_corner;
@@ -820,7 +849,7 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
   if (num_faces != corner_table_->num_faces())
     return -1;  // Unexpected number of decoded faces.
 
-  int num_vertices = corner_table_->num_vertices();
+  GeometryIndexCountType num_vertices = corner_table_->num_vertices();
   // If any vertex was marked as isolated, we want to remove it from the corner
   // table to ensure that all vertices in range <0, num_vertices> are valid.
   for (const VertexIndex invalid_vert : invalid_vertices) {
@@ -1021,9 +1050,23 @@ bool MeshEdgebreakerDecoderImpl<
   return true;
 }
 
+template <class TraversalDecoder>
+void MeshEdgebreakerDecoderImpl<TraversalDecoder>::
+    CreateAttributeConnectivity() {
+  for (uint32_t i = 0; i < attribute_data_.size(); ++i) {
+    attribute_data_[i].connectivity_data.InitEmpty(corner_table_.get());
+    // Add all seams.
+    for (int32_t c : attribute_data_[i].attribute_seam_corners) {
+      attribute_data_[i].connectivity_data.AddSeamEdge(CornerIndex(c));
+    }
+    // Recompute vertices from the newly added seam edges.
+    attribute_data_[i].connectivity_data.RecomputeVertices(nullptr, nullptr);
+  }
+}
+
 template <class TraversalDecoder>
 bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::AssignPointsToCorners(
-    int num_connectivity_verts) {
+    GeometryIndexCountType num_connectivity_verts) {
   // Map between the existing and deduplicated point ids.
   // Note that at this point we have one point id for each corner of the
   // mesh so there is corner_table_->num_corners() point ids.
@@ -1037,23 +1080,49 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::AssignPointsToCorners(
       const CornerIndex start_corner(3 * f.value());
       for (int c = 0; c < 3; ++c) {
         // Get the vertex index on the corner and use it as a point index.
-        const int32_t vert_id = corner_table_->Vertex(start_corner + c).value();
-        face[c] = vert_id;
+        face[c] = corner_table_->Vertex(start_corner + c).value();
       }
       decoder_->mesh()->SetFace(f, face);
     }
     decoder_->point_cloud()->set_num_points(num_connectivity_verts);
     return true;
   }
+  if (!HasAttributeSeams()) {
+    // There are no attribute seams so every vertex attached to a face is
+    // mapped to exactly one point. Vertices isolated by the decoding of
+    // TOPOLOGY_S symbols are skipped.
+    std::vector<GeometryIndexValueType> vertex_to_point_map(
+        corner_table_->num_vertices(), 0);
+    GeometryIndexValueType num_points = 0;
+    for (VertexIndex v(0); v < corner_table_->num_vertices(); ++v) {
+      if (!corner_table_->IsVertexIsolated(v))
+        vertex_to_point_map[v.value()] = num_points++;
+    }
+    for (FaceIndex f(0); f < decoder_->mesh()->num_faces(); ++f) {
+      Mesh::Face face;
+      const CornerIndex start_corner(3 * f.value());
+      for (int c = 0; c < 3; ++c) {
+        const VertexIndex vert_id = corner_table_->Vertex(start_corner + c);
+        if (vert_id.value() >= vertex_to_point_map.size())
+          return false;
+        face[c] = vertex_to_point_map[vert_id.value()];
+      }
+      decoder_->mesh()->SetFace(f, face);
+    }
+    decoder_->point_cloud()->set_num_points(num_points);
+    return true;
+  }
+
   // Else we need to deduplicate multiple attributes.
 
   // Map between point id and an associated corner id. Only one corner for
   // each point is stored. The corners are used to sample the attribute values
   // in the last stage of the deduplication.
-  std::vector<int32_t> point_to_corner_map;
+  std::vector<GeometryIndexValueType> point_to_corner_map;
   // Map between every corner and their new point ids.
-  std::vector<int32_t> corner_to_point_map(corner_table_->num_corners());
-  for (int v = 0; v < corner_table_->num_vertices(); ++v) {
+  std::vector<GeometryIndexValueType> corner_to_point_map(
+      corner_table_->num_corners());
+  for (GeometryIndexCountType v = 0; v < corner_table_->num_vertices(); ++v) {
     CornerIndex c = corner_table_->LeftMostCorner(VertexIndex(v));
     if (c == kInvalidCornerIndex)
       continue;  // Isolated vertex.
@@ -1099,7 +1168,7 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::AssignPointsToCorners(
     c = deduplication_first_corner;
     // Create a new point.
     corner_to_point_map[c.value()] =
-        static_cast<uint32_t>(point_to_corner_map.size());
+        static_cast<GeometryIndexValueType>(point_to_corner_map.size());
     point_to_corner_map.push_back(c.value());
     // Traverse in CW direction.
     CornerIndex prev_c = c;
@@ -1117,7 +1186,7 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::AssignPointsToCorners(
       }
       if (attribute_seam) {
         corner_to_point_map[c.value()] =
-            static_cast<uint32_t>(point_to_corner_map.size());
+            static_cast<GeometryIndexValueType>(point_to_corner_map.size());
         point_to_corner_map.push_back(c.value());
       } else {
         corner_to_point_map[c.value()] = corner_to_point_map[prev_c.value()];
@@ -1136,7 +1205,7 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::AssignPointsToCorners(
     decoder_->mesh()->SetFace(f, face);
   }
   decoder_->point_cloud()->set_num_points(
-      static_cast<uint32_t>(point_to_corner_map.size()));
+      static_cast<GeometryIndexValueType>(point_to_corner_map.size()));
   return true;
 }
 
@@ -15,8 +15,8 @@
 #ifndef DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_DECODER_IMPL_H_
 #define DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_DECODER_IMPL_H_
 
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
+
 #include "draco/compression/mesh/traverser/mesh_traversal_sequencer.h"
 
 #include "draco/draco_features.h"
@@ -76,19 +76,20 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
 
   // Decodes connectivity between vertices (vertex indices).
   // Returns the number of vertices created by the decoder or -1 on error.
-  int DecodeConnectivity(int num_symbols);
+  GeometryIndexCountType DecodeConnectivity(GeometryIndexCountType num_symbols);
 
   // Returns true if the current symbol was part of a topology split event. This
   // means that the current face was connected to the left edge of a face
   // encoded with the TOPOLOGY_S symbol. |out_symbol_edge| can be used to
   // identify which edge of the source symbol was connected to the TOPOLOGY_S
   // symbol.
-  bool IsTopologySplit(int encoder_symbol_id, EdgeFaceName *out_face_edge,
-                       int *out_encoder_split_symbol_id) {
+  bool IsTopologySplit(GeometryIndexCountType encoder_symbol_id,
+                       EdgeFaceName *out_face_edge,
+                       GeometryIndexCountType *out_encoder_split_symbol_id) {
     if (topology_split_data_.size() == 0)
       return false;
     if (topology_split_data_.back().source_symbol_id >
-        static_cast<uint32_t>(encoder_symbol_id)) {
+        static_cast<uint64_t>(encoder_symbol_id)) {
       // Something is wrong; if the desired source symbol is greater than the
       // current encoder_symbol_id, we missed it, or the input was tampered
       // (|encoder_symbol_id| keeps decreasing).
@@ -119,13 +120,20 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
 #endif
   bool DecodeAttributeConnectivitiesOnFace(CornerIndex corner);
 
+  // Creates the connectivity of all non-position attributes from the decoded
+  // attribute seams.
+  void CreateAttributeConnectivity();
+
   // Initializes mapping between corners and point ids.
-  bool AssignPointsToCorners(int num_connectivity_verts);
+  bool AssignPointsToCorners(GeometryIndexCountType num_connectivity_verts);
 
-  bool IsFaceVisited(CornerIndex corner_id) const {
-    if (corner_id < 0)
-      return true;  // Invalid corner signalizes that the face does not exist.
-    return visited_faces_[corner_table_->Face(corner_id).value()];
+  // Returns true if any of the non-position attributes has a seam.
+  bool HasAttributeSeams() const {
+    for (const AttributeData &data : attribute_data_) {
+      if (!data.attribute_seam_corners.empty())
+        return true;
+    }
+    return false;
   }
 
   void SetOppositeCorners(CornerIndex corner_0, CornerIndex corner_1) {
@@ -146,6 +154,14 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
   // memory overflow when compressing huge meshes.
   std::vector<CornerIndex> corner_traversal_stack_;
 
+  // Active corners created by topology split events, indexed by the id of the
+  // split symbol. Symbols without a topology split event are mapped to
+  // kInvalidCornerIndex.
+  std::vector<CornerIndex> topology_split_active_corners_;
+
+  // Vertices that were marked as isolated during the connectivity decoding.
+  std::vector<VertexIndex> invalid_vertices_;
+
   // Array stores the number of visited visited for each mesh traversal.
   std::vector<int> vertex_traversal_length_;
 
@@ -170,24 +186,18 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
   // Id of the last decoded face.
   int last_face_id_;
 
-  // Array for marking visited faces.
-  std::vector<bool> visited_faces_;
-  // Array for marking visited vertices.
-  std::vector<bool> visited_verts_;
-  // Array for marking vertices on open boundaries.
-  std::vector<bool> is_vert_hole_;
+  // Array for marking vertices on open boundaries. Stored as bytes rather than
+  // packed bits to avoid read-modify-write operations during the decoding.
+  std::vector<uint8_t> is_vert_hole_;
 
   // The number of new vertices added by the encoder (because of non-manifold
   // vertices on the input mesh).
   // If there are no non-manifold edges/vertices on the input mesh, this should
   // be 0.
-  int num_new_vertices_;
-  // For every newly added vertex, this array stores it's mapping to the
-  // parent vertex id of the encoded mesh.
-  std::unordered_map<int, int> new_to_parent_vertex_map_;
+  GeometryIndexCountType num_new_vertices_;
   // The number of vertices that were encoded (can be different from the number
   // of vertices of the input mesh).
-  int num_encoded_vertices_;
+  GeometryIndexCountType num_encoded_vertices_;
 
   // Array for storing the encoded corner ids in the order their associated
   // vertices were decoded.
@@ -27,6 +27,8 @@ namespace draco {
 // Class implements the edge breaker geometry compression method as described
 // in "3D Compression Made Simple: Edgebreaker on a Corner-Table" by Rossignac
 // at al.'01. http://www.cc.gatech.edu/~jarek/papers/CornerTableSMI.pdf
+// The corner table of the input mesh is built on "num_encoding_threads" worker
+// threads (see CornerTable::Init()).
 class MeshEdgebreakerEncoder : public MeshEncoder {
  public:
   MeshEdgebreakerEncoder();
@@ -15,6 +15,7 @@
 #include "draco/compression/mesh/mesh_edgebreaker_encoder_impl.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "draco/compression/attributes/sequential_attribute_encoders_controller.h"
 #include "draco/compression/mesh/mesh_edgebreaker_encoder.h"
@@ -270,10 +271,12 @@ Status MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   // together, unless the option |use_single_connectivity_| is set in which case
   // we break the mesh along attribute seams and use the same connectivity for
   // all attributes.
+  const int num_threads =
+      encoder_->options()->GetGlobalInt("num_encoding_threads", 0);
   if (use_single_connectivity_) {
-    corner_table_ = CreateCornerTableFromAllAttributes(mesh_);
+    corner_table_ = mesh_->GetCornerTableFromAllAttributes(num_threads);
   } else {
-    corner_table_ = CreateCornerTableFromPositionAttribute(mesh_);
+    corner_table_ = mesh_->GetCornerTableFromPositionAttribute(num_threads);
   }
   if (corner_table_ == nullptr ||
       corner_table_->num_faces() == corner_table_->NumDegeneratedFaces()) {
@@ -289,13 +292,18 @@ Status MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   // because some of the vertices of the input mesh can be ignored (e.g.
   // vertices on degenerated faces or isolated vertices not attached to any
   // face).
-  const uint32_t num_vertices_to_be_encoded =
+  const GeometryIndexCountType num_vertices_to_be_encoded =
       corner_table_->num_vertices() - corner_table_->NumIsolatedVertices();
-  EncodeVarint(num_vertices_to_be_encoded, encoder_->buffer());
-
-  const uint32_t num_faces =
+  const GeometryIndexCountType num_faces =
       corner_table_->num_faces() - corner_table_->NumDegeneratedFaces();
-  EncodeVarint(num_faces, encoder_->buffer());
+  // The bitstream stores the number of vertices and faces as 32-bit values.
+  if (static_cast<uint64_t>(num_vertices_to_be_encoded) >
+          std::numeric_limits<uint32_t>::max() ||
+      static_cast<uint64_t>(num_faces) > std::numeric_limits<uint32_t>::max())
+    return Status(Status::DRACO_ERROR, "Too many faces or vertices.");
+  EncodeVarint(static_cast<uint32_t>(num_vertices_to_be_encoded),
+               encoder_->buffer());
+  EncodeVarint(static_cast<uint32_t>(num_faces), encoder_->buffer());
 
   // Reset encoder data that may have been initialized in previous runs.
   visited_faces_.assign(mesh_->num_faces(), false);
@@ -309,7 +317,7 @@ Status MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   last_encoded_symbol_id_ = -1;
   num_split_symbols_ = 0;
   topology_split_event_data_.clear();
-  face_to_split_symbol_map_.clear();
+  face_to_split_symbol_map_.assign(mesh_->num_faces(), -1);
   visited_holes_.clear();
   vertex_hole_id_.assign(corner_table_->num_vertices(), -1);
   processed_connectivity_corners_.clear();
@@ -732,10 +740,7 @@ bool MeshEdgebreakerEncoderImpl<TraversalEncoder>::FindHoles() {
 template <class TraversalEncoder>
 int MeshEdgebreakerEncoderImpl<TraversalEncoder>::GetSplitSymbolIdOnFace(
     int face_id) const {
-  auto it = face_to_split_symbol_map_.find(face_id);
-  if (it == face_to_split_symbol_map_.end())
-    return -1;
-  return it->second;
+  return face_to_split_symbol_map_[face_id];
 }
 
 template <class TraversalEncoder>
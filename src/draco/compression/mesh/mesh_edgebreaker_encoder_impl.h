@@ -15,8 +15,6 @@
 #ifndef DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_ENCODER_IMPL_H_
 #define DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_ENCODER_IMPL_H_
 
-#include <unordered_map>
-
 #include "draco/compression/attributes/mesh_attribute_indices_encoding_data.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/mesh/mesh_edgebreaker_encoder_impl_interface.h"
@@ -128,8 +126,9 @@ class MeshEdgebreakerEncoderImpl : public MeshEdgebreakerEncoderImplInterface {
   MeshEdgebreakerEncoder *encoder_;
   // Mesh that's being encoded.
   const Mesh *mesh_;
-  // Corner table stores the mesh face connectivity data.
-  std::unique_ptr<CornerTable> corner_table_;
+  // Corner table stores the mesh face connectivity data. The table is shared
+  // with the mesh that caches it.
+  std::shared_ptr<const CornerTable> corner_table_;
   // Stack used for storing corners that need to be traversed when encoding
   // the connectivity. New corner is added for each initial face and a split
   // symbol, and one corner is removed when the end symbol is reached.
@@ -160,9 +159,9 @@ class MeshEdgebreakerEncoderImpl : public MeshEdgebreakerEncoderImplInterface {
   // Array for storing all topology split events encountered during the mesh
   // traversal.
   std::vector<TopologySplitEventData> topology_split_event_data_;
-  // Map between face_id and symbol_id. Contains entries only for faces that
-  // were encoded with TOPOLOGY_S symbol.
-  std::unordered_map<int, int> face_to_split_symbol_map_;
+  // Map between face_id and symbol_id. Faces that were not encoded with
+  // TOPOLOGY_S symbol are mapped to -1.
+  std::vector<int> face_to_split_symbol_map_;
 
   // Array for marking holes that has been reached during the traversal.
   std::vector<bool> visited_holes_;
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include <limits>
 #include <sstream>
 
 #include "draco/compression/encode.h"
@@ -19,6 +20,7 @@
 #include "draco/compression/mesh/mesh_edgebreaker_encoder.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
+#include "draco/core/varint_encoding.h"
 #include "draco/io/mesh_io.h"
 #include "draco/io/obj_decoder.h"
 #include "draco/mesh/mesh_are_equivalent.h"
@@ -66,6 +68,18 @@ class MeshEdgebreakerEncodingTest : public ::testing::Test {
     ASSERT_TRUE(eq(*mesh, *decoded_mesh.get()))
         << "Decoded mesh is not the same as the input";
   }
+
+  // Creates a regular grid mesh with |size| x |size| quads, each split into
+  // two triangles. When |hole_spacing| is greater than 0, every
+  // |hole_spacing|-th quad in both directions is left out. The many holes
+  // result in a large number of topology split events during the edgebreaker
+  // traversal.
+  std::unique_ptr<Mesh> CreateGridMesh(int size, int hole_spacing) {
+    return CreateQuadGridMesh(size, size, [hole_spacing](int x, int y) {
+      return hole_spacing <= 0 || x % hole_spacing != hole_spacing - 1 ||
+             y % hole_spacing != hole_spacing - 1;
+    });
+  }
 };
 
 TEST_F(MeshEdgebreakerEncodingTest, TestNmOBJ) {
@@ -244,4 +258,48 @@ TEST_F(MeshEdgebreakerEncodingTest, TestDegenerateMesh) {
   ASSERT_FALSE(encoder.Encode(encoder_options, &buffer).ok());
 }
 
+TEST_F(MeshEdgebreakerEncodingTest, TestTooManyFaces) {
+  // Edgebreaker connectivity that declares more faces than can be addressed
+  // with the geometry indices of the current build must be rejected before
+  // any connectivity data is allocated.
+  const GeometryIndexCountType num_faces = kMaxGeometryIndexCount / 3 + 1;
+  if (num_faces > std::numeric_limits<uint32_t>::max())
+    return;  // The count cannot be stored in the bitstream.
+  EncoderBuffer buffer;
+  buffer.Encode("DRACO", 5);
+  buffer.Encode(static_cast<uint8_t>(kDracoMeshBitstreamVersionMajor));
+  buffer.Encode(static_cast<uint8_t>(kDracoMeshBitstreamVersionMinor));
+  buffer.Encode(static_cast<uint8_t>(TRIANGULAR_MESH));
+  buffer.Encode(static_cast<uint8_t>(MESH_EDGEBREAKER_ENCODING));
+  buffer.Encode(static_cast<uint16_t>(0));  // Flags.
+  buffer.Encode(static_cast<uint8_t>(MESH_EDGEBREAKER_STANDARD_ENCODING));
+  EncodeVarint(static_cast<uint32_t>(3), &buffer);  // Encoded vertices.
+  EncodeVarint(static_cast<uint32_t>(num_faces), &buffer);
+  buffer.Encode(static_cast<uint8_t>(0));  // Attribute data.
+  EncodeVarint(static_cast<uint32_t>(num_faces), &buffer);  // Symbols.
+  EncodeVarint(static_cast<uint32_t>(0), &buffer);  // Split symbols.
+  // Traversal data of the declared faces would follow.
+  for (int i = 0; i < 64; ++i) {
+    buffer.Encode(static_cast<uint8_t>(0));
+  }
+
+  DecoderBuffer dec_buffer;
+  dec_buffer.Init(buffer.data(), buffer.size());
+  MeshEdgebreakerDecoder decoder;
+  Mesh mesh;
+  ASSERT_FALSE(decoder.Decode(DecoderOptions(), &dec_buffer, &mesh).ok());
+  ASSERT_EQ(mesh.num_faces(), 0);
+}
+
+TEST_F(MeshEdgebreakerEncodingTest, TestManyTopologySplits) {
+  // Meshes with many holes produce lots of topology split events that must be
+  // resolved by both the encoder and the decoder.
+  for (const int hole_spacing : {2, 3, 7}) {
+    const std::unique_ptr<Mesh> mesh = CreateGridMesh(40, hole_spacing);
+    ASSERT_NE(mesh, nullptr);
+    TestMesh(mesh.get(), 10);
+    TestMesh(mesh.get(), 5);
+  }
+}
+
 }  // namespace draco
@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_TRAVERSAL_DECODER_H_
 #define DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_TRAVERSAL_DECODER_H_
 
+#include <vector>
+
 #include "draco/draco_features.h"
 
 #include "draco/compression/bit_coders/rans_bit_decoder.h"
@@ -31,8 +33,7 @@ typedef RAnsBitDecoder BinaryDecoder;
 class MeshEdgebreakerTraversalDecoder {
  public:
   MeshEdgebreakerTraversalDecoder()
-      : attribute_connectivity_decoders_(nullptr),
-        num_attribute_data_(0),
+      : num_attribute_data_(0),
         decoder_impl_(nullptr) {}
   void Init(MeshEdgebreakerDecoderImplInterface *decoder) {
     decoder_impl_ = decoder;
@@ -167,8 +168,10 @@ class MeshEdgebreakerTraversalDecoder {
   bool DecodeAttributeSeams() {
     // Prepare attribute decoding.
     if (num_attribute_data_ > 0) {
-      attribute_connectivity_decoders_ = std::unique_ptr<BinaryDecoder[]>(
-          new BinaryDecoder[num_attribute_data_]);
+      // The decoders are kept between multiple decoded meshes.
+      if (static_cast<int>(attribute_connectivity_decoders_.size()) <
+          num_attribute_data_)
+        attribute_connectivity_decoders_.resize(num_attribute_data_);
       for (int i = 0; i < num_attribute_data_; ++i) {
         if (!attribute_connectivity_decoders_[i].StartDecoding(&buffer_))
           return false;
@@ -183,7 +186,7 @@ class MeshEdgebreakerTraversalDecoder {
   DecoderBuffer symbol_buffer_;
   BinaryDecoder start_face_decoder_;
   DecoderBuffer start_face_buffer_;
-  std::unique_ptr<BinaryDecoder[]> attribute_connectivity_decoders_;
+  std::vector<BinaryDecoder> attribute_connectivity_decoders_;
   int num_attribute_data_;
   const MeshEdgebreakerDecoderImplInterface *decoder_impl_;
 };
@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_TRAVERSAL_VALENCE_DECODER_H_
 #define DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_TRAVERSAL_VALENCE_DECODER_H_
 
+#include <algorithm>
+
 #include "draco/draco_features.h"
 
 #include "draco/compression/entropy/symbol_decoding.h"
@@ -90,22 +92,40 @@ class MeshEdgebreakerTraversalValenceDecoder
     if (num_vertices_ < 0)
       return false;
     // Set the valences of all initial vertices to 0.
-    vertex_valences_.resize(num_vertices_, 0);
+    vertex_valences_.assign(num_vertices_, 0);
+    last_symbol_ = -1;
+    active_context_ = -1;
 
     const int num_unique_valences = max_valence_ - min_valence_ + 1;
 
-    // Decode all symbols for all contexts.
-    context_symbols_.resize(num_unique_valences);
-    context_counters_.resize(context_symbols_.size());
-    for (int i = 0; i < context_symbols_.size(); ++i) {
+    // Decode symbols of all contexts into a single array.
+    context_symbols_.clear();
+    context_begins_.resize(num_unique_valences);
+    context_positions_.resize(num_unique_valences);
+    for (int i = 0; i < num_unique_valences; ++i) {
       uint32_t num_symbols;
-      DecodeVarint<uint32_t>(&num_symbols, out_buffer);
+      if (!DecodeVarint<uint32_t>(&num_symbols, out_buffer))
+        return false;
+      const size_t begin = context_symbols_.size();
       if (num_symbols > 0) {
-        context_symbols_[i].resize(num_symbols);
-        DecodeSymbols(num_symbols, 1, out_buffer, context_symbols_[i].data());
-        // All symbols are going to be processed from the back.
-        context_counters_[i] = num_symbols;
+        context_symbols_.resize(begin + num_symbols);
+        if (!DecodeSymbols(num_symbols, 1, out_buffer,
+                           &context_symbols_[begin]))
+          return false;
       }
+      context_begins_[i] = static_cast<uint32_t>(begin);
+      // All symbols are going to be processed from the back.
+      context_positions_[i] = static_cast<uint32_t>(context_symbols_.size());
+    }
+    // Convert the symbols to topology ids so that they can be returned
+    // directly by DecodeSymbol().
+    const uint32_t num_edgebreaker_symbols =
+        sizeof(edge_breaker_symbol_to_topology_id) /
+        sizeof(edge_breaker_symbol_to_topology_id[0]);
+    for (uint32_t &symbol : context_symbols_) {
+      symbol = symbol < num_edgebreaker_symbols
+                   ? edge_breaker_symbol_to_topology_id[symbol]
+                   : TOPOLOGY_INVALID;
     }
     return true;
   }
@@ -113,11 +133,10 @@ class MeshEdgebreakerTraversalValenceDecoder
   inline uint32_t DecodeSymbol() {
     // First check if we have a valid context.
     if (active_context_ != -1) {
-      const int context_counter = --context_counters_[active_context_];
-      if (context_counter < 0)
+      uint32_t &position = context_positions_[active_context_];
+      if (position == context_begins_[active_context_])
         return TOPOLOGY_INVALID;
-      const int symbol_id = context_symbols_[active_context_][context_counter];
-      last_symbol_ = edge_breaker_symbol_to_topology_id[symbol_id];
+      last_symbol_ = context_symbols_[--position];
     } else {
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
       if (BitstreamVersion() < DRACO_BITSTREAM_VERSION(2, 2)) {
@@ -139,62 +158,67 @@ class MeshEdgebreakerTraversalValenceDecoder
     const CornerIndex next = corner_table_->Next(corner);
     const CornerIndex prev = corner_table_->Previous(corner);
     // Update valences.
+    const VertexIndex next_vert = corner_table_->Vertex(next);
     switch (last_symbol_) {
       case TOPOLOGY_C:
       case TOPOLOGY_S:
-        vertex_valences_[corner_table_->Vertex(next)] += 1;
-        vertex_valences_[corner_table_->Vertex(prev)] += 1;
+        AddValence(next_vert, 1);
+        AddValence(corner_table_->Vertex(prev), 1);
         break;
       case TOPOLOGY_R:
-        vertex_valences_[corner_table_->Vertex(corner)] += 1;
-        vertex_valences_[corner_table_->Vertex(next)] += 1;
-        vertex_valences_[corner_table_->Vertex(prev)] += 2;
+        AddValence(corner_table_->Vertex(corner), 1);
+        AddValence(next_vert, 1);
+        AddValence(corner_table_->Vertex(prev), 2);
         break;
       case TOPOLOGY_L:
-        vertex_valences_[corner_table_->Vertex(corner)] += 1;
-        vertex_valences_[corner_table_->Vertex(next)] += 2;
-        vertex_valences_[corner_table_->Vertex(prev)] += 1;
+        AddValence(corner_table_->Vertex(corner), 1);
+        AddValence(next_vert, 2);
+        AddValence(corner_table_->Vertex(prev), 1);
         break;
       case TOPOLOGY_E:
-        vertex_valences_[corner_table_->Vertex(corner)] += 2;
-        vertex_valences_[corner_table_->Vertex(next)] += 2;
-        vertex_valences_[corner_table_->Vertex(prev)] += 2;
+        AddValence(corner_table_->Vertex(corner), 2);
+        AddValence(next_vert, 2);
+        AddValence(corner_table_->Vertex(prev), 2);
         break;
       default:
         break;
     }
     // Compute the new context that is going to be used to decode the next
-    // symbol.
-    const int active_valence = vertex_valences_[corner_table_->Vertex(next)];
-    int clamped_valence;
-    if (active_valence < min_valence_) {
-      clamped_valence = min_valence_;
-    } else if (active_valence > max_valence_) {
-      clamped_valence = max_valence_;
-    } else {
-      clamped_valence = active_valence;
-    }
-
-    active_context_ = (clamped_valence - min_valence_);
+    // symbol. Stored valences are already clamped to |max_valence_|.
+    const int active_valence = vertex_valences_[next_vert];
+    active_context_ = std::max(active_valence, min_valence_) - min_valence_;
   }
 
   inline void MergeVertices(VertexIndex dest, VertexIndex source) {
     // Update valences on the merged vertices.
-    vertex_valences_[dest] += vertex_valences_[source];
+    AddValence(dest, vertex_valences_[source]);
   }
 
  private:
+  // Adds |valence| to the valence of |vertex|. Only valences up to
+  // |max_valence_| are distinguished by the contexts and valences never
+  // decrease, so the stored value is clamped to |max_valence_|. This keeps it
+  // within 8 bits.
+  inline void AddValence(VertexIndex vertex, int valence) {
+    uint8_t &vertex_valence = vertex_valences_[vertex];
+    vertex_valence =
+        static_cast<uint8_t>(std::min(vertex_valence + valence, max_valence_));
+  }
+
   const CornerTable *corner_table_;
   int num_vertices_;
-  IndexTypeVector<VertexIndex, int> vertex_valences_;
+  IndexTypeVector<VertexIndex, uint8_t> vertex_valences_;
   int last_symbol_;
   int active_context_;
 
   int min_valence_;
   int max_valence_;
-  std::vector<std::vector<uint32_t>> context_symbols_;
-  // Points to the active symbol in each context.
-  std::vector<int> context_counters_;
+  // Symbols of all contexts converted to topology ids. Symbols of context i
+  // are stored after |context_begins_[i]|.
+  std::vector<uint32_t> context_symbols_;
+  std::vector<uint32_t> context_begins_;
+  // Points after the next symbol to be decoded in each context.
+  std::vector<uint32_t> context_positions_;
 };
 
 }  // namespace draco
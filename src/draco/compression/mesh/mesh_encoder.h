@@ -22,6 +22,8 @@
 
 namespace draco {
 
+class MeshPredictionSchemeTopologyCache;
+
 // Abstract base class for all mesh encoders. It provides some basic
 // functionality that's shared between different encoders.
 class MeshEncoder : public PointCloudEncoder {
@@ -60,6 +62,12 @@ class MeshEncoder : public PointCloudEncoder {
 
   const Mesh *mesh() const { return mesh_; }
 
+  // The topology of mesh prediction schemes is not cached during encoding. See
+  // MeshDecoder::prediction_topology_cache().
+  MeshPredictionSchemeTopologyCache *prediction_topology_cache() const {
+    return nullptr;
+  }
+
  protected:
   Status EncodeGeometryData() override;
 
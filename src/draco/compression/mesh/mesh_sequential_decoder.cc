@@ -14,14 +14,70 @@
 //
 #include "draco/compression/mesh/mesh_sequential_decoder.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "draco/compression/attributes/linear_sequencer.h"
 #include "draco/compression/attributes/sequential_attribute_decoders_controller.h"
 #include "draco/compression/entropy/symbol_decoding.h"
+#include "draco/core/thread_pool.h"
 #include "draco/core/varint_decoding.h"
 
 namespace draco {
 
-MeshSequentialDecoder::MeshSequentialDecoder() {}
+namespace {
+
+// Decodes point ids of |num_faces| faces from |buffer| and stores them in
+// |out_faces|. Returns false on error or when any of the decoded indices is not
+// a valid point index in range <0, |num_points|).
+bool DecodeFaces(uint32_t num_faces, uint32_t num_points,
+                 DecoderBuffer *buffer, Mesh::Face *out_faces) {
+  // Get decoded indices differences that were encoded with an entropy code.
+  // The caller ensures that the number of indices fits into uint32_t.
+  const uint32_t num_indices = num_faces * 3;
+  std::vector<uint32_t> indices_buffer(num_indices);
+  if (!DecodeSymbols(num_indices, 1, buffer, indices_buffer.data()))
+    return false;
+  // Reconstruct the indices from the differences.
+  // See MeshSequentialEncoder::CompressAndEncodeIndices() for more details.
+  // The values are accumulated in 64 bits so that corrupted differences
+  // cannot overflow.
+  int64_t last_index_value = 0;
+  size_t vertex_index = 0;
+  for (uint32_t i = 0; i < num_faces; ++i) {
+    Mesh::Face face;
+    for (int j = 0; j < 3; ++j) {
+      const uint32_t encoded_val = indices_buffer[vertex_index++];
+      int64_t index_diff = (encoded_val >> 1);
+      if (encoded_val & 1)
+        index_diff = -index_diff;
+      const int64_t index_value = index_diff + last_index_value;
+      if (index_value < 0 || index_value >= num_points)
+        return false;  // Invalid point index.
+      face[j] = static_cast<GeometryIndexValueType>(index_value);
+      last_index_value = index_value;
+    }
+    out_faces[i] = face;
+  }
+  return true;
+}
+
+}  // namespace
+
+MeshSequentialDecoder::MeshSequentialDecoder()
+    : has_face_range_(false),
+      first_face_(0),
+      num_range_faces_(0),
+      point_block_size_(0),
+      num_encoded_points_(0) {}
+
+void MeshSequentialDecoder::SetFaceRange(uint32_t first_face,
+                                         uint32_t num_faces) {
+  has_face_range_ = true;
+  first_face_ = first_face;
+  num_range_faces_ = num_faces;
+}
 
 bool MeshSequentialDecoder::DecodeConnectivity() {
   uint32_t num_faces;
@@ -53,9 +109,43 @@ bool MeshSequentialDecoder::DecodeConnectivity() {
   uint8_t connectivity_method;
   if (!buffer()->Decode(&connectivity_method))
     return false;
+  point_block_size_ = 0;
+  num_encoded_points_ = num_points;
+  decoded_point_blocks_.clear();
+  // Block compressed connectivity and random access blocks are supported
+  // since version 2.3. Older decoders would misinterpret them as uncompressed
+  // indices.
+  if ((connectivity_method == 2 || connectivity_method == 3) &&
+      bitstream_version() < DRACO_BITSTREAM_VERSION(2, 3))
+    return false;
+  if (has_face_range_ && connectivity_method != 3)
+    return false;  // The mesh was not encoded for random access.
   if (connectivity_method == 0) {
-    if (!DecodeAndDecompressIndices(num_faces))
+    if (!DecodeAndDecompressIndices(num_faces, num_points))
+      return false;
+  } else if (connectivity_method == 2) {
+    if (!DecodeAndDecompressIndicesInBlocks(num_faces, num_points))
+      return false;
+  } else if (connectivity_method == 3) {
+    if (!DecodeVarint(&point_block_size_, buffer()))
+      return false;
+    if (point_block_size_ == 0)
       return false;
+    if (!DecodeAndDecompressIndicesInBlocks(num_faces, num_points))
+      return false;
+    if (has_face_range_) {
+      if (!SelectDecodedPointBlocks(&num_points))
+        return false;
+    } else {
+      // Decode all point blocks.
+      const uint32_t num_point_blocks = static_cast<uint32_t>(
+          (static_cast<uint64_t>(num_points) + point_block_size_ - 1) /
+          point_block_size_);
+      decoded_point_blocks_.resize(num_point_blocks);
+      for (uint32_t b = 0; b < num_point_blocks; ++b) {
+        decoded_point_blocks_[b] = b;
+      }
+    }
   } else {
     if (num_points < 256) {
       // Decode indices as uint8_t.
@@ -114,36 +204,158 @@ bool MeshSequentialDecoder::DecodeConnectivity() {
 
 bool MeshSequentialDecoder::CreateAttributesDecoder(int32_t att_decoder_id) {
   // Always create the basic attribute decoder.
-  return SetAttributesDecoder(
-      att_decoder_id,
-      std::unique_ptr<AttributesDecoder>(
-          new SequentialAttributeDecodersController(
-              std::unique_ptr<PointsSequencer>(
-                  new LinearSequencer(point_cloud()->num_points())))));
+  std::unique_ptr<SequentialAttributeDecodersController> att_decoder(
+      new SequentialAttributeDecodersController(
+          std::unique_ptr<PointsSequencer>(
+              new LinearSequencer(point_cloud()->num_points()))));
+  if (point_block_size_ > 0) {
+    att_decoder->SetPointBlocks(point_block_size_, num_encoded_points_,
+                                decoded_point_blocks_);
+  }
+  return SetAttributesDecoder(att_decoder_id, std::move(att_decoder));
 }
 
-bool MeshSequentialDecoder::DecodeAndDecompressIndices(uint32_t num_faces) {
-  // Get decoded indices differences that were encoded with an entropy code.
-  std::vector<uint32_t> indices_buffer(num_faces * 3);
-  if (!DecodeSymbols(num_faces * 3, 1, buffer(), indices_buffer.data()))
+bool MeshSequentialDecoder::DecodeAndDecompressIndices(uint32_t num_faces,
+                                                       uint32_t num_points) {
+  mesh()->SetNumFaces(num_faces);
+  if (num_faces == 0)
+    return true;
+  const bool result = DecodeFaces(num_faces, num_points, buffer(),
+                                  &mesh()->faces_[FaceIndex(0)]);
+  // The faces were written directly, the mesh must be notified about the
+  // change of its connectivity.
+  ++mesh()->connectivity_version_;
+  return result;
+}
+
+bool MeshSequentialDecoder::DecodeAndDecompressIndicesInBlocks(
+    uint32_t num_faces, uint32_t num_points) {
+  uint32_t block_size;
+  if (!DecodeVarint(&block_size, buffer()))
     return false;
-  // Reconstruct the indices from the differences.
-  // See MeshSequentialEncoder::CompressAndEncodeIndices() for more details.
-  int32_t last_index_value = 0;
-  int vertex_index = 0;
-  for (uint32_t i = 0; i < num_faces; ++i) {
-    Mesh::Face face;
-    for (int j = 0; j < 3; ++j) {
-      const uint32_t encoded_val = indices_buffer[vertex_index++];
-      int32_t index_diff = (encoded_val >> 1);
-      if (encoded_val & 1)
-        index_diff = -index_diff;
-      const int32_t index_value = index_diff + last_index_value;
-      face[j] = index_value;
-      last_index_value = index_value;
+  if (block_size == 0)
+    return false;
+  const uint32_t num_blocks = static_cast<uint32_t>(
+      (static_cast<uint64_t>(num_faces) + block_size - 1) / block_size);
+  // Every block takes at least one byte of the size table.
+  if (num_blocks > buffer()->remaining_size())
+    return false;
+  // Split the data into independent buffers for each block.
+  std::vector<DecoderBuffer> block_buffers(num_blocks);
+  std::vector<uint64_t> block_sizes(num_blocks);
+  uint64_t total_size = 0;
+  for (uint32_t b = 0; b < num_blocks; ++b) {
+    if (!DecodeVarint(&block_sizes[b], buffer()))
+      return false;
+    total_size += block_sizes[b];
+    if (total_size > static_cast<uint64_t>(buffer()->remaining_size()))
+      return false;
+  }
+
+  // Only blocks containing the requested range of faces are decoded.
+  uint32_t first_face = 0;
+  uint32_t num_decoded_faces = num_faces;
+  if (has_face_range_) {
+    if (first_face_ > num_faces || num_range_faces_ > num_faces - first_face_)
+      return false;
+    first_face = first_face_;
+    num_decoded_faces = num_range_faces_;
+  }
+  const uint32_t first_block = first_face / block_size;
+  const uint32_t last_block =
+      num_decoded_faces == 0
+          ? first_block
+          : static_cast<uint32_t>(
+                (static_cast<uint64_t>(first_face) + num_decoded_faces - 1) /
+                    block_size +
+                1);
+  for (uint32_t b = 0; b < num_blocks; ++b) {
+    block_buffers[b].Init(buffer()->data_head(), block_sizes[b],
+                          buffer()->bitstream_version());
+    buffer()->Advance(block_sizes[b]);
+  }
+
+  const uint64_t first_block_face = static_cast<uint64_t>(first_block) *
+                                    block_size;
+  mesh()->SetNumFaces(static_cast<size_t>(
+      std::min<uint64_t>(num_faces,
+                         static_cast<uint64_t>(last_block) * block_size) -
+      std::min<uint64_t>(num_faces, first_block_face)));
+  std::vector<uint8_t> block_decoded(num_blocks, 0);
+  // The blocks are decoded directly into the faces of the mesh. Mesh::SetFace()
+  // can't be used here because it updates the connectivity version of the mesh
+  // that is shared by all worker threads.
+  Mesh::Face *const out_faces =
+      mesh()->num_faces() > 0 ? &mesh()->faces_[FaceIndex(0)] : nullptr;
+  {
+    const int num_threads =
+        options()->GetGlobalInt("num_connectivity_decoding_threads", 0);
+    ThreadPool pool(std::min<uint32_t>(std::max(num_threads, 0),
+                                       last_block - first_block));
+    for (uint32_t b = first_block; b < last_block; ++b) {
+      pool.Schedule([&, b]() {
+        const uint64_t block_first_face = static_cast<uint64_t>(b) * block_size;
+        const uint32_t num_block_faces = static_cast<uint32_t>(
+            std::min<uint64_t>(num_faces - block_first_face, block_size));
+        block_decoded[b] =
+            DecodeFaces(num_block_faces, num_points, &block_buffers[b],
+                        out_faces + (block_first_face - first_block_face));
+      });
+    }
+  }
+  ++mesh()->connectivity_version_;
+  for (uint32_t b = first_block; b < last_block; ++b) {
+    if (!block_decoded[b])
+      return false;
+  }
+  if (has_face_range_) {
+    // Remove faces of the decoded blocks that are outside of the range.
+    const uint32_t num_skipped_faces =
+        static_cast<uint32_t>(first_face - first_block_face);
+    for (uint32_t i = 0; i < num_decoded_faces; ++i) {
+      const Mesh::Face face = mesh()->face(FaceIndex(i + num_skipped_faces));
+      mesh()->SetFace(FaceIndex(i), face);
+    }
+    mesh()->SetNumFaces(num_decoded_faces);
+  }
+  return true;
+}
+
+bool MeshSequentialDecoder::SelectDecodedPointBlocks(uint32_t *num_points) {
+  // Find all point blocks referenced by the decoded faces. The blocks are
+  // decoded in their original order and the point ids of the faces are mapped
+  // to the positions of the points in the decoded blocks.
+  const uint32_t num_point_blocks = static_cast<uint32_t>(
+      (static_cast<uint64_t>(num_encoded_points_) + point_block_size_ - 1) /
+      point_block_size_);
+  const uint32_t kUnusedBlock = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> block_offsets(num_point_blocks, kUnusedBlock);
+  for (FaceIndex f(0); f < mesh()->num_faces(); ++f) {
+    const Mesh::Face &face = mesh()->face(f);
+    for (int c = 0; c < 3; ++c) {
+      block_offsets[face[c].value() / point_block_size_] = 0;
+    }
+  }
+  uint32_t num_decoded_points = 0;
+  for (uint32_t b = 0; b < num_point_blocks; ++b) {
+    if (block_offsets[b] == kUnusedBlock)
+      continue;
+    decoded_point_blocks_.push_back(b);
+    block_offsets[b] = num_decoded_points;
+    num_decoded_points += static_cast<uint32_t>(std::min<uint64_t>(
+        point_block_size_,
+        num_encoded_points_ - static_cast<uint64_t>(b) * point_block_size_));
+  }
+  for (FaceIndex f(0); f < mesh()->num_faces(); ++f) {
+    Mesh::Face face = mesh()->face(f);
+    for (int c = 0; c < 3; ++c) {
+      const uint32_t point = face[c].value();
+      face[c] = block_offsets[point / point_block_size_] +
+                point % point_block_size_;
     }
-    mesh()->AddFace(face);
+    mesh()->SetFace(f, face);
   }
+  *num_points = num_decoded_points;
   return true;
 }
 
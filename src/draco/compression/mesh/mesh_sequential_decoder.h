@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_MESH_MESH_SEQUENTIAL_DECODER_H_
 #define DRACO_COMPRESSION_MESH_MESH_SEQUENTIAL_DECODER_H_
 
+#include <vector>
+
 #include "draco/compression/mesh/mesh_decoder.h"
 
 namespace draco {
@@ -24,14 +26,40 @@ class MeshSequentialDecoder : public MeshDecoder {
  public:
   MeshSequentialDecoder();
 
+  // Restricts the decoding to |num_faces| faces starting at |first_face|. Only
+  // meshes encoded with the "random_access_block_size" option can be decoded
+  // this way (see MeshSequentialEncoder). The decoded mesh contains the
+  // requested faces and all points of the point blocks referenced by them.
+  // Point ids of the decoded faces are remapped to the decoded points.
+  void SetFaceRange(uint32_t first_face, uint32_t num_faces);
+
  protected:
   bool DecodeConnectivity() override;
   bool CreateAttributesDecoder(int32_t att_decoder_id) override;
 
  private:
   // Decodes face indices that were compressed with an entropy code.
-  // Returns false on error.
-  bool DecodeAndDecompressIndices(uint32_t num_faces);
+  // Returns false on error or when any of the decoded indices is not a valid
+  // point index in range <0, |num_points|).
+  bool DecodeAndDecompressIndices(uint32_t num_faces, uint32_t num_points);
+  // Same as above for indices compressed in independent blocks of faces. The
+  // blocks are decoded on "num_connectivity_decoding_threads" worker threads.
+  bool DecodeAndDecompressIndicesInBlocks(uint32_t num_faces,
+                                          uint32_t num_points);
+
+  // Selects point blocks referenced by faces in the requested face range and
+  // remaps the point ids of the faces to the points of the selected blocks.
+  // The number of the decoded points is returned in |num_points|.
+  bool SelectDecodedPointBlocks(uint32_t *num_points);
+
+  bool has_face_range_;
+  uint32_t first_face_;
+  uint32_t num_range_faces_;
+  // Number of points in each block of the attribute data or 0 when the
+  // attributes are not encoded in blocks.
+  uint32_t point_block_size_;
+  uint32_t num_encoded_points_;
+  std::vector<uint32_t> decoded_point_blocks_;
 };
 
 }  // namespace draco
@@ -14,29 +14,131 @@
 //
 #include "draco/compression/mesh/mesh_sequential_encoder.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <limits>
+#include <vector>
 
 #include "draco/compression/attributes/linear_sequencer.h"
 #include "draco/compression/attributes/sequential_attribute_encoders_controller.h"
+#include "draco/compression/config/encoding_features.h"
 #include "draco/compression/entropy/symbol_encoding.h"
+#include "draco/core/thread_pool.h"
 #include "draco/core/varint_encoding.h"
 
 namespace draco {
 
+namespace {
+
+// Sequencer that generates a precomputed order of points.
+class PointOrderSequencer : public PointsSequencer {
+ public:
+  explicit PointOrderSequencer(const std::vector<PointIndex> &point_order)
+      : point_order_(point_order) {}
+
+ protected:
+  bool GenerateSequenceInternal() override {
+    *out_point_ids() = point_order_;
+    return true;
+  }
+
+ private:
+  const std::vector<PointIndex> point_order_;
+};
+
+// Delta codes point ids of faces in range <|first_face|, |last_face|) and
+// compresses them into |out_buffer| using |symbol_encoding_options|. When
+// |point_map| is not empty, the point ids are mapped through it first. Returns
+// false on error.
+bool EncodeFaceRange(const Mesh &mesh, FaceIndex first_face,
+                     FaceIndex last_face,
+                     const IndexTypeVector<PointIndex, PointIndex> &point_map,
+                     const Options &symbol_encoding_options,
+                     EncoderBuffer *out_buffer) {
+  // Each new index is a difference from the previous value.
+  // Differences of the indices are encoded as 32-bit signed values.
+  std::vector<uint32_t> indices_buffer;
+  indices_buffer.reserve(3 * (last_face - first_face).value());
+  int32_t last_index_value = 0;
+  for (FaceIndex i = first_face; i < last_face; ++i) {
+    const auto &face = mesh.face(i);
+    for (int j = 0; j < 3; ++j) {
+      const int32_t index_value =
+          point_map.size() > 0 ? point_map[face[j]].value() : face[j].value();
+      const int32_t index_diff = index_value - last_index_value;
+      // Encode signed value to an unsigned one (put the sign to lsb pos).
+      const uint32_t encoded_val =
+          (abs(index_diff) << 1) | (index_diff < 0 ? 1 : 0);
+      indices_buffer.push_back(encoded_val);
+      last_index_value = index_value;
+    }
+  }
+  return EncodeSymbols(indices_buffer.data(),
+                       static_cast<int>(indices_buffer.size()), 1,
+                       &symbol_encoding_options, out_buffer);
+}
+
+}  // namespace
+
 MeshSequentialEncoder::MeshSequentialEncoder() {}
 
+uint8_t MeshSequentialEncoder::GetBitstreamVersionMinor() const {
+  // Connectivity encoded in blocks can't be decoded before version 2.3. Other
+  // meshes keep the default version so that older decoders can read them.
+  const int connectivity_method = GetConnectivityMethod();
+  if (connectivity_method == 2 || connectivity_method == 3)
+    return kDracoMeshBitstreamVersionMinor;
+  return MeshEncoder::GetBitstreamVersionMinor();
+}
+
+int MeshSequentialEncoder::GetConnectivityMethod() const {
+  if (options()->GetGlobalInt("random_access_block_size", 0) > 0)
+    return 3;
+  if (options()->GetGlobalBool("compress_connectivity", false)) {
+    return options()->GetGlobalInt("compressed_connectivity_block_size", 0) > 0
+               ? 2
+               : 0;
+  }
+  return 1;
+}
+
 Status MeshSequentialEncoder::EncodeConnectivity() {
-  // Serialize indices.
-  const uint32_t num_faces = mesh()->num_faces();
+  // Serialize indices. The number of faces and points is stored as 32-bit
+  // values and the decoder supports up to (2^32 - 1) / 3 faces.
+  if (mesh()->num_faces() > std::numeric_limits<uint32_t>::max() / 3 ||
+      static_cast<uint64_t>(mesh()->num_points()) >
+          std::numeric_limits<uint32_t>::max())
+    return Status(Status::DRACO_ERROR, "Too many faces or points.");
+  const uint32_t num_faces = static_cast<uint32_t>(mesh()->num_faces());
   EncodeVarint(num_faces, buffer());
   EncodeVarint(static_cast<uint32_t>(mesh()->num_points()), buffer());
 
   // We encode all attributes in the original (possibly duplicated) format.
   // TODO(ostava): This may not be optimal if we have only one attribute or if
   // all attributes share the same index mapping.
-  if (options()->GetGlobalBool("compress_connectivity", false)) {
+  const int connectivity_method = GetConnectivityMethod();
+  point_order_.clear();
+  new_point_ids_.clear();
+  if (connectivity_method == 3) {
+    // 3 = Encode compressed indices in independent blocks of faces followed by
+    // attribute values in independent blocks of points (since version 2.3).
+    static_assert(kDracoMeshBitstreamVersion >= DRACO_BITSTREAM_VERSION(2, 3),
+                  "Random access blocks require bitstream version 2.3.");
+    buffer()->Encode(static_cast<uint8_t>(3));
+    EncodeVarint(static_cast<uint32_t>(
+                     options()->GetGlobalInt("random_access_block_size", 0)),
+                 buffer());
+    ComputeRandomAccessPointOrder();
+    if (!CompressAndEncodeIndices())
+      return Status(Status::DRACO_ERROR, "Failed to compress connectivity.");
+  } else if (connectivity_method != 1) {
     // 0 = Encode compressed indices.
-    buffer()->Encode(static_cast<uint8_t>(0));
+    // 2 = Encode compressed indices in independent blocks of faces (since
+    //     version 2.3).
+    static_assert(
+        kDracoMeshBitstreamVersion >= DRACO_BITSTREAM_VERSION(2, 3),
+        "Block compressed connectivity requires bitstream version 2.3.");
+    buffer()->Encode(static_cast<uint8_t>(connectivity_method));
     if (!CompressAndEncodeIndices())
       return Status(Status::DRACO_ERROR, "Failed to compress connectivity.");
   } else {
@@ -85,11 +187,20 @@ bool MeshSequentialEncoder::GenerateAttributesEncoder(int32_t att_id) {
   // linear sequence.
   if (att_id == 0) {
     // Create a new attribute encoder only for the first attribute.
-    AddAttributesEncoder(std::unique_ptr<AttributesEncoder>(
-        new SequentialAttributeEncodersController(
-            std::unique_ptr<PointsSequencer>(
-                new LinearSequencer(point_cloud()->num_points())),
-            att_id)));
+    std::unique_ptr<PointsSequencer> sequencer;
+    if (point_order_.empty()) {
+      sequencer = std::unique_ptr<PointsSequencer>(
+          new LinearSequencer(point_cloud()->num_points()));
+    } else {
+      sequencer = std::unique_ptr<PointsSequencer>(
+          new PointOrderSequencer(point_order_));
+    }
+    std::unique_ptr<SequentialAttributeEncodersController> att_encoder(
+        new SequentialAttributeEncodersController(std::move(sequencer),
+                                                  att_id));
+    att_encoder->SetPointBlockSize(
+        options()->GetGlobalInt("random_access_block_size", 0));
+    AddAttributesEncoder(std::move(att_encoder));
   } else {
     // Reuse the existing attribute encoder for other attributes.
     attributes_encoder(0)->AddAttributeId(att_id);
@@ -97,26 +208,88 @@ bool MeshSequentialEncoder::GenerateAttributesEncoder(int32_t att_id) {
   return true;
 }
 
+void MeshSequentialEncoder::ComputeRandomAccessPointOrder() {
+  // Points are ordered by their first use in the faces so that a range of
+  // faces references only a few blocks of points. Points that are not used by
+  // any face are stored at the end.
+  const PointIndex::ValueType num_points = mesh()->num_points();
+  new_point_ids_.assign(num_points, kInvalidPointIndex);
+  point_order_.clear();
+  point_order_.reserve(num_points);
+  for (FaceIndex f(0); f < mesh()->num_faces(); ++f) {
+    const Mesh::Face &face = mesh()->face(f);
+    for (int c = 0; c < 3; ++c) {
+      if (new_point_ids_[face[c]] == kInvalidPointIndex) {
+        new_point_ids_[face[c]] = PointIndex(point_order_.size());
+        point_order_.push_back(face[c]);
+      }
+    }
+  }
+  for (PointIndex p(0); p < num_points; ++p) {
+    if (new_point_ids_[p] == kInvalidPointIndex) {
+      new_point_ids_[p] = PointIndex(point_order_.size());
+      point_order_.push_back(p);
+    }
+  }
+}
+
 bool MeshSequentialEncoder::CompressAndEncodeIndices() {
   // Collect all indices to a buffer and encode them.
-  // Each new index is a difference from the previous value.
-  std::vector<uint32_t> indices_buffer;
-  int32_t last_index_value = 0;
-  const int num_faces = mesh()->num_faces();
-  for (FaceIndex i(0); i < num_faces; ++i) {
-    const auto &face = mesh()->face(i);
-    for (int j = 0; j < 3; ++j) {
-      const int32_t index_value = face[j].value();
-      const int32_t index_diff = index_value - last_index_value;
-      // Encode signed value to an unsigned one (put the sign to lsb pos).
-      const uint32_t encoded_val =
-          (abs(index_diff) << 1) | (index_diff < 0 ? 1 : 0);
-      indices_buffer.push_back(encoded_val);
-      last_index_value = index_value;
+  if (mesh()->num_points() >
+      static_cast<PointIndex::ValueType>(std::numeric_limits<int32_t>::max()))
+    return false;
+  int block_size = options()->GetGlobalInt("random_access_block_size", 0);
+  if (block_size <= 0) {
+    block_size =
+        options()->GetGlobalInt("compressed_connectivity_block_size", 0);
+  }
+  if (block_size > 0)
+    return CompressAndEncodeIndicesInBlocks(block_size);
+  Options symbol_encoding_options;
+  if (options()->GetDecodingSpeed() >= 8 &&
+      options()->IsFeatureSupported(features::kInterleavedSymbolCoding)) {
+    SetSymbolEncodingInterleavedRawCoding(&symbol_encoding_options, true);
+  }
+  return EncodeFaceRange(*mesh(), FaceIndex(0), FaceIndex(mesh()->num_faces()),
+                         new_point_ids_, symbol_encoding_options, buffer());
+}
+
+bool MeshSequentialEncoder::CompressAndEncodeIndicesInBlocks(int block_size) {
+  // Blocks are encoded to separate buffers that are concatenated after the
+  // table of their sizes.
+  const uint32_t num_faces = static_cast<uint32_t>(mesh()->num_faces());
+  const uint32_t num_blocks = (num_faces + block_size - 1) / block_size;
+  Options symbol_encoding_options;
+  if (options()->GetDecodingSpeed() >= 8 &&
+      options()->IsFeatureSupported(features::kInterleavedSymbolCoding)) {
+    SetSymbolEncodingInterleavedRawCoding(&symbol_encoding_options, true);
+  }
+  std::vector<EncoderBuffer> block_buffers(num_blocks);
+  std::vector<uint8_t> block_encoded(num_blocks, 0);
+  {
+    const int num_threads = options()->GetGlobalInt("num_encoding_threads", 0);
+    ThreadPool pool(std::min<uint32_t>(std::max(num_threads, 0), num_blocks));
+    for (uint32_t b = 0; b < num_blocks; ++b) {
+      pool.Schedule([&, b]() {
+        const uint32_t first_face = b * block_size;
+        const uint32_t last_face = std::min(num_faces, first_face + block_size);
+        block_encoded[b] = EncodeFaceRange(
+            *mesh(), FaceIndex(first_face), FaceIndex(last_face),
+            new_point_ids_, symbol_encoding_options, &block_buffers[b]);
+      });
     }
   }
-  EncodeSymbols(indices_buffer.data(), static_cast<int>(indices_buffer.size()),
-                1, nullptr, buffer());
+  for (uint32_t b = 0; b < num_blocks; ++b) {
+    if (!block_encoded[b])
+      return false;
+  }
+  EncodeVarint(static_cast<uint32_t>(block_size), buffer());
+  for (uint32_t b = 0; b < num_blocks; ++b) {
+    EncodeVarint(static_cast<uint64_t>(block_buffers[b].size()), buffer());
+  }
+  for (uint32_t b = 0; b < num_blocks; ++b) {
+    buffer()->Encode(block_buffers[b].data(), block_buffers[b].size());
+  }
   return true;
 }
 
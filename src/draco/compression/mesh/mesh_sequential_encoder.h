@@ -19,15 +19,30 @@
 // using a global encoder options flag called "compress_connectivity"
 // 1. When "compress_connectivity" == true:
 //      All point ids are first delta coded and then compressed using an entropy
-//      coding.
+//      coding. When the global option "compressed_connectivity_block_size" is
+//      greater than zero, the faces are split into blocks of the given size
+//      that are delta coded and entropy coded independently. The blocks are
+//      encoded on "num_encoding_threads" worker threads and their sizes are
+//      stored in the bitstream so that the decoder can decode the blocks in
+//      parallel or access any range of faces directly.
 // 2. When "compress_connectivity" == false:
 //      All point ids are encoded directly using either 8, 16, or 32 bits per
 //      value based on the maximum point id value.
+// When the global option "random_access_block_size" is greater than zero, the
+// connectivity is compressed in blocks of the given number of faces and the
+// attribute values are encoded in independent blocks of the same number of
+// points. Any range of faces can be then decoded together with the attribute
+// values of the points it references without decoding the rest of the mesh
+// (see Decoder::DecodeFaceRange()). In this mode, the points are reordered by
+// their first use in the faces.
 
 #ifndef DRACO_COMPRESSION_MESH_MESH_SEQUENTIAL_ENCODER_H_
 #define DRACO_COMPRESSION_MESH_MESH_SEQUENTIAL_ENCODER_H_
 
+#include <vector>
+
 #include "draco/compression/mesh/mesh_encoder.h"
+#include "draco/core/draco_index_type_vector.h"
 
 namespace draco {
 
@@ -40,6 +55,7 @@ class MeshSequentialEncoder : public MeshEncoder {
   uint8_t GetEncodingMethod() const override {
     return MESH_SEQUENTIAL_ENCODING;
   }
+  uint8_t GetBitstreamVersionMinor() const override;
 
  protected:
   Status EncodeConnectivity() override;
@@ -48,8 +64,23 @@ class MeshSequentialEncoder : public MeshEncoder {
   void ComputeNumberOfEncodedFaces() override;
 
  private:
+  // Returns the id of the connectivity encoding method selected by the
+  // encoder options (see EncodeConnectivity()).
+  int GetConnectivityMethod() const;
+
   // Returns false on error.
   bool CompressAndEncodeIndices();
+  // Same as above but the faces are encoded in independent blocks of
+  // |block_size| faces. Returns false on error.
+  bool CompressAndEncodeIndicesInBlocks(int block_size);
+
+  // Computes the order of points used by the "random_access_block_size" mode.
+  void ComputeRandomAccessPointOrder();
+
+  // Order in which the points are encoded and the new id of each point. Both
+  // are empty when the order of points is preserved.
+  std::vector<PointIndex> point_order_;
+  IndexTypeVector<PointIndex, PointIndex> new_point_ids_;
 };
 
 }  // namespace draco
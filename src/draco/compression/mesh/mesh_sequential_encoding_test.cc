@@ -0,0 +1,270 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cstring>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/compression/mesh/mesh_sequential_decoder.h"
+#include "draco/compression/mesh/mesh_sequential_encoder.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace draco {
+
+class MeshSequentialEncodingTest : public ::testing::Test {
+ protected:
+  void EncodeMesh(const Mesh &mesh, int block_size, int num_threads,
+                  EncoderBuffer *buffer) {
+    MeshSequentialEncoder encoder;
+    EncoderOptions options = EncoderOptions::CreateDefaultOptions();
+    options.SetGlobalBool("compress_connectivity", true);
+    options.SetGlobalInt("compressed_connectivity_block_size", block_size);
+    options.SetGlobalInt("num_encoding_threads", num_threads);
+    encoder.SetMesh(mesh);
+    ASSERT_TRUE(encoder.Encode(options, buffer).ok());
+  }
+
+  Status DecodeMesh(const char *data, size_t size, int num_threads,
+                    Mesh *out_mesh) {
+    DecoderBuffer buffer;
+    buffer.Init(data, size);
+    DecoderOptions options;
+    options.SetGlobalInt("num_connectivity_decoding_threads", num_threads);
+    MeshSequentialDecoder decoder;
+    return decoder.Decode(options, &buffer, out_mesh);
+  }
+
+  void EncodeRandomAccessMesh(const Mesh &mesh, int block_size,
+                              EncoderBuffer *buffer) {
+    Encoder encoder;
+    encoder.SetEncodingMethod(MESH_SEQUENTIAL_ENCODING);
+    encoder.SetAttributeQuantization(GeometryAttribute::POSITION, 14);
+    encoder.SetAttributeQuantization(GeometryAttribute::TEX_COORD, 12);
+    encoder.SetAttributeQuantization(GeometryAttribute::NORMAL, 10);
+    encoder.SetRandomAccessBlockSize(block_size);
+    ASSERT_TRUE(encoder.EncodeMeshToBuffer(mesh, buffer).ok());
+  }
+
+  // Returns true when point |pi_0| of |mesh_0| has the same attribute values
+  // as point |pi_1| of |mesh_1|.
+  bool ArePointsEqual(const Mesh &mesh_0, PointIndex pi_0, const Mesh &mesh_1,
+                      PointIndex pi_1) {
+    if (mesh_0.num_attributes() != mesh_1.num_attributes())
+      return false;
+    for (int i = 0; i < mesh_0.num_attributes(); ++i) {
+      const PointAttribute *const att_0 = mesh_0.attribute(i);
+      const PointAttribute *const att_1 = mesh_1.attribute(i);
+      if (att_0->byte_stride() != att_1->byte_stride())
+        return false;
+      if (memcmp(att_0->GetAddress(att_0->mapped_index(pi_0)),
+                 att_1->GetAddress(att_1->mapped_index(pi_1)),
+                 att_0->byte_stride()) != 0)
+        return false;
+    }
+    return true;
+  }
+
+  void TestRandomAccessEncoding(const std::string &file_name) {
+    const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    EncoderBuffer ref_buffer;
+    EncodeRandomAccessMesh(*mesh, 0, &ref_buffer);
+    DecoderBuffer ref_in_buffer;
+    ref_in_buffer.Init(ref_buffer.data(), ref_buffer.size());
+    Decoder decoder;
+    const std::unique_ptr<Mesh> ref_mesh =
+        decoder.DecodeMeshFromBuffer(&ref_in_buffer).value();
+    for (const int block_size : {1, 16, 1000000}) {
+      EncoderBuffer buffer;
+      EncodeRandomAccessMesh(*mesh, block_size, &buffer);
+      DecoderBuffer in_buffer;
+      in_buffer.Init(buffer.data(), buffer.size());
+      auto status_or = decoder.DecodeMeshFromBuffer(&in_buffer);
+      ASSERT_TRUE(status_or.ok()) << status_or.status().error_msg();
+      const std::unique_ptr<Mesh> decoded_mesh = std::move(status_or).value();
+      ASSERT_EQ(ref_mesh->num_points(), decoded_mesh->num_points());
+      ASSERT_EQ(ref_mesh->num_faces(), decoded_mesh->num_faces());
+      for (FaceIndex fi(0); fi < ref_mesh->num_faces(); ++fi) {
+        for (int c = 0; c < 3; ++c) {
+          ASSERT_TRUE(ArePointsEqual(*ref_mesh, ref_mesh->face(fi)[c],
+                                     *decoded_mesh, decoded_mesh->face(fi)[c]));
+        }
+      }
+    }
+  }
+
+  void ExpectSameFaces(const Mesh &mesh_0, const Mesh &mesh_1) {
+    ASSERT_EQ(mesh_0.num_faces(), mesh_1.num_faces());
+    for (FaceIndex fi(0); fi < mesh_0.num_faces(); ++fi) {
+      ASSERT_EQ(mesh_0.face(fi), mesh_1.face(fi));
+    }
+  }
+};
+
+TEST_F(MeshSequentialEncodingTest, TestBlockCompressedConnectivity) {
+  const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  EncoderBuffer ref_buffer;
+  EncodeMesh(*mesh, 0, 0, &ref_buffer);
+  Mesh ref_mesh;
+  ASSERT_TRUE(
+      DecodeMesh(ref_buffer.data(), ref_buffer.size(), 0, &ref_mesh).ok());
+  ExpectSameFaces(*mesh, ref_mesh);
+
+  for (const int block_size : {1, 7, 1000000}) {
+    EncoderBuffer buffer;
+    EncodeMesh(*mesh, block_size, 0, &buffer);
+    // The encoded data must not depend on the number of threads. A negative
+    // number of threads is the same as no threads.
+    for (const int num_encoding_threads : {4, -1}) {
+      EncoderBuffer threaded_buffer;
+      EncodeMesh(*mesh, block_size, num_encoding_threads, &threaded_buffer);
+      ASSERT_EQ(buffer.size(), threaded_buffer.size());
+      ASSERT_EQ(
+          0, memcmp(buffer.data(), threaded_buffer.data(), buffer.size()));
+    }
+    for (const int num_threads : {0, 3}) {
+      Mesh decoded_mesh;
+      ASSERT_TRUE(DecodeMesh(buffer.data(), buffer.size(), num_threads,
+                             &decoded_mesh)
+                      .ok());
+      ExpectSameFaces(ref_mesh, decoded_mesh);
+      ASSERT_EQ(decoded_mesh.num_points(), ref_mesh.num_points());
+    }
+  }
+}
+
+TEST_F(MeshSequentialEncodingTest, TestTruncatedBlocks) {
+  // Decoding of block compressed connectivity must fail when the data of any
+  // block is missing.
+  const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  // Encode the connectivity only.
+  mesh->DeleteAttribute(0);
+  EncoderBuffer buffer;
+  EncodeMesh(*mesh, 5, 0, &buffer);
+  for (size_t size = 0; size < buffer.size(); ++size) {
+    Mesh decoded_mesh;
+    ASSERT_FALSE(DecodeMesh(buffer.data(), size, 2, &decoded_mesh).ok());
+  }
+}
+
+TEST_F(MeshSequentialEncodingTest, TestBlocksRejectedInOldVersion) {
+  // Block compressed connectivity must not be decoded from bitstreams older
+  // than version 2.3.
+  const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  EncoderBuffer buffer;
+  EncodeMesh(*mesh, 5, 0, &buffer);
+  Mesh decoded_mesh;
+  ASSERT_TRUE(DecodeMesh(buffer.data(), buffer.size(), 0, &decoded_mesh).ok());
+  // The minor version stored in the header after "DRACO" and the major
+  // version is raised to 3 only for meshes that need it.
+  ASSERT_EQ(buffer.data()[6], 3);
+  EncoderBuffer no_blocks_buffer;
+  EncodeMesh(*mesh, 0, 0, &no_blocks_buffer);
+  ASSERT_EQ(no_blocks_buffer.data()[6], 2);
+
+  // Change the minor version stored in the header after "DRACO" and the major
+  // version.
+  std::vector<char> old_version_data(buffer.data(),
+                                     buffer.data() + buffer.size());
+  old_version_data[6] = 2;
+  Mesh old_version_mesh;
+  ASSERT_FALSE(DecodeMesh(old_version_data.data(), old_version_data.size(), 0,
+                          &old_version_mesh)
+                   .ok());
+}
+
+TEST_F(MeshSequentialEncodingTest, TestRandomAccessRejectedInOldVersion) {
+  const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  EncoderBuffer buffer;
+  EncodeRandomAccessMesh(*mesh, 16, &buffer);
+  std::vector<char> old_version_data(buffer.data(),
+                                     buffer.data() + buffer.size());
+  old_version_data[6] = 2;
+  Mesh old_version_mesh;
+  ASSERT_FALSE(DecodeMesh(old_version_data.data(), old_version_data.size(), 0,
+                          &old_version_mesh)
+                   .ok());
+}
+
+TEST_F(MeshSequentialEncodingTest, TestRandomAccessEncoding) {
+  // Meshes encoded in blocks must decode to the same mesh as without blocks,
+  // up to the order of points.
+  for (const std::string file_name : {"test_nm.obj", "cube_att.obj"}) {
+    TestRandomAccessEncoding(file_name);
+  }
+}
+
+TEST_F(MeshSequentialEncodingTest, TestDecodeFaceRange) {
+  const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  EncoderBuffer buffer;
+  EncodeRandomAccessMesh(*mesh, 16, &buffer);
+  DecoderBuffer in_buffer;
+  in_buffer.Init(buffer.data(), buffer.size());
+  Decoder decoder;
+  auto ref_mesh = decoder.DecodeMeshFromBuffer(&in_buffer).value();
+  const uint32_t num_faces = ref_mesh->num_faces();
+
+  const std::vector<std::pair<uint32_t, uint32_t>> ranges = {
+      {0, num_faces}, {0, 1}, {5, 30}, {17, 16}, {num_faces - 3, 3},
+      {num_faces, 0}};
+  for (const auto &range : ranges) {
+    in_buffer.Init(buffer.data(), buffer.size());
+    auto status_or =
+        decoder.DecodeFaceRange(&in_buffer, range.first, range.second);
+    ASSERT_TRUE(status_or.ok()) << status_or.status().error_msg();
+    const std::unique_ptr<Mesh> range_mesh = std::move(status_or).value();
+    ASSERT_EQ(range_mesh->num_faces(), range.second);
+    ASSERT_LE(range_mesh->num_points(), ref_mesh->num_points());
+    for (FaceIndex fi(0); fi < range.second; ++fi) {
+      const Mesh::Face &ref_face = ref_mesh->face(fi + range.first);
+      const Mesh::Face &face = range_mesh->face(fi);
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_LT(face[c].value(), range_mesh->num_points());
+        ASSERT_TRUE(
+            ArePointsEqual(*ref_mesh, ref_face[c], *range_mesh, face[c]));
+      }
+    }
+  }
+  // A small range of faces should need only a part of the points.
+  in_buffer.Init(buffer.data(), buffer.size());
+  const std::unique_ptr<Mesh> range_mesh =
+      decoder.DecodeFaceRange(&in_buffer, 0, 1).value();
+  ASSERT_LT(range_mesh->num_points(), ref_mesh->num_points());
+
+  // Ranges outside of the mesh are rejected.
+  in_buffer.Init(buffer.data(), buffer.size());
+  ASSERT_FALSE(decoder.DecodeFaceRange(&in_buffer, num_faces, 1).ok());
+  in_buffer.Init(buffer.data(), buffer.size());
+  ASSERT_FALSE(decoder.DecodeFaceRange(&in_buffer, 1, num_faces).ok());
+}
+
+TEST_F(MeshSequentialEncodingTest, TestDecodeFaceRangeWithoutBlocks) {
+  // Face ranges cannot be decoded from meshes encoded without blocks.
+  const std::unique_ptr<Mesh> mesh = ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  EncoderBuffer buffer;
+  EncodeRandomAccessMesh(*mesh, 0, &buffer);
+  DecoderBuffer in_buffer;
+  in_buffer.Init(buffer.data(), buffer.size());
+  Decoder decoder;
+  ASSERT_FALSE(decoder.DecodeFaceRange(&in_buffer, 0, 1).ok());
+}
+
+}  // namespace draco
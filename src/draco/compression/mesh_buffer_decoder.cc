@@ -0,0 +1,267 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/mesh_buffer_decoder.h"
+
+#include <cstring>
+
+#include "draco/attributes/attribute_octahedron_transform.h"
+#include "draco/attributes/attribute_quantization_transform.h"
+#include "draco/compression/attributes/normal_compression_utils.h"
+#include "draco/compression/decode.h"
+#include "draco/core/quantization_utils.h"
+
+namespace draco {
+
+namespace {
+
+// Writes values of |att| for all |num_points| points converted to OutT.
+template <typename OutT>
+void WriteConvertedValues(const PointAttribute &att, int num_points,
+                          int num_components, int64_t byte_stride,
+                          uint8_t *out_data) {
+  std::vector<OutT> value(num_components);
+  for (PointIndex pi(0); pi < static_cast<uint32_t>(num_points); ++pi) {
+    att.ConvertValue<OutT>(att.mapped_index(pi), num_components, &value[0]);
+    memcpy(out_data, &value[0], sizeof(OutT) * num_components);
+    out_data += byte_stride;
+  }
+}
+
+// Reads a portable (integer) value of |att| for a given point.
+inline void GetPortableValue(const PointAttribute &att, PointIndex pi,
+                             int num_components, int32_t *out_value) {
+  memcpy(out_value, att.GetAddress(att.mapped_index(pi)),
+         sizeof(int32_t) * num_components);
+}
+
+}  // namespace
+
+MeshBufferDecoder::MeshBufferDecoder() {
+  // Keep all transformed attributes in the portable format. The final
+  // transform is applied when the values are written to the output buffers.
+  // Attributes without any transform (e.g. integer attributes) are decoded in
+  // their original format.
+  for (int i = 0; i < GeometryAttribute::NAMED_ATTRIBUTES_COUNT; ++i) {
+    const GeometryAttribute::Type att_type =
+        static_cast<GeometryAttribute::Type>(i);
+    options_.SetAttributeBool(att_type, "skip_attribute_transform", true);
+    options_.SetAttributeBool(att_type, "keep_untransformed_attributes", true);
+  }
+}
+
+Status MeshBufferDecoder::Decode(DecoderBuffer *in_buffer) {
+  Decoder decoder;
+  *decoder.options() = options_;
+  DRACO_ASSIGN_OR_RETURN(mesh_, decoder.DecodeMeshFromBuffer(in_buffer));
+  return OkStatus();
+}
+
+int MeshBufferDecoder::num_vertices() const {
+  return mesh_ ? static_cast<int>(mesh_->num_points()) : 0;
+}
+
+int MeshBufferDecoder::num_indices() const {
+  return mesh_ ? 3 * static_cast<int>(mesh_->num_faces()) : 0;
+}
+
+int MeshBufferDecoder::num_attributes() const {
+  return mesh_ ? mesh_->num_attributes() : 0;
+}
+
+const GeometryAttribute *MeshBufferDecoder::attribute(int att_id) const {
+  if (att_id < 0 || att_id >= num_attributes())
+    return nullptr;
+  return mesh_->attribute(att_id);
+}
+
+int MeshBufferDecoder::GetNamedAttributeId(GeometryAttribute::Type type) const {
+  return mesh_ ? mesh_->GetNamedAttributeId(type) : -1;
+}
+
+Status MeshBufferDecoder::WriteVertices(const VertexBufferLayout &layout,
+                                        void *out_data,
+                                        size_t out_size) const {
+  if (!mesh_)
+    return Status(Status::DRACO_ERROR, "No decoded mesh.");
+  if (num_vertices() == 0)
+    return OkStatus();
+  for (const VertexElementLayout &element : layout.elements) {
+    if (element.attribute_id < 0 || element.attribute_id >= num_attributes())
+      return Status(Status::DRACO_ERROR, "Invalid attribute id.");
+    const int64_t element_size =
+        DataTypeLength(element.data_type) * element.num_components;
+    if (element_size <= 0 || element.byte_offset < 0 ||
+        element.byte_offset + element_size > layout.byte_stride)
+      return Status(Status::DRACO_ERROR, "Invalid vertex element layout.");
+    if ((num_vertices() - 1) * layout.byte_stride + element.byte_offset +
+            element_size >
+        static_cast<int64_t>(out_size))
+      return Status(Status::DRACO_ERROR, "Output vertex buffer is too small.");
+  }
+  for (const VertexElementLayout &element : layout.elements) {
+    DRACO_RETURN_IF_ERROR(WriteElement(
+        element, layout.byte_stride,
+        static_cast<uint8_t *>(out_data) + element.byte_offset));
+  }
+  return OkStatus();
+}
+
+Status MeshBufferDecoder::WriteElement(const VertexElementLayout &element,
+                                       int64_t byte_stride,
+                                       uint8_t *out_data) const {
+  const PointAttribute &att = *mesh_->attribute(element.attribute_id);
+  const int num_points = num_vertices();
+  const int num_components = element.num_components;
+  const AttributeTransformData *const transform_data =
+      att.GetAttributeTransformData();
+  if (transform_data == nullptr) {
+    // Values are stored in their original format.
+    switch (element.data_type) {
+      case DT_INT8:
+        WriteConvertedValues<int8_t>(att, num_points, num_components,
+                                     byte_stride, out_data);
+        break;
+      case DT_UINT8:
+        WriteConvertedValues<uint8_t>(att, num_points, num_components,
+                                      byte_stride, out_data);
+        break;
+      case DT_INT16:
+        WriteConvertedValues<int16_t>(att, num_points, num_components,
+                                      byte_stride, out_data);
+        break;
+      case DT_UINT16:
+        WriteConvertedValues<uint16_t>(att, num_points, num_components,
+                                       byte_stride, out_data);
+        break;
+      case DT_INT32:
+        WriteConvertedValues<int32_t>(att, num_points, num_components,
+                                      byte_stride, out_data);
+        break;
+      case DT_UINT32:
+        WriteConvertedValues<uint32_t>(att, num_points, num_components,
+                                       byte_stride, out_data);
+        break;
+      case DT_FLOAT32:
+        WriteConvertedValues<float>(att, num_points, num_components,
+                                    byte_stride, out_data);
+        break;
+      default:
+        return Status(Status::DRACO_ERROR, "Unsupported output data type.");
+    }
+    return OkStatus();
+  }
+
+  // Values are stored in the portable format. Apply the inverse transform.
+  if (element.data_type != DT_FLOAT32)
+    return Status(Status::DRACO_ERROR, "Unsupported output data type.");
+  if (att.data_type() != DT_INT32 && att.data_type() != DT_UINT32)
+    return Status(Status::DRACO_ERROR, "Unsupported portable data type.");
+  std::vector<float> value(num_components, 0.f);
+  if (transform_data->transform_type() == ATTRIBUTE_QUANTIZATION_TRANSFORM) {
+    AttributeQuantizationTransform transform;
+    if (!transform.InitFromAttribute(att))
+      return Status(Status::DRACO_ERROR, "Invalid quantization data.");
+    const int32_t max_quantized_value =
+        (1u << static_cast<uint32_t>(transform.quantization_bits())) - 1;
+    Dequantizer dequantizer;
+    if (!dequantizer.Init(transform.range(), max_quantized_value))
+      return Status(Status::DRACO_ERROR, "Invalid quantization data.");
+    const int att_components = att.num_components();
+    const int num_used_components = std::min(att_components, num_components);
+    std::vector<int32_t> quantized_value(att_components);
+    for (PointIndex pi(0); pi < static_cast<uint32_t>(num_points); ++pi) {
+      GetPortableValue(att, pi, att_components, &quantized_value[0]);
+      for (int c = 0; c < num_used_components; ++c) {
+        value[c] = dequantizer.DequantizeFloat(quantized_value[c]) +
+                   transform.min_value(c);
+      }
+      memcpy(out_data, &value[0], sizeof(float) * num_components);
+      out_data += byte_stride;
+    }
+  } else if (transform_data->transform_type() ==
+             ATTRIBUTE_OCTAHEDRON_TRANSFORM) {
+    AttributeOctahedronTransform transform;
+    if (!transform.InitFromAttribute(att) || att.num_components() != 2)
+      return Status(Status::DRACO_ERROR, "Invalid octahedron data.");
+    OctahedronToolBox octahedron_tool_box;
+    if (!octahedron_tool_box.SetQuantizationBits(transform.quantization_bits()))
+      return Status(Status::DRACO_ERROR, "Invalid octahedron data.");
+    const int num_used_components = std::min(3, num_components);
+    // The values are converted in batches. Normals with three components are
+    // written directly to the output, others are padded or truncated.
+    constexpr int kBatchSize = 256;
+    int32_t st[2 * kBatchSize];
+    float normals[3 * kBatchSize];
+    for (int batch_start = 0; batch_start < num_points;
+         batch_start += kBatchSize) {
+      const int batch_size = std::min(kBatchSize, num_points - batch_start);
+      for (int i = 0; i < batch_size; ++i) {
+        GetPortableValue(att, PointIndex(batch_start + i), 2, st + 2 * i);
+      }
+      if (num_components == 3) {
+        octahedron_tool_box.QuantizedOctahedralCoordsToUnitVectors(
+            st, batch_size, out_data, byte_stride);
+        out_data += batch_size * byte_stride;
+        continue;
+      }
+      octahedron_tool_box.QuantizedOctahedralCoordsToUnitVectors(
+          st, batch_size, reinterpret_cast<uint8_t *>(normals),
+          3 * sizeof(float));
+      for (int i = 0; i < batch_size; ++i) {
+        for (int c = 0; c < num_used_components; ++c) {
+          value[c] = normals[3 * i + c];
+        }
+        memcpy(out_data, &value[0], sizeof(float) * num_components);
+        out_data += byte_stride;
+      }
+    }
+  } else {
+    return Status(Status::DRACO_ERROR, "Unsupported attribute transform.");
+  }
+  return OkStatus();
+}
+
+Status MeshBufferDecoder::WriteIndices(DataType index_type, void *out_data,
+                                       size_t out_size) const {
+  if (!mesh_)
+    return Status(Status::DRACO_ERROR, "No decoded mesh.");
+  if (index_type != DT_UINT16 && index_type != DT_UINT32)
+    return Status(Status::DRACO_ERROR, "Unsupported index type.");
+  if (index_type == DT_UINT16 && num_vertices() > (1 << 16))
+    return Status(Status::DRACO_ERROR, "Too many vertices for 16-bit indices.");
+  if (static_cast<size_t>(num_indices()) * DataTypeLength(index_type) >
+      out_size)
+    return Status(Status::DRACO_ERROR, "Output index buffer is too small.");
+  if (index_type == DT_UINT16) {
+    uint16_t *out_indices = static_cast<uint16_t *>(out_data);
+    for (FaceIndex fi(0); fi < mesh_->num_faces(); ++fi) {
+      const Mesh::Face &face = mesh_->face(fi);
+      for (int c = 0; c < 3; ++c) {
+        *out_indices++ = static_cast<uint16_t>(face[c].value());
+      }
+    }
+  } else {
+    uint32_t *out_indices = static_cast<uint32_t *>(out_data);
+    for (FaceIndex fi(0); fi < mesh_->num_faces(); ++fi) {
+      const Mesh::Face &face = mesh_->face(fi);
+      for (int c = 0; c < 3; ++c) {
+        *out_indices++ = face[c].value();
+      }
+    }
+  }
+  return OkStatus();
+}
+
+}  // namespace draco
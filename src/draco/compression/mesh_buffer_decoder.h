@@ -0,0 +1,123 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_MESH_BUFFER_DECODER_H_
+#define DRACO_COMPRESSION_MESH_BUFFER_DECODER_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/config/decoder_options.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Describes how a single attribute is stored in a vertex buffer.
+struct VertexElementLayout {
+  VertexElementLayout()
+      : attribute_id(-1),
+        data_type(DT_FLOAT32),
+        num_components(0),
+        byte_offset(0) {}
+  VertexElementLayout(int att_id, DataType type, int components, int64_t offset)
+      : attribute_id(att_id),
+        data_type(type),
+        num_components(components),
+        byte_offset(offset) {}
+
+  // Id of the decoded attribute that is written to the vertex buffer.
+  int attribute_id;
+  // Data type and number of components of the written values. Missing
+  // components are filled with zeros. Attributes that are quantized in the
+  // encoded data can be written only as DT_FLOAT32.
+  DataType data_type;
+  int num_components;
+  // Offset of the element from the start of each vertex in bytes.
+  int64_t byte_offset;
+};
+
+// Describes the layout of a (possibly interleaved) vertex buffer.
+struct VertexBufferLayout {
+  VertexBufferLayout() : byte_stride(0) {}
+
+  std::vector<VertexElementLayout> elements;
+  // Number of bytes between two consecutive vertices.
+  int64_t byte_stride;
+};
+
+// Decoder that writes decoded meshes directly into vertex and index buffers
+// provided by the caller (e.g. mapped GPU buffers), using the layout requested
+// by the caller. The decoded attributes are kept in their compact portable
+// form (e.g. quantized values) and the final transform (dequantization,
+// octahedral decoding) is applied while the values are written into the
+// output buffers. This avoids creation of the full precision draco::Mesh and
+// the subsequent copy into the output buffers.
+//
+// Usage:
+//   MeshBufferDecoder decoder;
+//   DRACO_RETURN_IF_ERROR(decoder.Decode(&in_buffer));
+//   // Allocate |decoder.num_vertices()| vertices and |decoder.num_indices()|
+//   // indices.
+//   VertexBufferLayout layout;
+//   ...
+//   DRACO_RETURN_IF_ERROR(decoder.WriteVertices(layout, vertices, size));
+//   DRACO_RETURN_IF_ERROR(decoder.WriteIndices(DT_UINT32, indices, size));
+class MeshBufferDecoder {
+ public:
+  MeshBufferDecoder();
+
+  // Decodes the connectivity and the portable attribute data of the mesh
+  // encoded in |in_buffer|.
+  Status Decode(DecoderBuffer *in_buffer);
+
+  // Returns the number of vertices and indices of the last decoded mesh.
+  int num_vertices() const;
+  int num_indices() const;
+
+  // Returns the number of attributes of the last decoded mesh.
+  int num_attributes() const;
+  // Returns the decoded attribute with the given id. Note that the returned
+  // attribute may store the values in the portable format.
+  const GeometryAttribute *attribute(int att_id) const;
+  // Returns the id of the first decoded attribute of a given |type| or -1 when
+  // no such attribute exists.
+  int GetNamedAttributeId(GeometryAttribute::Type type) const;
+
+  // Writes the decoded attribute values of all vertices into |out_data| using
+  // the provided |layout|. |out_size| is the size of |out_data| in bytes.
+  Status WriteVertices(const VertexBufferLayout &layout, void *out_data,
+                       size_t out_size) const;
+
+  // Writes indices of all triangles into |out_data|. |index_type| must be
+  // either DT_UINT16 or DT_UINT32. |out_size| is the size of |out_data| in
+  // bytes.
+  Status WriteIndices(DataType index_type, void *out_data,
+                      size_t out_size) const;
+
+  // Returns the options used by the decoder.
+  DecoderOptions *options() { return &options_; }
+
+ private:
+  Status WriteElement(const VertexElementLayout &element, int64_t byte_stride,
+                      uint8_t *out_data) const;
+
+  DecoderOptions options_;
+  std::unique_ptr<Mesh> mesh_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_MESH_BUFFER_DECODER_H_
@@ -0,0 +1,130 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/mesh_buffer_decoder.h"
+
+#include <cstring>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace {
+
+class MeshBufferDecoderTest : public ::testing::Test {
+ protected:
+  // Encodes the mesh from |file_name| and verifies that the vertices written by
+  // the MeshBufferDecoder match the attribute values decoded by draco::Decoder.
+  void TestDecoding(const std::string &file_name, bool quantize) {
+    const std::unique_ptr<draco::Mesh> mesh =
+        draco::ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    draco::Encoder encoder;
+    if (quantize) {
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD,
+                                       12);
+      encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+    }
+    draco::EncoderBuffer buffer;
+    ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, &buffer).ok());
+
+    draco::DecoderBuffer in_buffer;
+    in_buffer.Init(buffer.data(), buffer.size());
+    draco::Decoder decoder;
+    auto status_or = decoder.DecodeMeshFromBuffer(&in_buffer);
+    ASSERT_TRUE(status_or.ok());
+    const std::unique_ptr<draco::Mesh> ref_mesh = std::move(status_or).value();
+
+    in_buffer.Init(buffer.data(), buffer.size());
+    draco::MeshBufferDecoder buffer_decoder;
+    ASSERT_TRUE(buffer_decoder.Decode(&in_buffer).ok());
+    ASSERT_EQ(buffer_decoder.num_vertices(), ref_mesh->num_points());
+    ASSERT_EQ(buffer_decoder.num_indices(), 3 * ref_mesh->num_faces());
+    ASSERT_EQ(buffer_decoder.num_attributes(), ref_mesh->num_attributes());
+
+    // Write all attributes as floats into a single interleaved buffer.
+    draco::VertexBufferLayout layout;
+    for (int i = 0; i < ref_mesh->num_attributes(); ++i) {
+      const int num_components = ref_mesh->attribute(i)->num_components();
+      const int out_num_components =
+          ref_mesh->attribute(i)->attribute_type() ==
+                  draco::GeometryAttribute::NORMAL
+              ? 3
+              : num_components;
+      layout.elements.push_back(draco::VertexElementLayout(
+          i, draco::DT_FLOAT32, out_num_components, layout.byte_stride));
+      layout.byte_stride += sizeof(float) * out_num_components;
+    }
+    std::vector<uint8_t> vertices(buffer_decoder.num_vertices() *
+                                  layout.byte_stride);
+    ASSERT_TRUE(
+        buffer_decoder
+            .WriteVertices(layout, vertices.data(), vertices.size() - 1)
+            .code() == draco::Status::DRACO_ERROR);
+    ASSERT_TRUE(
+        buffer_decoder.WriteVertices(layout, vertices.data(), vertices.size())
+            .ok());
+    for (const draco::VertexElementLayout &element : layout.elements) {
+      const draco::PointAttribute *const att =
+          ref_mesh->attribute(element.attribute_id);
+      std::vector<float> ref_value(element.num_components);
+      for (draco::PointIndex pi(0); pi < ref_mesh->num_points(); ++pi) {
+        att->ConvertValue<float>(att->mapped_index(pi), element.num_components,
+                                 &ref_value[0]);
+        ASSERT_EQ(std::memcmp(&ref_value[0],
+                              &vertices[pi.value() * layout.byte_stride +
+                                        element.byte_offset],
+                              sizeof(float) * element.num_components),
+                  0);
+      }
+    }
+
+    // Indices.
+    std::vector<uint32_t> indices(buffer_decoder.num_indices());
+    ASSERT_TRUE(buffer_decoder
+                    .WriteIndices(draco::DT_UINT32, indices.data(),
+                                  indices.size() * sizeof(uint32_t))
+                    .ok());
+    std::vector<uint16_t> indices_16(buffer_decoder.num_indices());
+    ASSERT_TRUE(buffer_decoder
+                    .WriteIndices(draco::DT_UINT16, indices_16.data(),
+                                  indices_16.size() * sizeof(uint16_t))
+                    .ok());
+    for (draco::FaceIndex fi(0); fi < ref_mesh->num_faces(); ++fi) {
+      for (int c = 0; c < 3; ++c) {
+        const uint32_t index = ref_mesh->face(fi)[c].value();
+        ASSERT_EQ(indices[3 * fi.value() + c], index);
+        ASSERT_EQ(indices_16[3 * fi.value() + c], index);
+      }
+    }
+  }
+};
+
+TEST_F(MeshBufferDecoderTest, TestQuantizedMesh) {
+  TestDecoding("cube_att.obj", true);
+  TestDecoding("test_nm.obj", true);
+}
+
+TEST_F(MeshBufferDecoderTest, TestLosslessMesh) {
+  TestDecoding("cube_att.obj", false);
+}
+
+TEST_F(MeshBufferDecoderTest, TestIntegerAttributes) {
+  // Mesh with normalized 8-bit colors.
+  TestDecoding("test_pos_color.ply", true);
+}
+
+}  // namespace
@@ -14,6 +14,11 @@
 //
 #include "draco/compression/point_cloud/point_cloud_decoder.h"
 
+#include <algorithm>
+#include <future>
+#include <memory>
+
+#include "draco/core/thread_pool.h"
 #include "draco/metadata/metadata_decoder.h"
 
 namespace draco {
@@ -58,9 +63,20 @@ Status PointCloudDecoder::DecodeMetadata() {
 Status PointCloudDecoder::Decode(const DecoderOptions &options,
                                  DecoderBuffer *in_buffer,
                                  PointCloud *out_point_cloud) {
+  DRACO_RETURN_IF_ERROR(StartDecoding(options, in_buffer, out_point_cloud))
+  DRACO_RETURN_IF_ERROR(DecodeGeometry())
+  return DecodeAttributes();
+}
+
+Status PointCloudDecoder::StartDecoding(const DecoderOptions &options,
+                                        DecoderBuffer *in_buffer,
+                                        PointCloud *out_point_cloud) {
   options_ = &options;
   buffer_ = in_buffer;
   point_cloud_ = out_point_cloud;
+  // Decoders can be reused for multiple geometries.
+  attributes_decoders_.clear();
+  attribute_to_decoder_map_.clear();
   DracoHeader header;
   DRACO_RETURN_IF_ERROR(DecodeHeader(buffer_, &header))
   // Sanity check that we are really using the right decoder (mostly for cases
@@ -94,8 +110,19 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
   }
   if (!InitializeDecoder())
     return Status(Status::DRACO_ERROR, "Failed to initialize the decoder.");
+  return OkStatus();
+}
+
+Status PointCloudDecoder::DecodeGeometry() {
   if (!DecodeGeometryData())
     return Status(Status::DRACO_ERROR, "Failed to decode geometry data.");
+  return OkStatus();
+}
+
+Status PointCloudDecoder::DecodeAttributes() {
+  if (GetGeometryType() == TRIANGULAR_MESH &&
+      options_->GetGlobalBool("decode_connectivity_only", false))
+    return OkStatus();  // Only the mesh connectivity was requested.
   if (!DecodePointAttributes())
     return Status(Status::DRACO_ERROR, "Failed to decode point attributes.");
   return OkStatus();
@@ -147,6 +174,12 @@ bool PointCloudDecoder::DecodePointAttributes() {
 }
 
 bool PointCloudDecoder::DecodeAllAttributes() {
+  // Older bit-streams use the final (non-portable) attributes for predictions
+  // so their decoding cannot be split into multiple steps.
+  const int num_threads =
+      options_->GetGlobalInt("num_attribute_decoding_threads", 0);
+  if (num_threads > 0 && bitstream_version() >= DRACO_BITSTREAM_VERSION(2, 0))
+    return DecodeAllAttributesInParallel(num_threads);
   for (auto &att_dec : attributes_decoders_) {
     if (!att_dec->DecodeAttributes(buffer_))
       return false;
@@ -154,6 +187,64 @@ bool PointCloudDecoder::DecodeAllAttributes() {
   return true;
 }
 
+bool PointCloudDecoder::DecodeAllAttributesInParallel(int num_threads) {
+  // Data of all attributes decoders are stored in the buffer one after
+  // another without any explicit size so the buffer needs to be processed
+  // sequentially. The remaining work of each decoder (such as reverting of
+  // prediction schemes and attribute transforms) is finalized on the thread
+  // pool, while the main thread continues with decoding of the buffer for the
+  // subsequent decoders.
+  const int num_decoders = static_cast<int>(attributes_decoders_.size());
+  std::vector<std::shared_future<bool>> finalized(num_decoders);
+  bool decoded = true;
+  {
+    ThreadPool pool(std::min(num_threads, num_decoders));
+    for (int i = 0; i < num_decoders; ++i) {
+      if (!attributes_decoders_[i]->DecodeAttributesData(buffer_)) {
+        decoded = false;
+        break;
+      }
+      // Finalization of the decoder must wait until all decoders of its
+      // parent attributes are finalized. Parent attributes are always decoded
+      // by an earlier decoder (or by the same decoder).
+      std::vector<std::shared_future<bool>> parents;
+      for (const int32_t att_id :
+           attributes_decoders_[i]->GetParentAttributeIds()) {
+        if (att_id < 0 ||
+            att_id >= static_cast<int32_t>(attribute_to_decoder_map_.size()) ||
+            attribute_to_decoder_map_[att_id] > i) {
+          decoded = false;
+          break;
+        }
+        if (attribute_to_decoder_map_[att_id] < i)
+          parents.push_back(finalized[attribute_to_decoder_map_[att_id]]);
+      }
+      if (!decoded)
+        break;
+      AttributesDecoderInterface *const att_dec =
+          attributes_decoders_[i].get();
+      const std::shared_ptr<std::packaged_task<bool()>> task =
+          std::make_shared<std::packaged_task<bool()>>([att_dec, parents]() {
+            for (const std::shared_future<bool> &parent : parents) {
+              if (!parent.get())
+                return false;
+            }
+            return att_dec->FinalizeAttributes();
+          });
+      finalized[i] = task->get_future().share();
+      pool.Schedule([task]() { (*task)(); });
+    }
+    // The pool waits for all scheduled tasks when it is destroyed.
+  }
+  if (!decoded)
+    return false;
+  for (const std::shared_future<bool> &decoder_finalized : finalized) {
+    if (!decoder_finalized.get())
+      return false;
+  }
+  return true;
+}
+
 const PointAttribute *PointCloudDecoder::GetPortableAttribute(
     int32_t parent_att_id) {
   if (parent_att_id < 0 || parent_att_id >= point_cloud_->num_attributes())
@@ -40,6 +40,18 @@ class PointCloudDecoder {
   Status Decode(const DecoderOptions &options, DecoderBuffer *in_buffer,
                 PointCloud *out_point_cloud);
 
+  // Decode() can also be performed in separate stages that must be called in
+  // the following order. This is useful for decoders that receive the input
+  // data incrementally (see StreamingDecoder).
+  //
+  // Decodes the header and the metadata and initializes the decoder.
+  Status StartDecoding(const DecoderOptions &options, DecoderBuffer *in_buffer,
+                       PointCloud *out_point_cloud);
+  // Decodes the geometry data (e.g. mesh connectivity).
+  Status DecodeGeometry();
+  // Decodes all point attributes.
+  Status DecodeAttributes();
+
   bool SetAttributesDecoder(
       int att_decoder_id, std::unique_ptr<AttributesDecoderInterface> decoder) {
     if (att_decoder_id < 0)
@@ -87,12 +99,18 @@ class PointCloudDecoder {
   virtual bool DecodeGeometryData() { return true; }
   virtual bool DecodePointAttributes();
 
+  // Decodes data of all attributes decoders. When the
+  // "num_attribute_decoding_threads" option is set to a positive number, the
+  // decoding is split between the calling thread and the given number of
+  // worker threads (see DecodeAllAttributesInParallel()).
   virtual bool DecodeAllAttributes();
   virtual bool OnAttributesDecoded() { return true; }
 
   Status DecodeMetadata();
 
  private:
+  bool DecodeAllAttributesInParallel(int num_threads);
+
   // Point cloud that is being filled in by the decoder.
   PointCloud *point_cloud_;
 
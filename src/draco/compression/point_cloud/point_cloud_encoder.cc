@@ -60,9 +60,7 @@ Status PointCloudEncoder::EncodeHeader() {
   const uint8_t version_major = encoder_type == POINT_CLOUD
                                     ? kDracoPointCloudBitstreamVersionMajor
                                     : kDracoMeshBitstreamVersionMajor;
-  const uint8_t version_minor = encoder_type == POINT_CLOUD
-                                    ? kDracoPointCloudBitstreamVersionMinor
-                                    : kDracoMeshBitstreamVersionMinor;
+  const uint8_t version_minor = GetBitstreamVersionMinor();
   buffer_->Encode(version_major);
   buffer_->Encode(version_minor);
   // Type of the encoder (point cloud, mesh, ...).
@@ -173,6 +171,16 @@ const PointAttribute *PointCloudEncoder::GetPortableAttribute(
       parent_att_id);
 }
 
+std::unique_ptr<PointAttribute>
+PointCloudEncoder::CreateMappedPortableAttribute(int32_t parent_att_id) {
+  if (parent_att_id < 0 || parent_att_id >= point_cloud_->num_attributes())
+    return nullptr;
+  const int32_t parent_att_encoder_id =
+      attribute_to_encoder_map_[parent_att_id];
+  return attributes_encoders_[parent_att_encoder_id]
+      ->CreateMappedPortableAttribute(parent_att_id);
+}
+
 bool PointCloudEncoder::RearrangeAttributesEncoders() {
   // Find the encoding order of the attribute encoders that is determined by
   // the parent dependencies between individual encoders. Instead of traversing
@@ -44,6 +44,14 @@ class PointCloudEncoder {
   // for mesh compression).
   virtual uint8_t GetEncodingMethod() const = 0;
 
+  // Returns the minor bit-stream version written to the header of the encoded
+  // geometry. Must be called after the encoder options were set.
+  virtual uint8_t GetBitstreamVersionMinor() const {
+    return GetGeometryType() == POINT_CLOUD
+               ? kDracoPointCloudBitstreamVersionMinor
+               : kDracoMeshDefaultBitstreamVersionMinor;
+  }
+
   // Returns the number of points that were encoded during the last Encode()
   // function call. Valid only if "store_number_of_encoded_points" flag was set
   // in the provided EncoderOptions.
@@ -72,6 +80,12 @@ class PointCloudEncoder {
   // as predictor for other attributes.
   const PointAttribute *GetPortableAttribute(int32_t point_attribute_id);
 
+  // Returns a copy of the portable attribute that can be used as a predictor
+  // for other attributes before the attribute is marked as a parent. Returns
+  // nullptr when GetPortableAttribute() can be used instead.
+  std::unique_ptr<PointAttribute> CreateMappedPortableAttribute(
+      int32_t point_attribute_id);
+
   EncoderBuffer *buffer() { return buffer_; }
   const EncoderOptions *options() const { return options_; }
   const PointCloud *point_cloud() const { return point_cloud_; }
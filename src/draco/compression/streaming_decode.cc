@@ -0,0 +1,164 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/streaming_decode.h"
+
+#include "draco/compression/decode.h"
+
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+#include "draco/compression/mesh/mesh_decoder.h"
+#endif
+
+#include "draco/compression/point_cloud/point_cloud_decoder.h"
+
+namespace draco {
+
+namespace {
+
+// Returns true when a decoding stage that finished with |status| can be
+// accepted. Unless the input is final, the stage must also end before the end
+// of the available data, because the bit decoders silently return zeros for
+// data past the end of the buffer.
+bool IsStageComplete(const Status &status, const DecoderBuffer &buffer,
+                     bool final_input) {
+  if (!status.ok())
+    return false;
+  return final_input || buffer.remaining_size() > 0;
+}
+
+}  // namespace
+
+StreamingDecoder::StreamingDecoder()
+    : last_attempt_size_(0),
+      input_finished_(false),
+      decoded_stage_(STAGE_NONE),
+      geometry_type_(INVALID_GEOMETRY_TYPE) {}
+
+Status StreamingDecoder::AddInput(const char *data, size_t size) {
+  if (input_finished_)
+    return Status(Status::DRACO_ERROR, "Input was already finished.");
+  data_.insert(data_.end(), data, data + size);
+  if (decoded_stage_ == STAGE_ATTRIBUTES)
+    return OkStatus();
+  if (data_.size() < 2 * last_attempt_size_)
+    return OkStatus();  // Wait for more data.
+  return DecodeAvailableData(false);
+}
+
+Status StreamingDecoder::FinishInput() {
+  if (input_finished_)
+    return Status(Status::DRACO_ERROR, "Input was already finished.");
+  input_finished_ = true;
+  if (decoded_stage_ == STAGE_ATTRIBUTES)
+    return OkStatus();
+  return DecodeAvailableData(true);
+}
+
+const Mesh *StreamingDecoder::mesh() const {
+  if (geometry_type_ != TRIANGULAR_MESH)
+    return nullptr;
+  return static_cast<const Mesh *>(point_cloud_.get());
+}
+
+Status StreamingDecoder::DecodeAvailableData(bool final_input) {
+  last_attempt_size_ = data_.size();
+  DecoderBuffer buffer;
+  buffer.Init(data_.data(), data_.size());
+  DracoHeader header;
+  {
+    DecoderBuffer temp_buffer(buffer);
+    const Status status =
+        PointCloudDecoder::DecodeHeader(&temp_buffer, &header);
+    if (!status.ok()) {
+      if (!final_input && status.code() == Status::IO_ERROR)
+        return OkStatus();  // Not enough data.
+      return status;
+    }
+  }
+  if (header.encoder_type != POINT_CLOUD &&
+      header.encoder_type != TRIANGULAR_MESH)
+    return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+  geometry_type_ = static_cast<EncodedGeometryType>(header.encoder_type);
+
+  // Older bitstreams and chunked meshes are not decoded in stages.
+  if (DRACO_BITSTREAM_VERSION(header.version_major, header.version_minor) <
+          DRACO_BITSTREAM_VERSION(2, 2) ||
+      header.encoder_method == MESH_CHUNKED_ENCODING) {
+    if (!final_input)
+      return OkStatus();
+    return DecodeAll();
+  }
+
+  // Each attempt decodes the geometry from the beginning of the input.
+  std::unique_ptr<PointCloud> point_cloud;
+  std::unique_ptr<PointCloudDecoder> decoder;
+  Status status = OkStatus();
+  if (geometry_type_ == TRIANGULAR_MESH) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+    std::unique_ptr<Mesh> mesh(new Mesh());
+    DRACO_ASSIGN_OR_RETURN(std::unique_ptr<MeshDecoder> mesh_decoder,
+                           CreateMeshDecoder(header.encoder_method))
+    status = mesh_decoder->StartDecoding(options_, &buffer, mesh.get());
+    point_cloud = std::move(mesh);
+    decoder = std::move(mesh_decoder);
+#endif
+  } else {
+#ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
+    point_cloud = std::unique_ptr<PointCloud>(new PointCloud());
+    DRACO_ASSIGN_OR_RETURN(decoder,
+                           CreatePointCloudDecoder(header.encoder_method))
+    status = decoder->StartDecoding(options_, &buffer, point_cloud.get());
+#endif
+  }
+  if (decoder == nullptr)
+    return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+
+  Stage stage = STAGE_NONE;
+  if (IsStageComplete(status, buffer, final_input)) {
+    stage = STAGE_HEADER;
+    status = decoder->DecodeGeometry();
+    if (IsStageComplete(status, buffer, final_input)) {
+      stage = STAGE_CONNECTIVITY;
+      status = decoder->DecodeAttributes();
+      if (IsStageComplete(status, buffer, final_input))
+        stage = STAGE_ATTRIBUTES;
+    }
+  }
+  if (final_input && stage != STAGE_ATTRIBUTES)
+    return status;
+  if (stage <= decoded_stage_)
+    return OkStatus();  // No progress.
+  if (stage != STAGE_ATTRIBUTES) {
+    // Remove any partially decoded attributes.
+    while (point_cloud->num_attributes() > 0) {
+      point_cloud->DeleteAttribute(point_cloud->num_attributes() - 1);
+    }
+  }
+  point_cloud_ = std::move(point_cloud);
+  decoded_stage_ = stage;
+  return OkStatus();
+}
+
+Status StreamingDecoder::DecodeAll() {
+  DecoderBuffer buffer;
+  buffer.Init(data_.data(), data_.size());
+  Decoder decoder;
+  *decoder.options() = options_;
+  DRACO_ASSIGN_OR_RETURN(point_cloud_,
+                         decoder.DecodePointCloudFromBuffer(&buffer))
+  decoded_stage_ = STAGE_ATTRIBUTES;
+  return OkStatus();
+}
+
+}  // namespace draco
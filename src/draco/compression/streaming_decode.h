@@ -0,0 +1,120 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_STREAMING_DECODE_H_
+#define DRACO_COMPRESSION_STREAMING_DECODE_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/config/decoder_options.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Decoder of point clouds and meshes that receives the encoded data in
+// multiple chunks (e.g. as they arrive over a network). The decoding
+// progresses through the stages defined below as more input data becomes
+// available and the geometry decoded so far can be inspected after each
+// completed stage. For example, mesh faces can be used as soon as the
+// connectivity stage is complete, while the attribute data is still being
+// received.
+//
+// Usage:
+//   StreamingDecoder decoder;
+//   while (ReadChunk(&chunk)) {
+//     DRACO_RETURN_IF_ERROR(decoder.AddInput(chunk.data(), chunk.size()));
+//     if (decoder.IsStageDecoded(StreamingDecoder::STAGE_CONNECTIVITY))
+//       DisplayMesh(*decoder.mesh());
+//   }
+//   DRACO_RETURN_IF_ERROR(decoder.FinishInput());
+//
+// The encoded data does not store the size of the individual stages so each
+// decoding attempt restarts from the beginning of the input. To keep the
+// total decoding cost linear in the input size, a new attempt is made only
+// after the amount of received data doubles since the last unsuccessful one.
+// Input encoded with bitstreams older than 2.2 and meshes encoded in chunks
+// (MESH_CHUNKED_ENCODING) are decoded only when FinishInput() is called.
+class StreamingDecoder {
+ public:
+  // Decoding stages in the order in which they are completed.
+  enum Stage {
+    STAGE_NONE = 0,
+    // Header and metadata.
+    STAGE_HEADER,
+    // Mesh connectivity (or any other geometry data of point clouds).
+    STAGE_CONNECTIVITY,
+    // All attribute values. The geometry is fully decoded.
+    STAGE_ATTRIBUTES,
+  };
+
+  StreamingDecoder();
+
+  // Appends |size| bytes of |data| to the input and continues decoding.
+  // Returns an error when the input is known to be invalid. Note that errors
+  // caused by corrupted data may be reported only by FinishInput().
+  Status AddInput(const char *data, size_t size);
+
+  // Signals that all input data was received and decodes any remaining
+  // stages. Returns an error when the geometry could not be fully decoded.
+  Status FinishInput();
+
+  // Returns the last stage that was fully decoded.
+  Stage decoded_stage() const { return decoded_stage_; }
+  bool IsStageDecoded(Stage stage) const { return decoded_stage_ >= stage; }
+
+  // Returns the type of the encoded geometry once the header is decoded.
+  EncodedGeometryType geometry_type() const { return geometry_type_; }
+
+  // Returns the geometry decoded so far or nullptr if no stage was decoded
+  // yet. Only data belonging to the decoded stages are valid. The returned
+  // geometry may be replaced by a new instance in AddInput() and
+  // FinishInput().
+  const PointCloud *point_cloud() const { return point_cloud_.get(); }
+  // Returns the decoded mesh or nullptr if the input is not a mesh.
+  const Mesh *mesh() const;
+
+  // Releases the ownership of the decoded geometry. Can be called after the
+  // input was successfully finished.
+  std::unique_ptr<PointCloud> ReleaseGeometry() {
+    return std::move(point_cloud_);
+  }
+
+  // Returns the options used by the decoder. The options must not be changed
+  // after the first call to AddInput().
+  DecoderOptions *options() { return &options_; }
+
+ private:
+  // Decodes as many stages as possible from the currently available data.
+  Status DecodeAvailableData(bool final_input);
+
+  // Decodes the whole input at once using draco::Decoder.
+  Status DecodeAll();
+
+  DecoderOptions options_;
+  std::vector<char> data_;
+  // Size of the input during the last decoding attempt that did not complete
+  // all stages.
+  size_t last_attempt_size_;
+  bool input_finished_;
+  Stage decoded_stage_;
+  EncodedGeometryType geometry_type_;
+  std::unique_ptr<PointCloud> point_cloud_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_STREAMING_DECODE_H_
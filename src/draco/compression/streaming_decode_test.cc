@@ -0,0 +1,170 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/streaming_decode.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace {
+
+class StreamingDecodeTest : public ::testing::Test {
+ protected:
+  void EncodeGeometry(const std::string &file_name, bool point_cloud,
+                      int encoding_method, draco::EncoderBuffer *buffer) {
+    draco::Encoder encoder;
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+    encoder.SetEncodingMethod(encoding_method);
+    if (point_cloud) {
+      const std::unique_ptr<draco::PointCloud> pc =
+          draco::ReadPointCloudFromTestFile(file_name);
+      ASSERT_NE(pc, nullptr);
+      ASSERT_TRUE(encoder.EncodePointCloudToBuffer(*pc, buffer).ok());
+    } else {
+      const std::unique_ptr<draco::Mesh> mesh =
+          draco::ReadMeshFromTestFile(file_name);
+      ASSERT_NE(mesh, nullptr);
+      ASSERT_TRUE(encoder.EncodeMeshToBuffer(*mesh, buffer).ok());
+    }
+  }
+
+  // Returns true when both geometries have the same points and attribute
+  // values.
+  bool AreGeometriesEqual(const draco::PointCloud &pc_0,
+                          const draco::PointCloud &pc_1) {
+    if (pc_0.num_points() != pc_1.num_points() ||
+        pc_0.num_attributes() != pc_1.num_attributes())
+      return false;
+    for (int i = 0; i < pc_0.num_attributes(); ++i) {
+      const draco::PointAttribute *const att_0 = pc_0.attribute(i);
+      const draco::PointAttribute *const att_1 = pc_1.attribute(i);
+      if (att_0->byte_stride() != att_1->byte_stride())
+        return false;
+      for (draco::PointIndex pi(0); pi < pc_0.num_points(); ++pi) {
+        if (std::memcmp(att_0->GetAddress(att_0->mapped_index(pi)),
+                        att_1->GetAddress(att_1->mapped_index(pi)),
+                        att_0->byte_stride()) != 0)
+          return false;
+      }
+    }
+    return true;
+  }
+
+  bool AreFacesEqual(const draco::Mesh &mesh_0, const draco::Mesh &mesh_1) {
+    if (mesh_0.num_faces() != mesh_1.num_faces())
+      return false;
+    for (draco::FaceIndex fi(0); fi < mesh_0.num_faces(); ++fi) {
+      if (mesh_0.face(fi) != mesh_1.face(fi))
+        return false;
+    }
+    return true;
+  }
+
+  // Feeds the encoded |buffer| to the streaming decoder in chunks of
+  // |chunk_size| bytes and verifies the decoded stages against the geometry
+  // decoded by draco::Decoder.
+  void TestStreamingDecoding(const draco::EncoderBuffer &buffer,
+                             size_t chunk_size) {
+    draco::DecoderBuffer in_buffer;
+    in_buffer.Init(buffer.data(), buffer.size());
+    draco::Decoder ref_decoder;
+    auto status_or = ref_decoder.DecodePointCloudFromBuffer(&in_buffer);
+    ASSERT_TRUE(status_or.ok());
+    const std::unique_ptr<draco::PointCloud> ref_pc =
+        std::move(status_or).value();
+    const draco::Mesh *const ref_mesh =
+        dynamic_cast<const draco::Mesh *>(ref_pc.get());
+
+    draco::StreamingDecoder decoder;
+    draco::StreamingDecoder::Stage last_stage =
+        draco::StreamingDecoder::STAGE_NONE;
+    for (size_t offset = 0; offset < buffer.size(); offset += chunk_size) {
+      const size_t size = std::min(chunk_size, buffer.size() - offset);
+      ASSERT_TRUE(decoder.AddInput(buffer.data() + offset, size).ok());
+      // Stages must be decoded in order.
+      ASSERT_GE(decoder.decoded_stage(), last_stage);
+      last_stage = decoder.decoded_stage();
+      if (decoder.IsStageDecoded(draco::StreamingDecoder::STAGE_CONNECTIVITY)) {
+        ASSERT_NE(decoder.point_cloud(), nullptr);
+        ASSERT_EQ(decoder.point_cloud()->num_points(), ref_pc->num_points());
+        if (ref_mesh) {
+          ASSERT_NE(decoder.mesh(), nullptr);
+          ASSERT_TRUE(AreFacesEqual(*decoder.mesh(), *ref_mesh));
+        }
+      }
+    }
+    ASSERT_TRUE(decoder.FinishInput().ok());
+    ASSERT_EQ(decoder.decoded_stage(),
+              draco::StreamingDecoder::STAGE_ATTRIBUTES);
+    ASSERT_TRUE(AreGeometriesEqual(*decoder.point_cloud(), *ref_pc));
+    if (ref_mesh) {
+      ASSERT_TRUE(AreFacesEqual(*decoder.mesh(), *ref_mesh));
+    }
+    ASSERT_FALSE(decoder.FinishInput().ok());
+  }
+};
+
+TEST_F(StreamingDecodeTest, TestEdgebreakerMesh) {
+  draco::EncoderBuffer buffer;
+  EncodeGeometry("test_nm.obj", false, draco::MESH_EDGEBREAKER_ENCODING,
+                 &buffer);
+  TestStreamingDecoding(buffer, 16);
+  TestStreamingDecoding(buffer, 1000);
+}
+
+TEST_F(StreamingDecodeTest, TestSequentialMesh) {
+  draco::EncoderBuffer buffer;
+  EncodeGeometry("cube_att.obj", false, draco::MESH_SEQUENTIAL_ENCODING,
+                 &buffer);
+  TestStreamingDecoding(buffer, 1);
+}
+
+TEST_F(StreamingDecodeTest, TestPointCloud) {
+  draco::EncoderBuffer buffer;
+  EncodeGeometry("point_cloud_test_pos_norm.ply", true,
+                 draco::POINT_CLOUD_KD_TREE_ENCODING, &buffer);
+  TestStreamingDecoding(buffer, 64);
+}
+
+TEST_F(StreamingDecodeTest, TestConnectivityBeforeAttributes) {
+  // Faces should be available before all attribute data is received.
+  draco::EncoderBuffer buffer;
+  EncodeGeometry("test_nm.obj", false, draco::MESH_EDGEBREAKER_ENCODING,
+                 &buffer);
+  draco::StreamingDecoder decoder;
+  ASSERT_TRUE(decoder.AddInput(buffer.data(), buffer.size() - 1).ok());
+  ASSERT_EQ(decoder.decoded_stage(),
+            draco::StreamingDecoder::STAGE_CONNECTIVITY);
+  ASSERT_NE(decoder.mesh(), nullptr);
+  ASSERT_GT(decoder.mesh()->num_faces(), 0);
+  ASSERT_EQ(decoder.mesh()->num_attributes(), 0);
+
+  // The input is incomplete.
+  ASSERT_FALSE(decoder.FinishInput().ok());
+}
+
+TEST_F(StreamingDecodeTest, TestInvalidInput) {
+  draco::StreamingDecoder decoder;
+  const std::string data = "NOT_A_DRACO_FILE";
+  ASSERT_FALSE(decoder.AddInput(data.data(), data.size()).ok());
+}
+
+}  // namespace
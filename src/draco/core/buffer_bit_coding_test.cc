@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include <cstring>
+
 #include "draco/core/decoder_buffer.h"
 #include "draco/core/encoder_buffer.h"
 
@@ -113,4 +115,91 @@ TEST_F(BufferBitCodingTest, TestMultipleBits) {
   }
 }
 
+TEST_F(BufferBitCodingTest, TestMixedBitLengths) {
+  // Encodes values of all bit lengths at arbitrary bit offsets and checks that
+  // they can be decoded back, including across the decoder's cache refills.
+  constexpr int buffer_size = 1024;
+  char buffer[buffer_size];
+  BitEncoder encoder(buffer);
+  uint32_t values[33 * 4];
+  int num_values = 0;
+  for (int i = 0; i < 4; ++i) {
+    for (int nbits = 0; nbits <= 32; ++nbits) {
+      const uint32_t value = nbits == 0
+                                 ? 0
+                                 : (0x9e3779b9u * (num_values + 1)) >>
+                                       (32 - nbits);
+      encoder.PutBits(value, nbits);
+      values[num_values++] = value;
+    }
+  }
+  const uint64_t bits_encoded = encoder.Bits();
+  const int bytes_encoded = static_cast<int>((bits_encoded + 7) / 8);
+
+  BitDecoder decoder;
+  decoder.reset(static_cast<const void *>(buffer), bytes_encoded);
+  num_values = 0;
+  for (int i = 0; i < 4; ++i) {
+    for (int nbits = 0; nbits <= 32; ++nbits) {
+      uint32_t x = 0;
+      ASSERT_TRUE(decoder.GetBits(nbits, &x));
+      ASSERT_EQ(values[num_values++], x);
+    }
+  }
+  ASSERT_EQ(bits_encoded, decoder.BitsDecoded());
+}
+
+TEST_F(BufferBitCodingTest, TestDecodingPastEnd) {
+  // Bits past the end of the buffer are decoded as zeros and they are not
+  // counted as decoded.
+  const uint8_t data[] = {0xff, 0xff, 0xff};
+
+  BitDecoder decoder;
+  decoder.reset(static_cast<const void *>(data), sizeof(data));
+
+  uint32_t x = 0;
+  ASSERT_TRUE(decoder.GetBits(20, &x));
+  ASSERT_EQ(0xfffffu, x);
+  ASSERT_TRUE(decoder.GetBits(8, &x));
+  ASSERT_EQ(0xfu, x);
+  ASSERT_EQ(24u, decoder.BitsDecoded());
+  ASSERT_TRUE(decoder.GetBits(32, &x));
+  ASSERT_EQ(0u, x);
+  ASSERT_EQ(24u, decoder.BitsDecoded());
+}
+
+TEST_F(BufferBitCodingTest, TestEncoderBufferArena) {
+  // Encodes the same data into a regular buffer and into buffers backed by
+  // arenas of various sizes. The arena is used only when the data fits.
+  const auto encode_data = [](EncoderBuffer *buffer) {
+    for (uint32_t i = 0; i < 16; ++i) {
+      buffer->Encode(i);
+    }
+    buffer->StartBitEncoding(101, true);
+    for (uint32_t i = 0; i < 10; ++i) {
+      buffer->EncodeLeastSignificantBits32(i + 1, i);
+    }
+    buffer->EndBitEncoding();
+    buffer->Encode(static_cast<uint8_t>(0xab));
+  };
+  EncoderBuffer ref_buffer;
+  encode_data(&ref_buffer);
+
+  for (const size_t arena_size : {0, 10, 70, 100, 1000}) {
+    std::vector<char> arena(arena_size + 1, 0x55);
+    EncoderBuffer buffer;
+    buffer.SetArena(arena.data(), arena_size);
+    encode_data(&buffer);
+    ASSERT_EQ(buffer.size(), ref_buffer.size());
+    ASSERT_EQ(std::memcmp(buffer.data(), ref_buffer.data(), buffer.size()), 0);
+    const bool fits = ref_buffer.size() <= arena_size;
+    ASSERT_EQ(buffer.uses_arena(), fits);
+    if (fits) {
+      ASSERT_EQ(buffer.data(), arena.data());
+    }
+    // The byte after the arena must not be touched.
+    ASSERT_EQ(arena[arena_size], 0x55);
+  }
+}
+
 }  // namespace draco
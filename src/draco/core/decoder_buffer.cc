@@ -63,7 +63,12 @@ void DecoderBuffer::EndBitDecoding() {
 }
 
 DecoderBuffer::BitDecoder::BitDecoder()
-    : bit_buffer_(nullptr), bit_buffer_end_(nullptr), bit_offset_(0) {}
+    : bit_buffer_(nullptr),
+      bit_buffer_end_(nullptr),
+      next_byte_(nullptr),
+      cache_(0),
+      cache_bits_(0),
+      bit_offset_(0) {}
 
 DecoderBuffer::BitDecoder::~BitDecoder() {}
 
@@ -116,7 +116,10 @@ class DecoderBuffer {
   uint16_t bitstream_version() const { return bitstream_version_; }
 
  private:
-  // Internal helper class to decode bits from a bit buffer.
+  // Internal helper class to decode bits from a bit buffer. Bits are read
+  // through a 64-bit cache that is refilled from the underlying buffer up to
+  // eight bytes at a time, so the bounds check is performed once per refill
+  // instead of once per decoded bit.
   class BitDecoder {
    public:
     BitDecoder();
@@ -127,6 +130,9 @@ class DecoderBuffer {
       bit_offset_ = 0;
       bit_buffer_ = static_cast<const uint8_t *>(b);
       bit_buffer_end_ = bit_buffer_ + s;
+      next_byte_ = bit_buffer_;
+      cache_ = 0;
+      cache_bits_ = 0;
     }
 
     // Returns number of bits decoded so far.
@@ -142,55 +148,74 @@ class DecoderBuffer {
     inline uint32_t EnsureBits(int k) {
       DRACO_DCHECK_LE(k, 24);
       DRACO_DCHECK_LE(static_cast<uint64_t>(k), AvailBits());
-
-      uint32_t buf = 0;
-      for (int i = 0; i < k; ++i) {
-        buf |= PeekBit(i) << i;
-      }
-      return buf;  // Okay to return extra bits
+      if (k > cache_bits_)
+        Refill();
+      const int num_bits = k < cache_bits_ ? k : cache_bits_;
+      return static_cast<uint32_t>(cache_ & LowBitsMask(num_bits));
     }
 
-    inline void ConsumeBits(int k) { bit_offset_ += k; }
+    inline void ConsumeBits(int k) {
+      if (k > cache_bits_)
+        Refill();
+      Skip(k < cache_bits_ ? k : cache_bits_);
+    }
 
     // Returns |nbits| bits in |x|.
     inline bool GetBits(int32_t nbits, uint32_t *x) {
       DRACO_DCHECK_GE(nbits, 0);
       DRACO_DCHECK_LE(nbits, 32);
-      uint32_t value = 0;
-      for (int32_t bit = 0; bit < nbits; ++bit)
-        value |= GetBit() << bit;
-      *x = value;
+      if (nbits > cache_bits_)
+        Refill();
+      // TODO(fgalligan): Add support for error reporting on range check.
+      // Bits past the end of the buffer are decoded as zeros.
+      const int num_bits = nbits < cache_bits_ ? nbits : cache_bits_;
+      *x = static_cast<uint32_t>(cache_ & LowBitsMask(num_bits));
+      Skip(num_bits);
       return true;
     }
 
    private:
-    // TODO(fgalligan): Add support for error reporting on range check.
-    // Returns one bit from the bit buffer.
-    inline int GetBit() {
-      const size_t off = bit_offset_;
-      const size_t byte_offset = off >> 3;
-      const int bit_shift = static_cast<int>(off & 0x7);
-      if (bit_buffer_ + byte_offset < bit_buffer_end_) {
-        const int bit = (bit_buffer_[byte_offset] >> bit_shift) & 1;
-        bit_offset_ = off + 1;
-        return bit;
-      }
-      return 0;
+    static inline uint64_t LowBitsMask(int nbits) {
+      return (static_cast<uint64_t>(1) << nbits) - 1;
     }
 
-    inline int PeekBit(int offset) {
-      const size_t off = bit_offset_ + offset;
-      const size_t byte_offset = off >> 3;
-      const int bit_shift = static_cast<int>(off & 0x7);
-      if (bit_buffer_ + byte_offset < bit_buffer_end_) {
-        const int bit = (bit_buffer_[byte_offset] >> bit_shift) & 1;
-        return bit;
+    // Removes |nbits| already cached bits from the cache.
+    inline void Skip(int nbits) {
+      cache_ >>= nbits;
+      cache_bits_ -= nbits;
+      bit_offset_ += nbits;
+    }
+
+    // Loads as many whole bytes into the bit cache as will fit. Can be called
+    // only when there are at most 56 bits in the cache.
+    inline void Refill() {
+      if (bit_buffer_end_ - next_byte_ >= 8) {
+        // Fast path: a single unaligned 64-bit load. Any bits of the loaded
+        // word that do not fit into the cache are loaded again by the next
+        // refill, so they can be safely kept above |cache_bits_|.
+        uint64_t word;
+        memcpy(&word, next_byte_, sizeof(word));
+        cache_ |= word << cache_bits_;
+        const int num_bytes = (63 - cache_bits_) >> 3;
+        next_byte_ += num_bytes;
+        cache_bits_ += num_bytes << 3;
+        return;
+      }
+      // Slow path near the end of the buffer.
+      while (cache_bits_ <= 56 && next_byte_ < bit_buffer_end_) {
+        cache_ |= static_cast<uint64_t>(*next_byte_++) << cache_bits_;
+        cache_bits_ += 8;
       }
-      return 0;
     }
 
     const uint8_t *bit_buffer_;
     const uint8_t *bit_buffer_end_;
+    // Position of the first byte that has not been loaded to the cache yet.
+    const uint8_t *next_byte_;
+    // Cached bits that follow |bit_offset_|, least significant bit first.
+    uint64_t cache_;
+    // Number of valid bits in |cache_|.
+    int cache_bits_;
     size_t bit_offset_;
   };
   friend class BufferBitCodingTest;
@@ -17,6 +17,8 @@
 #include <fstream>
 
 #include "draco/core/macros.h"
+#include "draco/core/vector_d.h"
+#include "draco/mesh/triangle_soup_mesh_builder.h"
 #include "draco_test_base.h"
 
 namespace draco {
@@ -80,4 +82,35 @@ bool CompareGoldenFile(const std::string &golden_file_name, const void *data,
   return true;
 }
 
+std::unique_ptr<Mesh> CreateQuadGridMesh(
+    int size_x, int size_y, const std::function<bool(int, int)> &use_quad) {
+  int num_quads = 0;
+  for (int y = 0; y < size_y; ++y) {
+    for (int x = 0; x < size_x; ++x) {
+      if (use_quad(x, y))
+        ++num_quads;
+    }
+  }
+  TriangleSoupMeshBuilder mb;
+  mb.Start(2 * num_quads);
+  const int32_t pos_att_id =
+      mb.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+  int face_id = 0;
+  for (int y = 0; y < size_y; ++y) {
+    for (int x = 0; x < size_x; ++x) {
+      if (!use_quad(x, y))
+        continue;
+      Vector3f p00(x, y, 0.f);
+      Vector3f p10(x + 1, y, 0.f);
+      Vector3f p01(x, y + 1, 0.f);
+      Vector3f p11(x + 1, y + 1, 0.f);
+      mb.SetAttributeValuesForFace(pos_att_id, FaceIndex(face_id++),
+                                   p00.data(), p10.data(), p11.data());
+      mb.SetAttributeValuesForFace(pos_att_id, FaceIndex(face_id++),
+                                   p00.data(), p11.data(), p01.data());
+    }
+  }
+  return mb.Finalize();
+}
+
 }  // namespace draco
@@ -15,6 +15,8 @@
 #ifndef DRACO_CORE_DRACO_TEST_UTILS_H_
 #define DRACO_CORE_DRACO_TEST_UTILS_H_
 
+#include <functional>
+
 #include "draco/core/draco_test_base.h"
 #include "draco/io/mesh_io.h"
 #include "draco/io/point_cloud_io.h"
@@ -40,6 +42,12 @@ bool GenerateGoldenFile(const std::string &golden_file_name, const void *data,
 bool CompareGoldenFile(const std::string &golden_file_name, const void *data,
                        int data_size);
 
+// Creates a mesh on a regular grid of |size_x| x |size_y| unit quads, each
+// split into two triangles. Only quads at positions (x, y) for which
+// |use_quad| returns true are added to the mesh.
+std::unique_ptr<Mesh> CreateQuadGridMesh(
+    int size_x, int size_y, const std::function<bool(int, int)> &use_quad);
+
 // Loads a mesh / point cloud specified by a |file_name| that is going to be
 // automatically converted to the correct path available to the testing
 // instance.
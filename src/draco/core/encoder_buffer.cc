@@ -14,6 +14,7 @@
 //
 #include "draco/core/encoder_buffer.h"
 
+#include <algorithm>
 #include <cstring>  // for memcpy
 
 #include "draco/core/varint_encoding.h"
@@ -21,14 +22,71 @@
 namespace draco {
 
 EncoderBuffer::EncoderBuffer()
-    : bit_encoder_reserved_bytes_(false), encode_bit_sequence_size_(false) {}
+    : arena_(nullptr),
+      arena_size_(0),
+      arena_data_size_(0),
+      bit_encoder_reserved_bytes_(false),
+      encode_bit_sequence_size_(false) {}
 
 void EncoderBuffer::Clear() {
   buffer_.clear();
+  arena_data_size_ = 0;
   bit_encoder_reserved_bytes_ = 0;
 }
 
-void EncoderBuffer::Resize(int64_t nbytes) { buffer_.resize(nbytes); }
+void EncoderBuffer::Resize(int64_t nbytes) {
+  if (arena_) {
+    if (static_cast<size_t>(nbytes) <= arena_size_) {
+      // New bytes are zero initialized the same as in |buffer_|.
+      if (static_cast<size_t>(nbytes) > arena_data_size_) {
+        memset(arena_ + arena_data_size_, 0, nbytes - arena_data_size_);
+      }
+      arena_data_size_ = nbytes;
+      return;
+    }
+    MoveArenaToBuffer(nbytes);
+  }
+  buffer_.resize(nbytes);
+}
+
+void EncoderBuffer::Reserve(int64_t nbytes) {
+  if (arena_) {
+    if (static_cast<size_t>(nbytes) <= arena_size_)
+      return;
+    MoveArenaToBuffer(nbytes);
+  }
+  buffer_.reserve(nbytes);
+}
+
+size_t EncoderBuffer::capacity() const {
+  return arena_ ? arena_size_ : buffer_.capacity();
+}
+
+void EncoderBuffer::SetArena(char *arena, size_t arena_size) {
+  Clear();
+  arena_ = arena;
+  arena_size_ = arena_size;
+}
+
+void EncoderBuffer::AppendToArena(const void *data, size_t data_size) {
+  if (arena_data_size_ + data_size <= arena_size_) {
+    memcpy(arena_ + arena_data_size_, data, data_size);
+    arena_data_size_ += data_size;
+    return;
+  }
+  // Leave room for the data that is going to be encoded after this call.
+  MoveArenaToBuffer(2 * (arena_data_size_ + data_size));
+  const char *const src_data = static_cast<const char *>(data);
+  buffer_.insert(buffer_.end(), src_data, src_data + data_size);
+}
+
+void EncoderBuffer::MoveArenaToBuffer(size_t min_capacity) {
+  buffer_.reserve(std::max(min_capacity, arena_data_size_));
+  buffer_.assign(arena_, arena_ + arena_data_size_);
+  arena_ = nullptr;
+  arena_size_ = 0;
+  arena_data_size_ = 0;
+}
 
 bool EncoderBuffer::StartBitEncoding(int64_t required_bits, bool encode_size) {
   if (bit_encoder_active())
@@ -38,16 +96,16 @@ bool EncoderBuffer::StartBitEncoding(int64_t required_bits, bool encode_size) {
   encode_bit_sequence_size_ = encode_size;
   const int64_t required_bytes = (required_bits + 7) / 8;
   bit_encoder_reserved_bytes_ = required_bytes;
-  uint64_t buffer_start_size = buffer_.size();
+  uint64_t buffer_start_size = size();
   if (encode_size) {
     // Reserve memory for storing the encoded bit sequence size. It will be
     // filled once the bit encoding ends.
     buffer_start_size += sizeof(uint64_t);
   }
   // Resize buffer to fit the maximum size of encoded bit data.
-  buffer_.resize(buffer_start_size + required_bytes);
+  Resize(buffer_start_size + required_bytes);
   // Get the buffer data pointer for the bit encoder.
-  const char *const data = buffer_.data() + buffer_start_size;
+  const char *const data = this->data() + buffer_start_size;
   bit_encoder_ =
       std::unique_ptr<BitEncoder>(new BitEncoder(const_cast<char *>(data)));
   return true;
@@ -83,7 +141,7 @@ void EncoderBuffer::EndBitEncoding() {
     bit_encoder_reserved_bytes_ += sizeof(uint64_t) - size_len;
   }
   // Resize the underlying buffer to match the number of encoded bits.
-  buffer_.resize(buffer_.size() - bit_encoder_reserved_bytes_ + encoded_bytes);
+  Resize(size() - bit_encoder_reserved_bytes_ + encoded_bytes);
   bit_encoder_reserved_bytes_ = 0;
 }
 
@@ -26,12 +26,33 @@ namespace draco {
 // Class representing a buffer that can be used for either for byte-aligned
 // encoding of arbitrary data structures or for encoding of variable-length
 // bit data.
+//
+// By default, the encoded data is stored in an internally allocated vector.
+// Alternatively, the buffer can write into a caller-provided memory arena
+// (see SetArena()). When the encoded data outgrows the arena, the content is
+// moved to the internal vector and the encoding continues there.
 class EncoderBuffer {
  public:
   EncoderBuffer();
   void Clear();
   void Resize(int64_t nbytes);
 
+  // Pre-allocates storage for at least |nbytes| of encoded data. This can be
+  // used together with an estimate of the encoded size (see
+  // ExpertEncoder::EstimateEncodedSize()) to avoid repeated reallocations.
+  void Reserve(int64_t nbytes);
+  size_t capacity() const;
+
+  // Makes the buffer write the encoded data into |arena| that can hold up to
+  // |arena_size| bytes. The arena must outlive the buffer (or the next call of
+  // SetArena()). Any data that is already stored in the buffer is discarded.
+  // The arena is used until the encoded data outgrows it. After that, the
+  // data is moved to an internally allocated storage and uses_arena() returns
+  // false.
+  void SetArena(char *arena, size_t arena_size);
+  // Returns true when the encoded data is stored in the caller-provided arena.
+  bool uses_arena() const { return arena_ != nullptr; }
+
   // Start encoding a bit sequence. A maximum size of the sequence needs to
   // be known upfront.
   // If encode_size is true, the size of encoded bit sequence is stored before
@@ -57,23 +78,25 @@ class EncoderBuffer {
   // Returns false when the value couldn't be encoded.
   template <typename T>
   bool Encode(const T &data) {
-    if (bit_encoder_active())
-      return false;
-    const uint8_t *src_data = reinterpret_cast<const uint8_t *>(&data);
-    buffer_.insert(buffer_.end(), src_data, src_data + sizeof(T));
-    return true;
+    return Encode(&data, sizeof(T));
   }
   bool Encode(const void *data, size_t data_size) {
     if (bit_encoder_active())
       return false;
+    if (arena_) {
+      AppendToArena(data, data_size);
+      return true;
+    }
     const uint8_t *src_data = reinterpret_cast<const uint8_t *>(data);
     buffer_.insert(buffer_.end(), src_data, src_data + data_size);
     return true;
   }
 
   bool bit_encoder_active() const { return bit_encoder_reserved_bytes_ > 0; }
-  const char *data() const { return buffer_.data(); }
-  size_t size() const { return buffer_.size(); }
+  const char *data() const { return arena_ ? arena_ : buffer_.data(); }
+  size_t size() const { return arena_ ? arena_data_size_ : buffer_.size(); }
+  // Returns the internal storage of the encoded data. Must not be used when
+  // the buffer writes into an arena.
   std::vector<char> *buffer() { return &buffer_; }
 
  private:
@@ -83,12 +106,27 @@ class EncoderBuffer {
     // |data| is the buffer to write the bits into.
     explicit BitEncoder(char *data) : bit_buffer_(data), bit_offset_(0) {}
 
-    // Write |nbits| of |data| into the bit buffer.
+    // Write |nbits| of |data| into the bit buffer. The bits are written up to
+    // a whole byte at a time.
     void PutBits(uint32_t data, int32_t nbits) {
       DRACO_DCHECK_GE(nbits, 0);
       DRACO_DCHECK_LE(nbits, 32);
-      for (int32_t bit = 0; bit < nbits; ++bit)
-        PutBit((data >> bit) & 1);
+      uint32_t bits = data;
+      size_t off = bit_offset_;
+      while (nbits > 0) {
+        const size_t byte_offset = off >> 3;
+        const int bit_shift = static_cast<int>(off & 0x7);
+        const int num_bits = nbits < 8 - bit_shift ? nbits : 8 - bit_shift;
+        const uint8_t mask =
+            static_cast<uint8_t>(((1u << num_bits) - 1) << bit_shift);
+        const uint8_t byte = static_cast<uint8_t>(bit_buffer_[byte_offset]);
+        bit_buffer_[byte_offset] =
+            static_cast<char>((byte & ~mask) | ((bits << bit_shift) & mask));
+        bits >>= num_bits;
+        off += num_bits;
+        nbits -= num_bits;
+      }
+      bit_offset_ = off;
     }
 
     // Return number of bits encoded so far.
@@ -105,28 +143,26 @@ class EncoderBuffer {
     }
 
    private:
-    void PutBit(uint8_t value) {
-      const int byte_size = 8;
-      const uint64_t off = static_cast<uint64_t>(bit_offset_);
-      const uint64_t byte_offset = off / byte_size;
-      const int bit_shift = off % byte_size;
-
-      // TODO(fgalligan): Check performance if we add a branch and only do one
-      // memory write if bit_shift is 7. Also try using a temporary variable to
-      // hold the bits before writing to the buffer.
-
-      bit_buffer_[byte_offset] &= ~(1 << bit_shift);
-      bit_buffer_[byte_offset] |= value << bit_shift;
-      bit_offset_++;
-    }
-
     char *bit_buffer_;
     size_t bit_offset_;
   };
+  // Appends |data_size| bytes of |data| to the arena, moving the content of
+  // the buffer to |buffer_| when the data does not fit into the arena.
+  void AppendToArena(const void *data, size_t data_size);
+  // Moves the content of the arena to |buffer_| and stops using the arena.
+  void MoveArenaToBuffer(size_t min_capacity);
+
   friend class BufferBitCodingTest;
-  // All data is stored in this vector.
+  // All data is stored in this vector unless an arena is used.
   std::vector<char> buffer_;
 
+  // Caller-provided storage of the encoded data or nullptr when |buffer_| is
+  // used.
+  char *arena_;
+  size_t arena_size_;
+  // Number of bytes of the encoded data stored in the |arena_|.
+  size_t arena_data_size_;
+
   // Bit encoder is used when encoding variable-length bit data.
   // TODO(ostava): Currently encoder needs to be recreated each time
   // StartBitEncoding method is called. This is not necessary if BitEncoder
@@ -0,0 +1,64 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_THREAD_POOL_H_
+#define DRACO_CORE_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace draco {
+
+// Simple pool of worker threads that execute scheduled tasks in the order in
+// which they were scheduled. Tasks may block on the completion of tasks that
+// were scheduled before them, but never on tasks scheduled after them.
+// A pool created with zero threads executes all tasks directly in the thread
+// that schedules them.
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+
+  // Waits for all scheduled tasks to finish before destroying the workers.
+  ~ThreadPool();
+
+  // Schedules |task| for execution on one of the worker threads.
+  void Schedule(std::function<void()> task);
+
+  // Blocks until all scheduled tasks are finished.
+  void Wait();
+
+  int num_threads() const { return static_cast<int>(workers_.size()); }
+
+ private:
+  void RunWorker();
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  // Signaled when a new task is scheduled or when the pool is destroyed.
+  std::condition_variable task_available_;
+  // Signaled when all scheduled tasks are finished.
+  std::condition_variable tasks_done_;
+  // Number of tasks that were scheduled but are not finished yet.
+  int num_pending_tasks_;
+  bool stopping_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_THREAD_POOL_H_
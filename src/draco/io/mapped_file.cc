@@ -0,0 +1,76 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/mapped_file.h"
+
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace draco {
+
+MappedFile::MappedFile() : data_(nullptr), size_(0), mapped_data_(nullptr) {}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (mapped_data_)
+    munmap(mapped_data_, size_);
+#endif
+}
+
+StatusOr<std::unique_ptr<MappedFile>> MappedFile::Open(
+    const std::string &file_name) {
+  std::unique_ptr<MappedFile> file(new MappedFile());
+#ifndef _WIN32
+  const int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0)
+    return Status(Status::IO_ERROR, "Failed to open file.");
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) &&
+      file_stat.st_size > 0) {
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    void *const mapped_data =
+        mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped_data != MAP_FAILED) {
+      // The input files are typically parsed from the start to the end.
+      madvise(mapped_data, size, MADV_SEQUENTIAL);
+      file->mapped_data_ = mapped_data;
+      file->data_ = static_cast<const char *>(mapped_data);
+      file->size_ = size;
+    }
+  }
+  close(fd);
+  if (file->is_mapped())
+    return std::move(file);
+#endif
+  // Fall back to reading the whole file into memory.
+  std::ifstream is(file_name, std::ios::binary);
+  if (!is)
+    return Status(Status::IO_ERROR, "Failed to open file.");
+  file->file_data_.assign(std::istreambuf_iterator<char>(is),
+                          std::istreambuf_iterator<char>());
+  if (!file->file_data_.empty()) {
+    file->data_ = file->file_data_.data();
+    file->size_ = file->file_data_.size();
+  }
+  return std::move(file);
+}
+
+}  // namespace draco
@@ -0,0 +1,66 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_IO_MAPPED_FILE_H_
+#define DRACO_IO_MAPPED_FILE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "draco/core/status_or.h"
+
+namespace draco {
+
+// Read-only view of the whole content of a file. On POSIX systems the file is
+// memory mapped so that no copy of the data is made and the pages are loaded
+// on demand by the kernel (the mapping is marked for sequential access). On
+// other systems, or when the file cannot be mapped, the content of the file is
+// read into memory instead.
+//
+// The data can be passed directly to DecoderBuffer::Init(), which does not
+// copy the data. The MappedFile must outlive the DecoderBuffer.
+class MappedFile {
+ public:
+  // Opens the file |file_name| for reading. Returns an error when the file
+  // cannot be opened.
+  static StatusOr<std::unique_ptr<MappedFile>> Open(
+      const std::string &file_name);
+
+  ~MappedFile();
+
+  // Returns the content of the file. The returned pointer is nullptr for empty
+  // files.
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // Returns true when the file data is memory mapped.
+  bool is_mapped() const { return mapped_data_ != nullptr; }
+
+ private:
+  MappedFile();
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *data_;
+  size_t size_;
+  // Start of the mapped memory or nullptr when the file is not mapped.
+  void *mapped_data_;
+  // Content of the file when it is not mapped.
+  std::vector<char> file_data_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_IO_MAPPED_FILE_H_
@@ -0,0 +1,49 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/mapped_file.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace {
+
+TEST(MappedFileTest, TestFileContent) {
+  for (const std::string file_name : {"test_nm.obj", "pc_color.drc"}) {
+    const std::string path = draco::GetTestFileFullPath(file_name);
+    std::ifstream is(path, std::ios::binary);
+    ASSERT_TRUE(is);
+    const std::vector<char> data((std::istreambuf_iterator<char>(is)),
+                                 std::istreambuf_iterator<char>());
+    ASSERT_FALSE(data.empty());
+
+    auto file_or = draco::MappedFile::Open(path);
+    ASSERT_TRUE(file_or.ok());
+    const std::unique_ptr<draco::MappedFile> file = std::move(file_or).value();
+    ASSERT_EQ(file->size(), data.size());
+    ASSERT_EQ(std::memcmp(file->data(), data.data(), data.size()), 0);
+  }
+}
+
+TEST(MappedFileTest, TestMissingFile) {
+  ASSERT_FALSE(
+      draco::MappedFile::Open(draco::GetTestFileFullPath("missing_file.drc"))
+          .ok());
+}
+
+}  // namespace
@@ -14,9 +14,8 @@
 //
 #include "draco/io/mesh_io.h"
 
-#include <fstream>
-
 #include "draco/io/file_utils.h"
+#include "draco/io/mapped_file.h"
 #include "draco/io/obj_decoder.h"
 #include "draco/io/ply_decoder.h"
 
@@ -36,11 +35,11 @@ StatusOr<std::unique_ptr<Mesh>> ReadMeshFromFile(const std::string &file_name,
 
 StatusOr<std::unique_ptr<Mesh>> ReadMeshFromFile(const std::string &file_name,
                                                  const Options &options) {
-  std::unique_ptr<Mesh> mesh(new Mesh());
   // Analyze file extension.
   const std::string extension = LowercaseFileExtension(file_name);
   if (extension == "obj") {
     // Wavefront OBJ file format.
+    std::unique_ptr<Mesh> mesh(new Mesh());
     ObjDecoder obj_decoder;
     obj_decoder.set_use_metadata(options.GetBool("use_metadata", false));
     const Status obj_status = obj_decoder.DecodeFromFile(file_name, mesh.get());
@@ -50,6 +49,7 @@ StatusOr<std::unique_ptr<Mesh>> ReadMeshFromFile(const std::string &file_name,
   }
   if (extension == "ply") {
     // Wavefront PLY file format.
+    std::unique_ptr<Mesh> mesh(new Mesh());
     PlyDecoder ply_decoder;
     DRACO_RETURN_IF_ERROR(ply_decoder.DecodeFromFile(file_name, mesh.get()));
     return std::move(mesh);
@@ -57,13 +57,14 @@ StatusOr<std::unique_ptr<Mesh>> ReadMeshFromFile(const std::string &file_name,
 
   // Otherwise not an obj file. Assume the file was encoded with one of the
   // draco encoding methods.
-  std::ifstream is(file_name.c_str(), std::ios::binary);
-  if (!is)
+  auto file_or = MappedFile::Open(file_name);
+  if (!file_or.ok())
     return Status(Status::DRACO_ERROR, "Invalid input stream.");
-  if (!ReadMeshFromStream(&mesh, is).good())
-    return Status(Status::DRACO_ERROR,
-                  "Unknown error.");  // Error reading the stream.
-  return std::move(mesh);
+  const std::unique_ptr<MappedFile> file = std::move(file_or).value();
+  DecoderBuffer buffer;
+  buffer.Init(file->data(), file->size());
+  Decoder decoder;
+  return decoder.DecodeMeshFromBuffer(&buffer);
 }
 
 }  // namespace draco
@@ -16,9 +16,9 @@
 
 #include <cctype>
 #include <cmath>
-#include <fstream>
 
 #include "draco/io/file_utils.h"
+#include "draco/io/mapped_file.h"
 #include "draco/io/parser_utils.h"
 #include "draco/metadata/geometry_metadata.h"
 
@@ -51,19 +51,13 @@ Status ObjDecoder::DecodeFromFile(const std::string &file_name,
 
 Status ObjDecoder::DecodeFromFile(const std::string &file_name,
                                   PointCloud *out_point_cloud) {
-  std::ifstream file(file_name, std::ios::binary);
-  if (!file)
+  auto file_or = MappedFile::Open(file_name);
+  if (!file_or.ok())
     return Status(Status::IO_ERROR);
-  // Read the whole file into a buffer.
-  auto pos0 = file.tellg();
-  file.seekg(0, std::ios::end);
-  auto file_size = file.tellg() - pos0;
-  if (file_size == 0)
+  const std::unique_ptr<MappedFile> file = std::move(file_or).value();
+  if (file->size() == 0)
     return Status(Status::IO_ERROR);
-  file.seekg(0, std::ios::beg);
-  std::vector<char> data(file_size);
-  file.read(&data[0], file_size);
-  buffer_.Init(&data[0], file_size);
+  buffer_.Init(file->data(), file->size());
 
   out_point_cloud_ = out_point_cloud;
   input_file_name_ = file_name;
@@ -634,22 +628,17 @@ void ObjDecoder::MapPointToVertexIndices(
 bool ObjDecoder::ParseMaterialFile(const std::string &file_name,
                                    Status *status) {
   const std::string full_path = GetFullPath(file_name, input_file_name_);
-  std::ifstream file(full_path, std::ios::binary);
-  if (!file)
+  auto file_or = MappedFile::Open(full_path);
+  if (!file_or.ok())
     return false;
-  // Read the whole file into a buffer.
-  file.seekg(0, std::ios::end);
-  const std::string::size_type file_size = file.tellg();
-  if (file_size == 0)
+  const std::unique_ptr<MappedFile> file = std::move(file_or).value();
+  if (file->size() == 0)
     return false;
-  file.seekg(0, std::ios::beg);
-  std::vector<char> data(file_size);
-  file.read(&data[0], file_size);
 
   // Backup the original decoder buffer.
   DecoderBuffer old_buffer = buffer_;
 
-  buffer_.Init(&data[0], file_size);
+  buffer_.Init(file->data(), file->size());
 
   num_materials_ = 0;
   while (ParseMaterialFileDefinition(status)) {
@@ -14,10 +14,9 @@
 //
 #include "draco/io/ply_decoder.h"
 
-#include <fstream>
-
 #include "draco/core/macros.h"
 #include "draco/core/status.h"
+#include "draco/io/mapped_file.h"
 #include "draco/io/ply_property_reader.h"
 
 namespace draco {
@@ -32,20 +31,14 @@ Status PlyDecoder::DecodeFromFile(const std::string &file_name,
 
 Status PlyDecoder::DecodeFromFile(const std::string &file_name,
                                   PointCloud *out_point_cloud) {
-  std::ifstream file(file_name, std::ios::binary);
-  if (!file)
+  auto file_or = MappedFile::Open(file_name);
+  if (!file_or.ok())
     return Status(Status::IO_ERROR, "Couldn't open file");
-  // Read the whole file into a buffer.
-  auto pos0 = file.tellg();
-  file.seekg(0, std::ios::end);
-  auto file_size = file.tellg() - pos0;
-  if (file_size == 0)
+  const std::unique_ptr<MappedFile> file = std::move(file_or).value();
+  if (file->size() == 0)
     return Status(Status::IO_ERROR, "Zero file size");
-  file.seekg(0, std::ios::beg);
-  std::vector<char> data(file_size);
-  file.read(&data[0], file_size);
 
-  buffer_.Init(&data[0], file_size);
+  buffer_.Init(file->data(), file->size());
   return DecodeFromBuffer(&buffer_, out_point_cloud);
 }
 
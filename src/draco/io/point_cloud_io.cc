@@ -14,8 +14,7 @@
 //
 #include "draco/io/point_cloud_io.h"
 
-#include <fstream>
-
+#include "draco/io/mapped_file.h"
 #include "draco/io/obj_decoder.h"
 #include "draco/io/parser_utils.h"
 #include "draco/io/ply_decoder.h"
@@ -46,13 +45,14 @@ StatusOr<std::unique_ptr<PointCloud>> ReadPointCloudFromFile(
 
   // Otherwise not an obj file. Assume the file was encoded with one of the
   // draco encoding methods.
-  std::ifstream is(file_name.c_str(), std::ios::binary);
-  if (!is)
+  auto file_or = MappedFile::Open(file_name);
+  if (!file_or.ok())
     return Status(Status::DRACO_ERROR, "Invalid input stream.");
-  if (!ReadPointCloudFromStream(&pc, is).good())
-    return Status(Status::DRACO_ERROR,
-                  "Unknown error.");  // Error reading the stream.
-  return std::move(pc);
+  const std::unique_ptr<MappedFile> file = std::move(file_or).value();
+  DecoderBuffer buffer;
+  buffer.Init(file->data(), file->size());
+  Decoder decoder;
+  return decoder.DecodePointCloudFromBuffer(&buffer);
 }
 
 }  // namespace draco
@@ -14,9 +14,12 @@
 //
 #include "draco/mesh/corner_table.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 #include "draco/attributes/geometry_indices.h"
+#include "draco/core/thread_pool.h"
 #include "draco/mesh/corner_table_iterators.h"
 
 namespace draco {
@@ -29,24 +32,41 @@ CornerTable::CornerTable()
 
 std::unique_ptr<CornerTable> CornerTable::Create(
     const IndexTypeVector<FaceIndex, FaceType> &faces) {
+  return Create(faces, 0);
+}
+
+std::unique_ptr<CornerTable> CornerTable::Create(
+    const IndexTypeVector<FaceIndex, FaceType> &faces, int num_threads) {
   std::unique_ptr<CornerTable> ct(new CornerTable());
-  if (!ct->Init(faces))
+  if (!ct->Init(faces, num_threads))
     return nullptr;
   return ct;
 }
 
 bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces) {
+  return Init(faces, 0);
+}
+
+bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces,
+                       int num_threads) {
   valence_cache_.ClearValenceCache();
   valence_cache_.ClearValenceCacheInaccurate();
+  if (faces.size() > static_cast<size_t>(kMaxGeometryIndexCount / 3))
+    return false;
   corner_to_vertex_map_.resize(faces.size() * 3);
-  for (FaceIndex fi(0); fi < static_cast<uint32_t>(faces.size()); ++fi) {
+  for (FaceIndex fi(0); fi < static_cast<GeometryIndexValueType>(faces.size());
+       ++fi) {
     for (int i = 0; i < 3; ++i) {
       corner_to_vertex_map_[FirstCorner(fi) + i] = faces[fi][i];
     }
   }
-  int num_vertices = -1;
-  if (!ComputeOppositeCorners(&num_vertices))
+  GeometryIndexCountType num_vertices = -1;
+  if (num_threads > 0) {
+    if (!ComputeOppositeCornersInParallel(num_threads, &num_vertices))
+      return false;
+  } else if (!ComputeOppositeCorners(&num_vertices)) {
     return false;
+  }
   if (!BreakNonManifoldEdges())
     return false;
   if (!ComputeVertexCorners(num_vertices))
@@ -54,25 +74,35 @@ bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces) {
   return true;
 }
 
-bool CornerTable::Reset(int num_faces) {
+bool CornerTable::Reset(GeometryIndexCountType num_faces) {
+  if (num_faces > kMaxGeometryIndexCount / 3)
+    return false;
   return Reset(num_faces, num_faces * 3);
 }
 
-bool CornerTable::Reset(int num_faces, int num_vertices) {
+bool CornerTable::Reset(GeometryIndexCountType num_faces,
+                        GeometryIndexCountType num_vertices) {
   if (num_faces < 0 || num_vertices < 0)
     return false;
-  if (static_cast<unsigned int>(num_faces) >
-      std::numeric_limits<CornerIndex::ValueType>::max() / 3)
+  // The number of corners must fit into the count type.
+  if (num_faces > kMaxGeometryIndexCount / 3)
     return false;
   corner_to_vertex_map_.assign(num_faces * 3, kInvalidVertexIndex);
   opposite_corners_.assign(num_faces * 3, kInvalidCornerIndex);
+  // Existing vertices are removed but the allocated memory is kept so the
+  // corner table can be reused without reallocations.
+  vertex_corners_.clear();
   vertex_corners_.reserve(num_vertices);
+  non_manifold_vertex_parents_.clear();
+  num_original_vertices_ = 0;
+  num_degenerated_faces_ = 0;
+  num_isolated_vertices_ = 0;
   valence_cache_.ClearValenceCache();
   valence_cache_.ClearValenceCacheInaccurate();
   return true;
 }
 
-bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
+bool CornerTable::ComputeOppositeCorners(GeometryIndexCountType *num_vertices) {
   DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
   if (num_vertices == nullptr)
     return false;
@@ -92,7 +122,7 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
   num_corners_on_vertices.reserve(num_corners());
   for (CornerIndex c(0); c < num_corners(); ++c) {
     const VertexIndex v1 = Vertex(c);
-    if (v1.value() >= static_cast<int>(num_corners_on_vertices.size()))
+    if (v1.value() >= num_corners_on_vertices.size())
       num_corners_on_vertices.resize(v1.value() + 1, 0);
     // For each corner there is always exactly one outgoing half-edge attached
     // to its vertex.
@@ -117,8 +147,9 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
   // entry of a given vertex is going to be stored). This way each vertex is
   // guaranteed to have a non-overlapping storage with respect to the other
   // vertices.
-  std::vector<int> vertex_offset(num_corners_on_vertices.size());
-  int offset = 0;
+  std::vector<GeometryIndexCountType> vertex_offset(
+      num_corners_on_vertices.size());
+  GeometryIndexCountType offset = 0;
   for (size_t i = 0; i < num_corners_on_vertices.size(); ++i) {
     vertex_offset[i] = offset;
     offset += num_corners_on_vertices[i];
@@ -192,7 +223,215 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices) {
       opposite_corners_[opposite_c] = c;
     }
   }
-  *num_vertices = static_cast<int>(num_corners_on_vertices.size());
+  *num_vertices =
+      static_cast<GeometryIndexCountType>(num_corners_on_vertices.size());
+  return true;
+}
+
+bool CornerTable::ComputeOppositeCornersInParallel(
+    int num_threads, GeometryIndexCountType *num_vertices) {
+  DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
+  if (num_vertices == nullptr || num_threads <= 0)
+    return false;
+  opposite_corners_.resize(num_corners(), kInvalidCornerIndex);
+
+  // The serial implementation matches each new half-edge with the first
+  // unmatched sibling half-edge on the same pair of vertices. Half-edges on
+  // different vertex pairs never interact, so we can group all half-edges by
+  // the (unordered) pair of their vertices and process each group on its own.
+  // As long as the half-edges within a group are processed in the order of
+  // their corners, the result is identical to the serial implementation.
+  //
+  // The groups are built in parallel using a radix partition of the
+  // half-edges into buckets of vertex ranges followed by a sort within each
+  // bucket. Each task processes a contiguous range of faces and the partial
+  // results are merged in the order of the ranges, so the result doesn't
+  // depend on the scheduling of the tasks.
+  ThreadPool pool(num_threads);
+  const int num_tasks = num_threads;
+  const GeometryIndexCountType num_table_faces = num_faces();
+  const GeometryIndexCountType faces_per_task =
+      (num_table_faces + num_tasks - 1) / num_tasks;
+  const auto first_task_face = [&](int task) {
+    return FaceIndex(static_cast<GeometryIndexValueType>(
+        std::min(num_table_faces, task * faces_per_task)));
+  };
+
+  // First compute the number of vertices and find all degenerated faces.
+  std::vector<uint64_t> task_num_vertices(num_tasks, 0);
+  std::vector<GeometryIndexCountType> task_num_degenerated_faces(num_tasks, 0);
+  for (int t = 0; t < num_tasks; ++t) {
+    pool.Schedule([&, t] {
+      uint64_t num_task_vertices = 0;
+      for (FaceIndex f = first_task_face(t); f < first_task_face(t + 1); ++f) {
+        for (int i = 0; i < 3; ++i) {
+          const uint64_t v = Vertex(FirstCorner(f) + i).value();
+          num_task_vertices = std::max(num_task_vertices, v + 1);
+        }
+        if (IsDegenerated(f))
+          ++task_num_degenerated_faces[t];
+      }
+      task_num_vertices[t] = num_task_vertices;
+    });
+  }
+  pool.Wait();
+  uint64_t num_table_vertices = 0;
+  for (int t = 0; t < num_tasks; ++t) {
+    num_table_vertices = std::max(num_table_vertices, task_num_vertices[t]);
+    num_degenerated_faces_ += task_num_degenerated_faces[t];
+  }
+  *num_vertices = static_cast<GeometryIndexCountType>(num_table_vertices);
+  if (num_table_vertices == 0)
+    return true;
+
+  // Each half-edge is identified by its opposite corner. Half-edges are
+  // partitioned into buckets by their lower vertex. Each bucket covers a range
+  // of 2^|bucket_shift| vertices, selected so that there are several buckets
+  // per task.
+  const auto lower_vertex = [&](CornerIndex c) {
+    return std::min(Vertex(Next(c)), Vertex(Previous(c)));
+  };
+  const auto higher_vertex = [&](CornerIndex c) {
+    return std::max(Vertex(Next(c)), Vertex(Previous(c)));
+  };
+  int bucket_shift = 0;
+  while (((num_table_vertices - 1) >> bucket_shift) + 1 >
+         static_cast<uint64_t>(8 * num_tasks)) {
+    ++bucket_shift;
+  }
+  const uint64_t num_buckets = ((num_table_vertices - 1) >> bucket_shift) + 1;
+
+  // Count the half-edges of each task in each bucket.
+  std::vector<GeometryIndexCountType> bucket_offsets(num_tasks * num_buckets,
+                                                     0);
+  for (int t = 0; t < num_tasks; ++t) {
+    pool.Schedule([&, t] {
+      GeometryIndexCountType *const task_counts =
+          &bucket_offsets[t * num_buckets];
+      for (FaceIndex f = first_task_face(t); f < first_task_face(t + 1); ++f) {
+        if (IsDegenerated(f))
+          continue;
+        for (int i = 0; i < 3; ++i) {
+          ++task_counts[lower_vertex(FirstCorner(f) + i).value() >>
+                        bucket_shift];
+        }
+      }
+    });
+  }
+  pool.Wait();
+
+  // Convert the counts into offsets where each task stores its half-edges.
+  // Buckets are stored one after another and within each bucket, the
+  // half-edges of the tasks are stored in the order of the tasks. Therefore
+  // the half-edges of each bucket are sorted by their corners.
+  std::vector<GeometryIndexCountType> bucket_starts(num_buckets + 1, 0);
+  GeometryIndexCountType offset = 0;
+  for (uint64_t b = 0; b < num_buckets; ++b) {
+    bucket_starts[b] = offset;
+    for (int t = 0; t < num_tasks; ++t) {
+      const GeometryIndexCountType count = bucket_offsets[t * num_buckets + b];
+      bucket_offsets[t * num_buckets + b] = offset;
+      offset += count;
+    }
+  }
+  bucket_starts[num_buckets] = offset;
+
+  std::vector<CornerIndex> half_edges(offset);
+  for (int t = 0; t < num_tasks; ++t) {
+    pool.Schedule([&, t] {
+      GeometryIndexCountType *const task_offsets =
+          &bucket_offsets[t * num_buckets];
+      for (FaceIndex f = first_task_face(t); f < first_task_face(t + 1); ++f) {
+        if (IsDegenerated(f))
+          continue;
+        for (int i = 0; i < 3; ++i) {
+          const CornerIndex c = FirstCorner(f) + i;
+          half_edges[task_offsets[lower_vertex(c).value() >> bucket_shift]++] =
+              c;
+        }
+      }
+    });
+  }
+  pool.Wait();
+
+  // Sort each bucket by the vertex pairs and match the half-edges of each
+  // pair. Each corner belongs to exactly one pair so the opposite corners can
+  // be set by the tasks directly.
+  for (uint64_t b = 0; b < num_buckets; ++b) {
+    pool.Schedule([&, b] {
+      const GeometryIndexCountType bucket_begin = bucket_starts[b];
+      const GeometryIndexCountType bucket_size =
+          bucket_starts[b + 1] - bucket_begin;
+      if (bucket_size == 0)
+        return;
+      // Sort the half-edges by their lower vertex using a counting sort that
+      // preserves the order of the corners.
+      const GeometryIndexValueType first_vert = b << bucket_shift;
+      const GeometryIndexValueType num_bucket_verts = static_cast<
+          GeometryIndexValueType>(std::min<uint64_t>(
+          uint64_t(1) << bucket_shift, num_table_vertices - first_vert));
+      std::vector<GeometryIndexCountType> vert_offsets(num_bucket_verts + 1, 0);
+      for (GeometryIndexCountType i = 0; i < bucket_size; ++i) {
+        const CornerIndex c = half_edges[bucket_begin + i];
+        ++vert_offsets[lower_vertex(c).value() - first_vert + 1];
+      }
+      for (size_t i = 1; i < vert_offsets.size(); ++i) {
+        vert_offsets[i] += vert_offsets[i - 1];
+      }
+      std::vector<CornerIndex> corners(bucket_size);
+      for (GeometryIndexCountType i = 0; i < bucket_size; ++i) {
+        const CornerIndex c = half_edges[bucket_begin + i];
+        corners[vert_offsets[lower_vertex(c).value() - first_vert]++] = c;
+      }
+
+      // Half-edges of one lower vertex stored as <higher vertex, corner>.
+      std::vector<std::pair<VertexIndex, CornerIndex>> vert_edges;
+      // Unmatched half-edges of the processed vertex pair. The first list
+      // contains half-edges going from the lower to the higher vertex.
+      std::vector<CornerIndex> unmatched_corners[2];
+      GeometryIndexCountType vert_begin = 0;
+      while (vert_begin < bucket_size) {
+        const VertexIndex low_v = lower_vertex(corners[vert_begin]);
+        vert_edges.clear();
+        for (GeometryIndexCountType i = vert_begin;
+             i < bucket_size && lower_vertex(corners[i]) == low_v; ++i) {
+          vert_edges.push_back(
+              std::make_pair(higher_vertex(corners[i]), corners[i]));
+        }
+        vert_begin += vert_edges.size();
+        // Sort the half-edges by the higher vertex while preserving the order
+        // of the corners.
+        std::sort(vert_edges.begin(), vert_edges.end());
+
+        for (size_t i = 0; i < vert_edges.size(); ++i) {
+          if (i == 0 || vert_edges[i].first != vert_edges[i - 1].first) {
+            // New vertex pair.
+            unmatched_corners[0].clear();
+            unmatched_corners[1].clear();
+          }
+          const CornerIndex c = vert_edges[i].second;
+          const int direction = Vertex(Next(c)) == low_v ? 0 : 1;
+          const VertexIndex tip_v = Vertex(c);
+          std::vector<CornerIndex> &siblings =
+              unmatched_corners[1 - direction];
+          auto sibling_it = siblings.begin();
+          // Don't connect mirrored faces.
+          while (sibling_it != siblings.end() &&
+                 Vertex(*sibling_it) == tip_v) {
+            ++sibling_it;
+          }
+          if (sibling_it == siblings.end()) {
+            unmatched_corners[direction].push_back(c);
+          } else {
+            opposite_corners_[c] = *sibling_it;
+            opposite_corners_[*sibling_it] = c;
+            siblings.erase(sibling_it);
+          }
+        }
+      }
+    });
+  }
+  pool.Wait();
   return true;
 }
 
@@ -300,7 +539,7 @@ bool CornerTable::BreakNonManifoldEdges() {
   return true;
 }
 
-bool CornerTable::ComputeVertexCorners(int num_vertices) {
+bool CornerTable::ComputeVertexCorners(GeometryIndexCountType num_vertices) {
   DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
   num_original_vertices_ = num_vertices;
   vertex_corners_.resize(num_vertices, kInvalidCornerIndex);
@@ -57,26 +57,38 @@ class CornerTable {
   CornerTable();
   static std::unique_ptr<CornerTable> Create(
       const IndexTypeVector<FaceIndex, FaceType> &faces);
+  static std::unique_ptr<CornerTable> Create(
+      const IndexTypeVector<FaceIndex, FaceType> &faces, int num_threads);
 
   // Initializes the CornerTable from provides set of indexed faces.
   // The input faces can represent a non-manifold topology, in which case the
   // non-manifold edges and vertices are going to be split.
   bool Init(const IndexTypeVector<FaceIndex, FaceType> &faces);
 
+  // Same as above but the opposite corners are computed on |num_threads|
+  // worker threads. The created table is identical to the table created by
+  // the serial version. |num_threads| equal to 0 selects the serial version.
+  bool Init(const IndexTypeVector<FaceIndex, FaceType> &faces,
+            int num_threads);
+
   // Resets the corner table to the given number of invalid faces.
-  bool Reset(int num_faces);
+  bool Reset(GeometryIndexCountType num_faces);
 
   // Resets the corner table to the given number of invalid faces and vertices.
-  bool Reset(int num_faces, int num_vertices);
+  // Fails when the number of corners cannot be addressed with the geometry
+  // indices of the current build (see geometry_indices.h).
+  bool Reset(GeometryIndexCountType num_faces,
+             GeometryIndexCountType num_vertices);
 
-  inline int num_vertices() const {
-    return static_cast<int>(vertex_corners_.size());
+  inline GeometryIndexCountType num_vertices() const {
+    return static_cast<GeometryIndexCountType>(vertex_corners_.size());
   }
-  inline int num_corners() const {
-    return static_cast<int>(corner_to_vertex_map_.size());
+  inline GeometryIndexCountType num_corners() const {
+    return static_cast<GeometryIndexCountType>(corner_to_vertex_map_.size());
   }
-  inline int num_faces() const {
-    return static_cast<int>(corner_to_vertex_map_.size() / 3);
+  inline GeometryIndexCountType num_faces() const {
+    return static_cast<GeometryIndexCountType>(corner_to_vertex_map_.size() /
+                                               3);
   }
 
   inline CornerIndex Opposite(CornerIndex corner) const {
@@ -146,7 +158,8 @@ class CornerTable {
 
   // Returns the parent vertex index of a given corner table vertex.
   VertexIndex VertexParent(VertexIndex vertex) const {
-    if (vertex.value() < static_cast<uint32_t>(num_original_vertices_))
+    if (vertex.value() <
+        static_cast<GeometryIndexValueType>(num_original_vertices_))
       return vertex;
     return non_manifold_vertex_parents_[vertex - num_original_vertices_];
   }
@@ -217,15 +230,23 @@ class CornerTable {
 
   // Returns the number of new vertices that were created as a result of
   // splitting of non-manifold vertices of the input geometry.
-  int NumNewVertices() const { return num_vertices() - num_original_vertices_; }
-  int NumOriginalVertices() const { return num_original_vertices_; }
+  GeometryIndexCountType NumNewVertices() const {
+    return num_vertices() - num_original_vertices_;
+  }
+  GeometryIndexCountType NumOriginalVertices() const {
+    return num_original_vertices_;
+  }
 
   // Returns the number of faces with duplicated vertex indices.
-  int NumDegeneratedFaces() const { return num_degenerated_faces_; }
+  GeometryIndexCountType NumDegeneratedFaces() const {
+    return num_degenerated_faces_;
+  }
 
   // Returns the number of isolated vertices (vertices that have
   // vertex_corners_ mapping set to kInvalidCornerIndex.
-  int NumIsolatedVertices() const { return num_isolated_vertices_; }
+  GeometryIndexCountType NumIsolatedVertices() const {
+    return num_isolated_vertices_;
+  }
 
   bool IsDegenerated(FaceIndex face) const;
 
@@ -257,7 +278,8 @@ class CornerTable {
     DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
     // Add a new invalid vertex.
     vertex_corners_.push_back(kInvalidCornerIndex);
-    return VertexIndex(static_cast<uint32_t>(vertex_corners_.size() - 1));
+    return VertexIndex(
+        static_cast<GeometryIndexValueType>(vertex_corners_.size() - 1));
   }
 
   // Sets a new left most corner for a given vertex.
@@ -289,7 +311,7 @@ class CornerTable {
   // Sets the new number of vertices. It's a responsibility of the caller to
   // ensure that no corner is mapped beyond the range of the new number of
   // vertices.
-  inline void SetNumVertices(int num_vertices) {
+  inline void SetNumVertices(GeometryIndexCountType num_vertices) {
     DRACO_DCHECK(GetValenceCache().IsCacheEmpty());
     vertex_corners_.resize(num_vertices, kInvalidCornerIndex);
   }
@@ -333,7 +355,14 @@ class CornerTable {
  private:
   // Computes opposite corners mapping from the data stored in
   // |corner_to_vertex_map_|.
-  bool ComputeOppositeCorners(int *num_vertices);
+  bool ComputeOppositeCorners(GeometryIndexCountType *num_vertices);
+
+  // Same as ComputeOppositeCorners() but the computation is split between
+  // |num_threads| worker threads. Half-edges are partitioned by the vertex
+  // pair they connect and each pair is then matched independently, in the
+  // same order as in the serial version.
+  bool ComputeOppositeCornersInParallel(int num_threads,
+                                        GeometryIndexCountType *num_vertices);
 
   // Finds and breaks non-manifold edges in the 1-ring neighborhood around
   // vertices (vertices themselves will be split in the ComputeVertexCorners()
@@ -343,16 +372,16 @@ class CornerTable {
   // Computes the lookup map for going from a vertex to a corner. This method
   // can handle non-manifold vertices by splitting them into multiple manifold
   // vertices.
-  bool ComputeVertexCorners(int num_vertices);
+  bool ComputeVertexCorners(GeometryIndexCountType num_vertices);
 
   // Each three consecutive corners represent one face.
   IndexTypeVector<CornerIndex, VertexIndex> corner_to_vertex_map_;
   IndexTypeVector<CornerIndex, CornerIndex> opposite_corners_;
   IndexTypeVector<VertexIndex, CornerIndex> vertex_corners_;
 
-  int num_original_vertices_;
-  int num_degenerated_faces_;
-  int num_isolated_vertices_;
+  GeometryIndexCountType num_original_vertices_;
+  GeometryIndexCountType num_degenerated_faces_;
+  GeometryIndexCountType num_isolated_vertices_;
   IndexTypeVector<VertexIndex, VertexIndex> non_manifold_vertex_parents_;
 
   draco::ValenceCache<CornerTable> valence_cache_;
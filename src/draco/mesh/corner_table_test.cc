@@ -0,0 +1,180 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/corner_table.h"
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+class CornerTableTest : public ::testing::Test {
+ protected:
+  // Returns |num_faces| face ids ending at the last face that can be stored in
+  // a corner table of the current build. The ids are generated on the fly so
+  // that the largest supported tables can be tested without allocating them.
+  std::vector<FaceIndex> GenerateLastFaces(int num_faces) {
+    const GeometryIndexValueType last_face = kMaxGeometryIndexCount / 3 - 1;
+    std::vector<FaceIndex> faces;
+    for (int i = num_faces - 1; i >= 0; --i) {
+      faces.push_back(FaceIndex(last_face - i));
+    }
+    return faces;
+  }
+
+  // Returns the faces of the mesh stored in |file_name| defined by the
+  // indices of its position attribute.
+  IndexTypeVector<FaceIndex, CornerTable::FaceType> ReadFaces(
+      const std::string &file_name) {
+    IndexTypeVector<FaceIndex, CornerTable::FaceType> faces;
+    const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile(file_name));
+    if (mesh == nullptr)
+      return faces;
+    const PointAttribute *const pos_att =
+        mesh->GetNamedAttribute(GeometryAttribute::POSITION);
+    faces.resize(mesh->num_faces());
+    for (FaceIndex fi(0); fi < mesh->num_faces(); ++fi) {
+      for (int c = 0; c < 3; ++c) {
+        faces[fi][c] =
+            VertexIndex(pos_att->mapped_index(mesh->face(fi)[c]).value());
+      }
+    }
+    return faces;
+  }
+
+  // Returns faces of a regular grid with |size| x |size| quads.
+  IndexTypeVector<FaceIndex, CornerTable::FaceType> GenerateGridFaces(
+      int size) {
+    IndexTypeVector<FaceIndex, CornerTable::FaceType> faces;
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        const VertexIndex v00(y * (size + 1) + x);
+        const VertexIndex v10 = v00 + 1;
+        const VertexIndex v01 = v00 + size + 1;
+        const VertexIndex v11 = v01 + 1;
+        faces.push_back({{v00, v10, v11}});
+        faces.push_back({{v00, v11, v01}});
+      }
+    }
+    return faces;
+  }
+
+  // Returns |num_faces| random faces on |num_vertices| vertices. With few
+  // vertices the faces contain many non-manifold edges and vertices, mirrored
+  // faces and degenerated faces.
+  IndexTypeVector<FaceIndex, CornerTable::FaceType> GenerateRandomFaces(
+      int num_faces, int num_vertices) {
+    std::mt19937 generator(num_faces);
+    std::uniform_int_distribution<int> distribution(0, num_vertices - 1);
+    IndexTypeVector<FaceIndex, CornerTable::FaceType> faces(num_faces);
+    for (FaceIndex fi(0); fi < num_faces; ++fi) {
+      for (int c = 0; c < 3; ++c) {
+        faces[fi][c] = VertexIndex(distribution(generator));
+      }
+    }
+    return faces;
+  }
+
+  // Verifies that tables created on different numbers of threads are
+  // identical to the table created by the serial implementation.
+  void TestParallelInit(
+      const IndexTypeVector<FaceIndex, CornerTable::FaceType> &faces) {
+    ASSERT_GT(faces.size(), 0);
+    const std::unique_ptr<CornerTable> ref_table = CornerTable::Create(faces);
+    ASSERT_NE(ref_table, nullptr);
+    for (const int num_threads : {1, 2, 3, 8}) {
+      const std::unique_ptr<CornerTable> table =
+          CornerTable::Create(faces, num_threads);
+      ASSERT_NE(table, nullptr);
+      ASSERT_EQ(table->num_faces(), ref_table->num_faces());
+      ASSERT_EQ(table->num_vertices(), ref_table->num_vertices());
+      ASSERT_EQ(table->NumDegeneratedFaces(), ref_table->NumDegeneratedFaces());
+      ASSERT_EQ(table->NumIsolatedVertices(), ref_table->NumIsolatedVertices());
+      for (CornerIndex c(0); c < ref_table->num_corners(); ++c) {
+        ASSERT_EQ(table->Vertex(c), ref_table->Vertex(c));
+        ASSERT_EQ(table->Opposite(c), ref_table->Opposite(c));
+      }
+      for (VertexIndex v(0); v < ref_table->num_vertices(); ++v) {
+        ASSERT_EQ(table->LeftMostCorner(v), ref_table->LeftMostCorner(v));
+        ASSERT_EQ(table->VertexParent(v), ref_table->VertexParent(v));
+      }
+    }
+  }
+};
+
+TEST_F(CornerTableTest, TestLargeIndices) {
+  // Corner navigation of the largest supported tables must not overflow. For
+  // 32-bit indices these tables have more than two billion corners.
+  const CornerTable table;
+  for (const FaceIndex face : GenerateLastFaces(1000)) {
+    const CornerIndex first_corner = table.FirstCorner(face);
+    ASSERT_EQ(first_corner.value(), 3 * face.value());
+    ASSERT_LT(first_corner.value() + 2,
+              static_cast<GeometryIndexValueType>(kMaxGeometryIndexCount));
+    const std::array<CornerIndex, 3> corners = table.AllCorners(face);
+    for (int c = 0; c < 3; ++c) {
+      const CornerIndex corner = corners[c];
+      ASSERT_EQ(corner, first_corner + c);
+      ASSERT_EQ(table.Face(corner), face);
+      ASSERT_EQ(table.LocalIndex(corner), c);
+      ASSERT_EQ(table.Next(corner), first_corner + (c + 1) % 3);
+      ASSERT_EQ(table.Previous(corner), first_corner + (c + 2) % 3);
+    }
+  }
+}
+
+TEST_F(CornerTableTest, TestWideIndices) {
+  // Wide index builds must support corners beyond the 32-bit range.
+  if (sizeof(GeometryIndexValueType) < 8)
+    return;
+  const CornerTable table;
+  const GeometryIndexValueType first_wide_face =
+      std::numeric_limits<uint32_t>::max() / 3 + 1;
+  for (FaceIndex face(first_wide_face); face < first_wide_face + 1000;
+       ++face) {
+    const CornerIndex corner = table.FirstCorner(face);
+    ASSERT_GT(corner.value(), std::numeric_limits<uint32_t>::max());
+    ASSERT_EQ(table.Face(corner + 2), face);
+    ASSERT_EQ(table.Previous(corner), corner + 2);
+  }
+}
+
+TEST_F(CornerTableTest, TestResetOverflow) {
+  CornerTable table;
+  ASSERT_TRUE(table.Reset(10));
+  ASSERT_EQ(table.num_faces(), 10);
+  ASSERT_EQ(table.num_corners(), 30);
+  ASSERT_FALSE(table.Reset(-1));
+  // The number of corners would not fit into the count type. The table must be
+  // rejected before any memory is allocated.
+  ASSERT_FALSE(table.Reset(kMaxGeometryIndexCount / 3 + 1));
+  ASSERT_FALSE(table.Reset(kMaxGeometryIndexCount));
+}
+
+TEST_F(CornerTableTest, TestParallelInit) {
+  TestParallelInit(ReadFaces("bun_zipper.ply"));
+  TestParallelInit(ReadFaces("test_nm.obj"));
+  TestParallelInit(ReadFaces("cube_att.obj"));
+  TestParallelInit(GenerateGridFaces(50));
+  TestParallelInit(GenerateRandomFaces(10, 5));
+  TestParallelInit(GenerateRandomFaces(1000, 30));
+  TestParallelInit(GenerateRandomFaces(1000, 1000));
+}
+
+}  // namespace draco
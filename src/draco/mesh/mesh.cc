@@ -17,6 +17,9 @@
 #include <array>
 #include <unordered_map>
 
+#include "draco/mesh/corner_table.h"
+#include "draco/mesh/mesh_misc_functions.h"
+
 namespace draco {
 
 using std::unordered_map;
@@ -25,13 +28,74 @@ using std::unordered_map;
 template <bool B, class T, class F>
 using conditional_t = typename std::conditional<B, T, F>::type;
 
-Mesh::Mesh() {}
+Mesh::Mesh() : connectivity_version_(0) {}
+
+std::shared_ptr<const CornerTable> Mesh::GetCornerTableFromPositionAttribute()
+    const {
+  return GetCornerTableFromPositionAttribute(0);
+}
+
+std::shared_ptr<const CornerTable> Mesh::GetCornerTableFromAllAttributes()
+    const {
+  return GetCornerTableFromAllAttributes(0);
+}
+
+std::shared_ptr<const CornerTable> Mesh::GetCornerTableFromPositionAttribute(
+    int num_threads) const {
+  return GetCachedCornerTable(&position_corner_table_,
+                              &CreateCornerTableFromPositionAttribute,
+                              num_threads);
+}
+
+std::shared_ptr<const CornerTable> Mesh::GetCornerTableFromAllAttributes(
+    int num_threads) const {
+  return GetCachedCornerTable(&all_attributes_corner_table_,
+                              &CreateCornerTableFromAllAttributes,
+                              num_threads);
+}
+
+void Mesh::ClearCachedCornerTables() const {
+  std::atomic_store(&position_corner_table_,
+                    std::shared_ptr<const CachedCornerTable>());
+  std::atomic_store(&all_attributes_corner_table_,
+                    std::shared_ptr<const CachedCornerTable>());
+}
+
+std::shared_ptr<const CornerTable> Mesh::GetCachedCornerTable(
+    std::shared_ptr<const CachedCornerTable> *cache,
+    std::unique_ptr<CornerTable> (*create_function)(const Mesh *, int),
+    int num_threads) const {
+  const PointAttribute *const pos_att =
+      GetNamedAttribute(GeometryAttribute::POSITION);
+  const uint64_t pos_mapping_version =
+      pos_att == nullptr ? 0 : pos_att->mapping_version();
+  std::shared_ptr<const CachedCornerTable> entry = std::atomic_load(cache);
+  if (entry == nullptr ||
+      entry->connectivity_version != connectivity_version_ ||
+      entry->position_attribute != pos_att ||
+      entry->position_mapping_version != pos_mapping_version) {
+    std::unique_ptr<CornerTable> table = create_function(this, num_threads);
+    if (table == nullptr)
+      return nullptr;
+    std::shared_ptr<CachedCornerTable> new_entry(new CachedCornerTable());
+    new_entry->connectivity_version = connectivity_version_;
+    new_entry->position_attribute = pos_att;
+    new_entry->position_mapping_version = pos_mapping_version;
+    new_entry->table = std::move(table);
+    entry = new_entry;
+    std::atomic_store(cache, entry);
+  }
+  // The returned table shares the ownership of the cache entry, so it stays
+  // valid even when the entry is replaced.
+  return std::shared_ptr<const CornerTable>(entry, entry->table.get());
+}
 
 #ifdef DRACO_ATTRIBUTE_INDICES_DEDUPLICATION_SUPPORTED
 void Mesh::ApplyPointIdDeduplication(
     const IndexTypeVector<PointIndex, PointIndex> &id_map,
     const std::vector<PointIndex> &unique_point_ids) {
   PointCloud::ApplyPointIdDeduplication(id_map, unique_point_ids);
+  ++connectivity_version_;
   for (FaceIndex f(0); f < num_faces(); ++f) {
     for (int32_t c = 0; c < 3; ++c) {
       faces_[f][c] = id_map[faces_[f][c]];
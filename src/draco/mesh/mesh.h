@@ -26,6 +26,8 @@
 
 namespace draco {
 
+class CornerTable;
+
 // List of different variants of mesh attributes.
 enum MeshAttributeElementType {
   // All corners attached to a vertex share the same attribute value. A typical
@@ -47,9 +49,13 @@ class Mesh : public PointCloud {
 
   Mesh();
 
-  void AddFace(const Face &face) { faces_.push_back(face); }
+  void AddFace(const Face &face) {
+    ++connectivity_version_;
+    faces_.push_back(face);
+  }
 
   void SetFace(FaceIndex face_id, const Face &face) {
+    ++connectivity_version_;
     if (face_id >= static_cast<uint32_t>(faces_.size())) {
       faces_.resize(face_id.value() + 1, Face());
     }
@@ -58,7 +64,10 @@ class Mesh : public PointCloud {
 
   // Sets the total number of faces. Creates new empty faces or deletes
   // existing ones if necessary.
-  void SetNumFaces(size_t num_faces) { faces_.resize(num_faces, Face()); }
+  void SetNumFaces(size_t num_faces) {
+    ++connectivity_version_;
+    faces_.resize(num_faces, Face());
+  }
 
   FaceIndex::ValueType num_faces() const {
     return static_cast<uint32_t>(faces_.size());
@@ -70,6 +79,7 @@ class Mesh : public PointCloud {
   }
 
   void SetAttribute(int att_id, std::unique_ptr<PointAttribute> pa) override {
+    ++connectivity_version_;
     PointCloud::SetAttribute(att_id, std::move(pa));
     if (static_cast<int>(attribute_data_.size()) <= att_id) {
       attribute_data_.resize(att_id + 1);
@@ -77,6 +87,7 @@ class Mesh : public PointCloud {
   }
 
   void DeleteAttribute(int att_id) override {
+    ++connectivity_version_;
     PointCloud::DeleteAttribute(att_id);
     if (att_id >= 0 && att_id < static_cast<int>(attribute_data_.size())) {
       attribute_data_.erase(attribute_data_.begin() + att_id);
@@ -103,6 +114,30 @@ class Mesh : public PointCloud {
     return this->CornerToPointId(ci.value());
   }
 
+  // Returns the corner table of the mesh created from the POSITION attribute
+  // (see CreateCornerTableFromPositionAttribute()). The table is created on
+  // the first call and cached on the mesh, so that the encoder, the attribute
+  // corner tables and the stripifier can share it. The cached table is
+  // rebuilt after the faces or the attributes of the mesh are modified.
+  // Returns nullptr when the table cannot be created.
+  std::shared_ptr<const CornerTable> GetCornerTableFromPositionAttribute()
+      const;
+
+  // Same as above but the table is created from all attributes (see
+  // CreateCornerTableFromAllAttributes()).
+  std::shared_ptr<const CornerTable> GetCornerTableFromAllAttributes() const;
+
+  // Same as the functions above but a table that is not cached yet is created
+  // on |num_threads| worker threads.
+  std::shared_ptr<const CornerTable> GetCornerTableFromPositionAttribute(
+      int num_threads) const;
+  std::shared_ptr<const CornerTable> GetCornerTableFromAllAttributes(
+      int num_threads) const;
+
+  // Releases the corner tables cached on the mesh. Tables previously returned
+  // by the functions above remain valid.
+  void ClearCachedCornerTables() const;
+
   struct AttributeData {
     AttributeData() : element_type(MESH_CORNER_ATTRIBUTE) {}
     MeshAttributeElementType element_type;
@@ -119,6 +154,22 @@ class Mesh : public PointCloud {
 #endif
 
  private:
+  // Corner table cached together with the state of the mesh it was created
+  // from.
+  struct CachedCornerTable {
+    uint64_t connectivity_version;
+    const PointAttribute *position_attribute;
+    uint64_t position_mapping_version;
+    std::unique_ptr<CornerTable> table;
+  };
+
+  // Returns the table stored in |cache| if it is still valid, otherwise
+  // creates a new one with |create_function| and stores it in |cache|.
+  std::shared_ptr<const CornerTable> GetCachedCornerTable(
+      std::shared_ptr<const CachedCornerTable> *cache,
+      std::unique_ptr<CornerTable> (*create_function)(const Mesh *, int),
+      int num_threads) const;
+
   // Mesh specific per-attribute data.
   std::vector<AttributeData> attribute_data_;
 
@@ -126,7 +177,18 @@ class Mesh : public PointCloud {
   // that converts vertex indices into attribute indices.
   IndexTypeVector<FaceIndex, Face> faces_;
 
+  // Incremented whenever the faces or the attributes of the mesh change.
+  uint64_t connectivity_version_;
+  // Corner tables created by GetCornerTableFromPositionAttribute() and
+  // GetCornerTableFromAllAttributes(). The tables may be requested
+  // concurrently, e.g. when the same mesh is encoded on multiple threads, so
+  // the cache entries are accessed atomically.
+  mutable std::shared_ptr<const CachedCornerTable> position_corner_table_;
+  mutable std::shared_ptr<const CachedCornerTable> all_attributes_corner_table_;
+
   friend struct MeshHasher;
+  // Writes decoded faces directly to |faces_| from multiple threads.
+  friend class MeshSequentialDecoder;
 };
 
 // Functor for computing a hash from data stored within a mesh.
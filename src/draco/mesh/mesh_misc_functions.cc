@@ -18,6 +18,11 @@ namespace draco {
 
 std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
     const Mesh *mesh) {
+  return CreateCornerTableFromPositionAttribute(mesh, 0);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
+    const Mesh *mesh, int num_threads) {
   typedef CornerTable::FaceType FaceType;
 
   const PointAttribute *const att =
@@ -35,11 +40,16 @@ std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
     faces[FaceIndex(i)] = new_face;
   }
   // Build the corner table.
-  return CornerTable::Create(faces);
+  return CornerTable::Create(faces, num_threads);
 }
 
 std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
     const Mesh *mesh) {
+  return CreateCornerTableFromAllAttributes(mesh, 0);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
+    const Mesh *mesh, int num_threads) {
   typedef CornerTable::FaceType FaceType;
   IndexTypeVector<FaceIndex, FaceType> faces(mesh->num_faces());
   FaceType new_face;
@@ -53,6 +63,6 @@ std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
     faces[i] = new_face;
   }
   // Build the corner table.
-  return CornerTable::Create(faces);
+  return CornerTable::Create(faces, num_threads);
 }
 }  // namespace draco
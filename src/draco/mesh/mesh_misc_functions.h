@@ -34,6 +34,13 @@ std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
 std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
     const Mesh *mesh);
 
+// Same as the functions above but the corner table is created on
+// |num_threads| worker threads (see CornerTable::Init()).
+std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(
+    const Mesh *mesh, int num_threads);
+std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(
+    const Mesh *mesh, int num_threads);
+
 // Returns true when the given corner lies opposite to an attribute seam.
 inline bool IsCornerOppositeToAttributeSeam(CornerIndex ci,
                                             const PointAttribute &att,
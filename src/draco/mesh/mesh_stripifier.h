@@ -71,9 +71,7 @@ class MeshStripifier {
     mesh_ = &mesh;
     num_strips_ = 0;
     num_encoded_faces_ = 0;
-    // TODO(ostava): We may be able to avoid computing the corner table if we
-    // already have it stored somewhere.
-    corner_table_ = CreateCornerTableFromPositionAttribute(mesh_);
+    corner_table_ = mesh.GetCornerTableFromPositionAttribute();
     if (corner_table_ == nullptr)
       return false;
 
@@ -160,7 +158,7 @@ class MeshStripifier {
   void GenerateStripsFromCorner(int local_strip_id, CornerIndex ci);
 
   const Mesh *mesh_;
-  std::unique_ptr<CornerTable> corner_table_;
+  std::shared_ptr<const CornerTable> corner_table_;
 
   // Store strip faces for each of three possible directions from a given face.
   std::vector<FaceIndex> strip_faces_[3];
@@ -0,0 +1,79 @@
+// Copyright 2018 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/mesh.h"
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/mesh/corner_table.h"
+
+namespace draco {
+
+class MeshTest : public ::testing::Test {};
+
+TEST_F(MeshTest, TestCornerTableCache) {
+  const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile("cube_att.obj"));
+  ASSERT_NE(mesh, nullptr);
+
+  // Repeated requests share the same table.
+  const std::shared_ptr<const CornerTable> table_0 =
+      mesh->GetCornerTableFromPositionAttribute();
+  ASSERT_NE(table_0, nullptr);
+  ASSERT_EQ(table_0->num_faces(), mesh->num_faces());
+  ASSERT_EQ(mesh->GetCornerTableFromPositionAttribute(), table_0);
+
+  // Tables created from all attributes are cached separately.
+  const std::shared_ptr<const CornerTable> all_att_table =
+      mesh->GetCornerTableFromAllAttributes();
+  ASSERT_NE(all_att_table, nullptr);
+  ASSERT_NE(all_att_table, table_0);
+  ASSERT_GT(all_att_table->num_vertices(), table_0->num_vertices());
+  ASSERT_EQ(mesh->GetCornerTableFromAllAttributes(), all_att_table);
+
+  // Modifying the faces invalidates the cached tables, but the previously
+  // returned tables remain valid.
+  const Mesh::Face face = mesh->face(FaceIndex(0));
+  mesh->SetFace(FaceIndex(0), {{face[0], face[2], face[1]}});
+  const std::shared_ptr<const CornerTable> table_1 =
+      mesh->GetCornerTableFromPositionAttribute();
+  ASSERT_NE(table_1, nullptr);
+  ASSERT_NE(table_1, table_0);
+  ASSERT_EQ(table_0->num_faces(), mesh->num_faces());
+  ASSERT_NE(mesh->GetCornerTableFromAllAttributes(), all_att_table);
+
+  // Modifying the mapping of the position attribute invalidates the table.
+  PointAttribute *const pos_att =
+      mesh->attribute(mesh->GetNamedAttributeId(GeometryAttribute::POSITION));
+  pos_att->SetPointMapEntry(face[0], pos_att->mapped_index(face[1]));
+  const std::shared_ptr<const CornerTable> table_2 =
+      mesh->GetCornerTableFromPositionAttribute();
+  ASSERT_NE(table_2, table_1);
+  ASSERT_EQ(mesh->GetCornerTableFromPositionAttribute(), table_2);
+
+  // Adding faces invalidates the table as well.
+  mesh->AddFace(face);
+  const std::shared_ptr<const CornerTable> table_3 =
+      mesh->GetCornerTableFromPositionAttribute();
+  ASSERT_NE(table_3, table_2);
+  ASSERT_EQ(table_3->num_faces(), mesh->num_faces());
+
+  // Cleared tables are recreated on the next request.
+  mesh->ClearCachedCornerTables();
+  const std::shared_ptr<const CornerTable> table_4 =
+      mesh->GetCornerTableFromPositionAttribute();
+  ASSERT_NE(table_4, table_3);
+  ASSERT_EQ(table_3->num_faces(), table_4->num_faces());
+}
+
+}  // namespace draco
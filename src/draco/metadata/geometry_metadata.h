@@ -57,6 +57,8 @@ class GeometryMetadata : public Metadata {
  public:
   GeometryMetadata(){};
   explicit GeometryMetadata(const Metadata &metadata) : Metadata(metadata) {}
+  // Copies all entries including the metadata of all attributes.
+  GeometryMetadata(const GeometryMetadata &metadata);
 
   const AttributeMetadata *GetAttributeMetadataByStringEntry(
       const std::string &entry_name, const std::string &entry_value) const;
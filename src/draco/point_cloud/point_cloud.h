@@ -178,8 +178,12 @@ class PointCloud {
 
   // Sets the number of points. It's the caller's responsibility to ensure the
   // new number is valid with respect to the PointAttributes stored in the point
-  // cloud.
-  void set_num_points(PointIndex::ValueType num) { num_points_ = num; }
+  // cloud and that it does not exceed kMaxGeometryIndexCount.
+  void set_num_points(PointIndex::ValueType num) {
+    DRACO_DCHECK_LE(num,
+                    static_cast<PointIndex::ValueType>(kMaxGeometryIndexCount));
+    num_points_ = num;
+  }
 
  protected:
 #ifdef DRACO_ATTRIBUTE_INDICES_DEDUPLICATION_SUPPORTED
@@ -17,6 +17,7 @@
 
 #include "draco/compression/decode.h"
 #include "draco/core/cycle_timer.h"
+#include "draco/io/mapped_file.h"
 #include "draco/io/obj_encoder.h"
 #include "draco/io/parser_utils.h"
 #include "draco/io/ply_encoder.h"
@@ -66,28 +67,22 @@ int main(int argc, char **argv) {
     return -1;
   }
 
-  std::ifstream input_file(options.input, std::ios::binary);
-  if (!input_file) {
+  auto file_or = draco::MappedFile::Open(options.input);
+  if (!file_or.ok()) {
     printf("Failed opening the input file.\n");
     return -1;
   }
+  const std::unique_ptr<draco::MappedFile> input_file =
+      std::move(file_or).value();
 
-  // Read the file stream into a buffer.
-  std::streampos file_size = 0;
-  input_file.seekg(0, std::ios::end);
-  file_size = input_file.tellg() - file_size;
-  input_file.seekg(0, std::ios::beg);
-  std::vector<char> data(file_size);
-  input_file.read(data.data(), file_size);
-
-  if (data.empty()) {
+  if (input_file->size() == 0) {
     printf("Empty input file.\n");
     return -1;
   }
 
   // Create a draco decoding buffer. Note that no data is copied in this step.
   draco::DecoderBuffer buffer;
-  buffer.Init(data.data(), data.size());
+  buffer.Init(input_file->data(), input_file->size());
 
   draco::CycleTimer timer;
   // Decode the input data into a geometry.
@@ -142,6 +142,7 @@ int EncodePointCloudToFile(const draco::PointCloud &pc, const std::string &file,
   draco::CycleTimer timer;
   // Encode the geometry.
   draco::EncoderBuffer buffer;
+  buffer.Reserve(encoder->EstimateEncodedPointCloudSize(pc));
   timer.Start();
   const draco::Status status = encoder->EncodePointCloudToBuffer(pc, &buffer);
   if (!status.ok()) {
@@ -168,6 +169,7 @@ int EncodeMeshToFile(const draco::Mesh &mesh, const std::string &file,
   draco::CycleTimer timer;
   // Encode the geometry.
   draco::EncoderBuffer buffer;
+  buffer.Reserve(encoder->EstimateEncodedMeshSize(mesh));
   timer.Start();
   const draco::Status status = encoder->EncodeMeshToBuffer(mesh, &buffer);
   if (!status.ok()) {